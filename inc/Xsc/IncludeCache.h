@@ -0,0 +1,77 @@
+/*
+ * IncludeCache.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_INCLUDE_CACHE_H
+#define XSC_INCLUDE_CACHE_H
+
+
+#include "Export.h"
+#include <string>
+#include <memory>
+#include <cstddef>
+
+
+namespace Xsc
+{
+
+
+/* ===== Public classes ===== */
+
+/**
+\brief Cache for the content of include files, that can be shared across multiple compilations and threads.
+\remarks Each file is identified by its resolved path, and it is only read again when its modification time or size has changed.
+The cache is only used with the default implementation of IncludeHandler::Include, i.e. it is bypassed for include handlers of derived classes.
+All cached contents are read-only and can be used by multiple compilations at the same time.
+\see ShaderInput::includeCache
+*/
+class XSC_EXPORT IncludeCache
+{
+
+    public:
+
+        IncludeCache();
+        ~IncludeCache();
+
+        IncludeCache(const IncludeCache&) = delete;
+        IncludeCache& operator = (const IncludeCache&) = delete;
+
+        /**
+        \brief Returns the content of the specified file, and reads the file only if it's not cached yet or has been modified.
+        \param[in] filename Specifies the resolved path of the file (see IncludeHandler::FindFile).
+        \return Shared pointer to the read-only file content, or null if the file could not be read.
+        */
+        std::shared_ptr<const std::string> Fetch(const std::string& filename);
+
+        //! Removes all files from the cache and resets the counters.
+        void Clear();
+
+        //! Returns the number of files in the cache.
+        std::size_t GetNumEntries() const;
+
+        //! Returns the number of requests that have been served from the cache.
+        std::size_t GetNumHits() const;
+
+        //! Returns the number of requests that required the file to be read.
+        std::size_t GetNumMisses() const;
+
+    private:
+
+        // PImpl idiom
+        struct OpaqueData;
+        OpaqueData* data_ = nullptr;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
\ No newline at end of file
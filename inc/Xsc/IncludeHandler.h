@@ -42,6 +42,15 @@ class XSC_EXPORT IncludeHandler
         */
         virtual std::unique_ptr<std::istream> Include(const std::string& filename, bool useSearchPathsFirst);
 
+        /**
+        \brief Returns the path of the specified file in the same order as the default implementation of "Include" searches for it.
+        \param[in] filename Specifies the include filename.
+        \param[in] useSearchPathsFirst Specifies whether to first use the search paths to find the file.
+        \return Path of the existing file, or an empty string if the file could not be found.
+        \see IncludeCache
+        */
+        std::string FindFile(const std::string& filename, bool useSearchPathsFirst) const;
+
         //! Returns the list of search paths.
         std::vector<std::string>& GetSearchPaths();
 
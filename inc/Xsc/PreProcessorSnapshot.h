@@ -0,0 +1,105 @@
+/*
+ * PreProcessorSnapshot.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_PRE_PROCESSOR_SNAPSHOT_H
+#define XSC_PRE_PROCESSOR_SNAPSHOT_H
+
+
+#include "Export.h"
+#include "Log.h"
+#include <istream>
+#include <ostream>
+#include <cstdint>
+
+
+namespace Xsc
+{
+
+
+struct ShaderInput;
+struct PreProcessorState;
+
+/* ===== Public classes ===== */
+
+/**
+\brief Snapshot of the pre-processor state after a prelude has been pre-processed (similar to a precompiled header).
+\remarks A prelude is a shader source that is shared by many shaders, e.g. a large set of platform macros and helper headers.
+It is pre-processed only once, and the resulting macros, once-included files, include-guards, and include counters,
+as well as the pre-processed output of the prelude, are then used to seed the pre-processor of other compilations.
+A snapshot can be kept in memory or written to a stream (e.g. a file on disk), and it is read-only once it has been created,
+i.e. the same snapshot can be used by multiple compilations at the same time.
+\see ShaderInput::preProcessorSnapshot
+*/
+class XSC_EXPORT PreProcessorSnapshot
+{
+
+    public:
+
+        PreProcessorSnapshot();
+        ~PreProcessorSnapshot();
+
+        PreProcessorSnapshot(const PreProcessorSnapshot&) = delete;
+        PreProcessorSnapshot& operator = (const PreProcessorSnapshot&) = delete;
+
+        /**
+        \brief Pre-processes the specified prelude and stores the resulting state in this snapshot.
+        \param[in] preludeDesc Specifies the shader input descriptor of the prelude.
+        Only the source code, filename, shader version, warnings, pre-defined macros, include handler, and include cache are used.
+        \param[in] log Optional pointer to an output log.
+        \return True if the prelude has been pre-processed successfully. Otherwise, this snapshot is invalid.
+        */
+        bool Create(const ShaderInput& preludeDesc, Log* log = nullptr);
+
+        /**
+        \brief Writes this snapshot to the specified binary output stream.
+        \return True on success. False if this snapshot is invalid or the stream could not be written.
+        \see Load
+        */
+        bool Save(std::ostream& stream) const;
+
+        /**
+        \brief Reads a snapshot from the specified binary input stream, and rejects it if it is corrupted or stale.
+        \param[in] stream Specifies the input stream, which must have been written by the "Save" function.
+        \param[in] preludeDesc Specifies the shader input descriptor of the prelude, which was used to create the snapshot.
+        The source code of the prelude and all files it has included are read again to validate the snapshot.
+        \return True if the snapshot has been loaded successfully and is up to date with the prelude.
+        Otherwise, this snapshot is invalid and the prelude must be pre-processed again (see Create).
+        \see GetHash
+        */
+        bool Load(std::istream& stream, const ShaderInput& preludeDesc);
+
+        //! Resets this snapshot to an invalid state.
+        void Clear();
+
+        //! Returns true if this snapshot has been created or loaded successfully.
+        bool IsValid() const;
+
+        /**
+        \brief Returns the validation hash of this snapshot, or zero if this snapshot is invalid.
+        \remarks This hash is computed from the shader language, the pre-defined macros, and the content of the prelude and of all files it has included.
+        */
+        std::uint64_t GetHash() const;
+
+    private:
+
+        friend const PreProcessorState& GetPreProcessorState(const PreProcessorSnapshot& snapshot);
+
+        // PImpl idiom
+        struct OpaqueData;
+        OpaqueData* data_ = nullptr;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
\ No newline at end of file
@@ -0,0 +1,112 @@
+/*
+ * ProgramSnapshot.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_PROGRAM_SNAPSHOT_H
+#define XSC_PROGRAM_SNAPSHOT_H
+
+
+#include "Export.h"
+#include "Log.h"
+#include <istream>
+#include <ostream>
+#include <cstdint>
+
+
+namespace Xsc
+{
+
+
+struct ShaderInput;
+struct ShaderOutput;
+struct ProgramState;
+
+/* ===== Public classes ===== */
+
+/**
+\brief Snapshot of an analyzed program, to generate the output code many times without pre-processing, parsing, and analyzing the input again.
+\remarks A program snapshot stores the entire program after the context analysis (i.e. before the optimizer and the code generation),
+as well as the macros and dependencies of the pre-processor. A compilation with a program snapshot only runs the optimizer,
+the code generation, and the code reflection, e.g. to generate the output for several output shader versions or with different formatting.
+The snapshot is bound to the input (including all included files) and to the options of the front-end it was created with,
+i.e. the shader version and target, the entry points, the language extensions, the pre-defined macros, the pre-processor snapshot,
+and the output options 'rowMajorAlignment', 'preferWrappers', 'analyzeReachableOnly', as well as the name mangling prefixes for
+input, output, reserved words, and temporaries. Warnings of the front-end are only reported when the snapshot is created,
+and reports of the back-end don't contain line markers, since the source code is not part of the snapshot.
+A snapshot can be kept in memory or written to a stream (e.g. a file on disk), and it is read-only once it has been created,
+i.e. the same snapshot can be used by multiple compilations at the same time.
+\see ShaderInput::programSnapshot
+*/
+class XSC_EXPORT ProgramSnapshot
+{
+
+    public:
+
+        ProgramSnapshot();
+        ~ProgramSnapshot();
+
+        ProgramSnapshot(const ProgramSnapshot&) = delete;
+        ProgramSnapshot& operator = (const ProgramSnapshot&) = delete;
+
+        /**
+        \brief Pre-processes, parses, and analyzes the specified input, and stores the analyzed program in this snapshot.
+        \param[in] inputDesc Specifies the shader input descriptor. The member 'programSnapshot' is ignored.
+        \param[in] outputDesc Specifies the shader output descriptor. Only the options of the front-end are used, and the output stream can be null.
+        \param[in] log Optional pointer to an output log.
+        \return True if the input has been analyzed successfully. Otherwise, this snapshot is invalid.
+        */
+        bool Create(const ShaderInput& inputDesc, const ShaderOutput& outputDesc, Log* log = nullptr);
+
+        /**
+        \brief Writes this snapshot to the specified binary output stream.
+        \return True on success. False if this snapshot is invalid or the stream could not be written.
+        \see Load
+        */
+        bool Save(std::ostream& stream) const;
+
+        /**
+        \brief Reads a snapshot from the specified binary input stream, and rejects it if it is corrupted or stale.
+        \param[in] stream Specifies the input stream, which must have been written by the "Save" function.
+        \param[in] inputDesc Specifies the shader input descriptor, which was used to create the snapshot.
+        The source code and all files it has included are read again to validate the snapshot.
+        \param[in] outputDesc Specifies the shader output descriptor, which was used to create the snapshot.
+        \return True if the snapshot has been loaded successfully and is up to date with the input and the options of the front-end.
+        Otherwise, this snapshot is invalid and the input must be analyzed again (see Create).
+        \see GetHash
+        */
+        bool Load(std::istream& stream, const ShaderInput& inputDesc, const ShaderOutput& outputDesc);
+
+        //! Resets this snapshot to an invalid state.
+        void Clear();
+
+        //! Returns true if this snapshot has been created or loaded successfully.
+        bool IsValid() const;
+
+        /**
+        \brief Returns the validation hash of this snapshot, or zero if this snapshot is invalid.
+        \remarks This hash is computed from the options of the front-end, and the content of the source code and of all files it has included.
+        */
+        std::uint64_t GetHash() const;
+
+    private:
+
+        friend const ProgramState& GetProgramState(const ProgramSnapshot& snapshot);
+
+        // PImpl idiom
+        struct OpaqueData;
+        OpaqueData* data_ = nullptr;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
\ No newline at end of file
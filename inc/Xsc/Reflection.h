@@ -388,6 +388,19 @@ struct ReflectionData
     //! All defined macros after pre-processing.
     std::vector<std::string>        macros;
 
+    /**
+    \brief All macros that were queried (e.g. by '#ifdef' or 'defined') or expanded during pre-processing, whether they were defined or not.
+    \remarks Identifiers in the source code that are not defined as macros are only listed, if they are part of a directive.
+    Hence, callers must treat undefined identifiers conservatively: A macro that is defined for this compilation but not listed here
+    has no influence on the pre-processed output, but defining a macro that is undefined for this compilation
+    can change the output even if it is not listed here (e.g. 'F' in "float x = F;").
+    With the option 'scanDependenciesOnly', only the macros within directives are listed.
+    */
+    std::vector<std::string>        usedMacros;
+
+    //! Paths of all included files in the order they were included first (e.g. for the dependency files of a build system).
+    std::vector<std::string>        dependencies;
+
     //! All records declared both globally and within constant buffers (also called structure, struct, or compound data).
     std::vector<Record>             records;
 
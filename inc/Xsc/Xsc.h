@@ -12,6 +12,9 @@
 #include "Export.h"
 #include "Log.h"
 #include "IncludeHandler.h"
+#include "IncludeCache.h"
+#include "PreProcessorSnapshot.h"
+#include "ProgramSnapshot.h"
 #include "Targets.h"
 #include "Version.h"
 #include "Reflection.h"
@@ -152,6 +155,13 @@ struct Options
     //! If true, the shader output may contain GLSL extensions, if the target shader version is too low. By default false.
     bool    allowExtensions         = false;
 
+    /**
+    \brief If true, only the global functions that are reachable from the entry points are analyzed. By default false.
+    \remarks All other global functions are skipped before the context analysis (and are thus neither type-checked nor generated),
+    i.e. errors inside of unreachable functions are not reported. This is useful for large shader libraries with many unused functions.
+    */
+    bool    analyzeReachableOnly    = false;
+
     /**
     \brief If true, binding slots for all buffer types will be generated sequentially, starting with index at 'autoBindingStartSlot'. By default false.
     \remarks This will also enable 'explicitBinding'.
@@ -170,6 +180,12 @@ struct Options
     //! If true, little code optimizations are performed. By default false.
     bool    optimize                = false;
 
+    /**
+    \brief If true, the pre-processor passes its token stream directly to the parser, instead of writing out the pre-processed source code. By default false.
+    \remarks This avoids that the pre-processed source code is scanned a second time. It has no effect if 'preprocessOnly' is enabled.
+    */
+    bool    passTokenStream         = false;
+
     //TODO: maybe merge this option with "optimize" (preferWrappers == !optimize)
     //! If true, intrinsics are prefered to be implemented as wrappers (instead of inlining). By default false.
     bool    preferWrappers          = false;
@@ -183,6 +199,14 @@ struct Options
     //! If true, matrices have row-major alignment. Otherwise the matrices have column-major alignment. By default false.
     bool    rowMajorAlignment       = false;
 
+    /**
+    \brief If true, only the dependencies of the shader (i.e. all included files) are determined, but no output will be generated. By default false.
+    \remarks The pre-processor only resolves the '#include'-directives under the active macro set, and the source code is neither parsed nor analyzed.
+    The dependencies are stored in 'ReflectionData::dependencies', and the output stream can be null.
+    \see Reflection::ReflectionData::dependencies
+    */
+    bool    scanDependenciesOnly    = false;
+
     //! If true, generated GLSL code will contain separate sampler and texture objects when supported. By default true.
     bool    separateSamplers        = true;
 
@@ -192,7 +216,7 @@ struct Options
     //! If true, the AST (Abstract Syntax Tree) will be written to the log output. By default false.
     bool    showAST                 = false;
 
-    //! If true, the timings of the different compilation processes are written to the log output. By default false.
+    //! If true, the timings of the different compilation processes and the overload resolution statistics are written to the log output. By default false.
     bool    showTimes               = false;
 
     //TODO: remove this option, and determine automatically when unrolling initializers are required!
@@ -255,6 +279,19 @@ struct NameMangling
     bool            renameBufferFields  = false;
 };
 
+/**
+\brief Pre-defined macro structure for the pre-processor (like the "-D" compiler argument).
+\see ShaderInput::defines
+*/
+struct PredefinedMacro
+{
+    //! Specifies the macro identifier with an optional parameter list, e.g. "FOO" or "MAX(a, b)".
+    std::string ident;
+
+    //! Specifies the macro value (or rather body). This can be empty.
+    std::string value;
+};
+
 /**
 \brief Shader input descriptor structure.
 \see CompileShader
@@ -264,9 +301,20 @@ struct ShaderInput
     //! Specifies the filename of the input shader code. This is an optional attribute, and only a hint to the compiler.
     std::string                     filename;
 
-    //! Specifies the input source code stream.
+    //! Specifies the input source code stream. This is ignored if 'sourceCodeBuffer' is specified.
     std::shared_ptr<std::istream>   sourceCode;
 
+    /**
+    \brief Specifies the input source code as an in-memory buffer. By default null.
+    \remarks If this is not null, the buffer is read directly (without copying the text) and 'sourceCode' is ignored.
+    The buffer must stay valid until the compilation has finished. It does not need to be null-terminated.
+    \see sourceCodeBufferSize
+    */
+    const char*                     sourceCodeBuffer    = nullptr;
+
+    //! Specifies the size (in bytes) of the 'sourceCodeBuffer'. By default 0.
+    std::size_t                     sourceCodeBufferSize = 0;
+
     //! Specifies the input shader version (e.g. InputShaderVersion::HLSL5 for "HLSL 5"). By default InputShaderVersion::HLSL5.
     InputShaderVersion              shaderVersion       = InputShaderVersion::HLSL5;
 
@@ -298,11 +346,46 @@ struct ShaderInput
     */
     unsigned int                    extensions          = 0;
 
+    /**
+    \brief Optional list of macros that are defined before the source code is pre-processed. By default empty.
+    \remarks These macros are inserted directly into the pre-processor, so they don't need to be prepended as '#define'-directives to the source code.
+    \see PredefinedMacro
+    */
+    std::vector<PredefinedMacro>    defines;
+
     /**
     \brief Optional pointer to the implementation of the "IncludeHandler" interface. By default null.
     \remarks If this is null, the default include handler will be used, which will include files with the STL input file streams.
     */
     IncludeHandler*                 includeHandler      = nullptr;
+
+    /**
+    \brief Optional pointer to an include cache, which can be shared across multiple compilations. By default null.
+    \remarks If this is not null, include files are searched with the search paths of the include handler (see IncludeHandler::FindFile),
+    and their content is read through this cache. "IncludeHandler::Include" is then only called for files that could not be found.
+    The cache is ignored if 'includeHandler' is an instance of a class derived from IncludeHandler, since it might override "IncludeHandler::Include".
+    \see IncludeCache
+    */
+    IncludeCache*                   includeCache        = nullptr;
+
+    /**
+    \brief Optional pointer to a pre-processor snapshot of a prelude, which is used to seed the pre-processor. By default null.
+    \remarks If this is not null, all macros and include states of the prelude are defined before the source code is pre-processed,
+    and the pre-processed output of the prelude is inserted in front of the source code. The snapshot must be valid,
+    and it must have been created for the same shader language (HLSL or GLSL).
+    \see PreProcessorSnapshot
+    */
+    const PreProcessorSnapshot*     preProcessorSnapshot = nullptr;
+
+    /**
+    \brief Optional pointer to a snapshot of the analyzed program, which replaces the front-end. By default null.
+    \remarks If this is not null, the source code is neither pre-processed, parsed, nor analyzed, and it can be null.
+    Instead, the program of the snapshot is optimized and translated into the output code. The snapshot must be valid,
+    and it must have been created with the same options of the front-end (see ProgramSnapshot).
+    This is ignored if the options 'preprocessOnly' or 'scanDependenciesOnly' are enabled.
+    \see ProgramSnapshot
+    */
+    const ProgramSnapshot*          programSnapshot     = nullptr;
 };
 
 /**
@@ -365,6 +448,28 @@ struct ShaderOutput
     NameMangling                nameMangling;
 };
 
+/**
+\brief Shader entry point descriptor structure to compile multiple shaders from the same input.
+\see CompileShaders
+*/
+struct ShaderEntryPoint
+{
+    //! Specifies the target shader (Vertex, Fragment etc.). By default ShaderTarget::Undefined.
+    ShaderTarget                shaderTarget        = ShaderTarget::Undefined;
+
+    //! Specifies the HLSL shader entry point. By default "main".
+    std::string                 entryPoint          = "main";
+
+    //! Specifies the secondary HLSL shader entry point (see ShaderInput::secondaryEntryPoint).
+    std::string                 secondaryEntryPoint;
+
+    //! Specifies the output descriptor of this entry point.
+    ShaderOutput                outputDesc;
+
+    //! Optional pointer to a code reflection data structure of this entry point. By default null.
+    Reflection::ReflectionData* reflectionData      = nullptr;
+};
+
 /**
 \brief Descriptor structure for the shader disassembler.
 \see DisassembleShader
@@ -400,7 +505,7 @@ struct AssemblyDescriptor
 \param[in] log Optional pointer to an output log. Inherit from the "Log" class interface. By default null.
 \param[out] reflectionData Optional pointer to a code reflection data structure. By default null.
 \return True if the code has been translated successfully.
-\throw std::invalid_argument If either the input or output streams are null.
+\throw std::invalid_argument If either the input stream (or input buffer) or the output stream is null.
 \see ShaderInput
 \see ShaderOutput
 \see Log
@@ -413,6 +518,29 @@ XSC_EXPORT bool CompileShader(
     Reflection::ReflectionData* reflectionData  = nullptr
 );
 
+/**
+\brief Cross compiles multiple entry points from the same input shader code, which is pre-processed only once.
+\param[in] inputDesc Input shader code descriptor. The members 'shaderTarget', 'entryPoint', and 'secondaryEntryPoint' are ignored.
+\param[in] entryPoints List of all entry points, each with their own shader target, output descriptor, and optional reflection data.
+\param[in] log Optional pointer to an output log, which receives the reports of all entry points. By default null.
+\param[out] entryPointResults Optional pointer to a list that receives the result of each entry point (true on success). By default null.
+\return True if all entry points have been translated successfully.
+\remarks The input is pre-processed only once for all entry points (with the same macros and include files),
+and the pre-processed input is parsed only once for all entry points with the same parser options (i.e. name mangling and 'rowMajorAlignment').
+Each entry point then analyzes and generates its own copy of the parsed program, with the same results as the "CompileShader" function.
+Entry points with the 'preprocessOnly' or 'scanDependenciesOnly' option are compiled individually.
+The token stream of the pre-processor is only shared if the 'passTokenStream' option is enabled for all entry points.
+\throw std::invalid_argument If either the input stream (or input buffer) or any output stream is null.
+\see CompileShader
+\see ShaderEntryPoint
+*/
+XSC_EXPORT bool CompileShaders(
+    const ShaderInput&                      inputDesc,
+    const std::vector<ShaderEntryPoint>&    entryPoints,
+    Log*                                    log                 = nullptr,
+    std::vector<bool>*                      entryPointResults   = nullptr
+);
+
 /**
 \brief Disassembles the SPIR-V binary code into a human readable code.
 \param[in,out] streamIn Specifies the input stream of the SPIR-V binary code.
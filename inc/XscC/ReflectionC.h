@@ -312,6 +312,18 @@ struct XscReflectionData
 
     //! 'numthreads' attribute of a compute shader.
     struct XscNumThreads                numThreads;
+
+    //! Paths of all included files in the order they were included first.
+    const char**                        dependencies;
+
+    //! Number of elements in 'dependencies'.
+    size_t                              dependenciesCount;
+
+    //! All macros that were queried or expanded during pre-processing, whether they were defined or not.
+    const char**                        usedMacros;
+
+    //! Number of elements in 'usedMacros'.
+    size_t                              usedMacrosCount;
 };
 
 
@@ -134,6 +134,21 @@ struct XscOptions
 
     //! If none-zero, the generator header with metadata is written as first comment to the output. By default true.
     XscBoolean  writeGeneratorHeader;
+
+    /**
+    \brief If none-zero, the pre-processor passes its token stream directly to the parser, instead of writing out the pre-processed source code. By default false.
+    \remarks This avoids that the pre-processed source code is scanned a second time. It has no effect if 'preprocessOnly' is enabled.
+    */
+    XscBoolean  passTokenStream;
+
+    /**
+    \brief If none-zero, only the dependencies of the shader (i.e. all included files) are determined, but no output will be generated. By default false.
+    \remarks The dependencies are stored in 'XscReflectionData::dependencies'.
+    */
+    XscBoolean  scanDependenciesOnly;
+
+    //! If none-zero, only the global functions that are reachable from the entry points are analyzed (errors inside of unreachable functions are not reported). By default false.
+    XscBoolean  analyzeReachableOnly;
 };
 
 //! Name mangling descriptor structure for shader input/output variables (also referred to as "varyings"), temporary variables, and reserved keywords.
@@ -182,13 +197,26 @@ struct XscNameMangling
     XscBoolean  renameBufferFields;
 };
 
+//! Pre-defined macro structure for the pre-processor (like the "-D" compiler argument).
+struct XscPredefinedMacro
+{
+    //! Specifies the macro identifier with an optional parameter list, e.g. "FOO" or "MAX(a, b)".
+    const char* ident;
+
+    //! Specifies the macro value (or rather body). This can be NULL.
+    const char* value;
+};
+
 //! Shader input descriptor structure.
 struct XscShaderInput
 {
     //! Specifies the filename of the input shader code. This is an optional attribute, and only a hint to the compiler. By default NULL.
     const char*                     filename;
 
-    //! Specifies the input source code. This must not be null when passed to the "XscCompileShader" function!
+    /**
+    \brief Specifies the input source code. This must not be null when passed to the "XscCompileShader" function!
+    \remarks The source code is read directly from this buffer without copying it, so it must stay valid until the compilation has finished.
+    */
     const char*                     sourceCode;
 
     //! Specifies the input shader version (e.g. XscEInputHLSL5 for "HLSL 5"). By default XscEInputHLSL5.
@@ -224,6 +252,15 @@ struct XscShaderInput
 
     //! Include handler member which contains a function pointer to handle '#include'-directives.
     struct XscIncludeHandler        includeHandler;
+
+    //! Specifies the size (in bytes) of the input source code. If this is zero, 'sourceCode' must be null-terminated. By default 0.
+    size_t                          sourceCodeSize;
+
+    //! Optional list of macros that are defined before the source code is pre-processed. By default NULL.
+    const struct XscPredefinedMacro* defines;
+
+    //! Number of elements the 'defines' member points to. By default 0.
+    size_t                          definesCount;
 };
 
 //! Vertex shader semantic (or rather attribute) layout structure.
@@ -7,6 +7,8 @@
 
 #include "AST.h"
 #include "ASTFactory.h"
+#include "TypeContext.h"
+#include "ResolutionCache.h"
 #include "Exception.h"
 #include "IntrinsicAdept.h"
 #include "Variant.h"
@@ -15,6 +17,7 @@
 #include "ReportIdents.h"
 #include "HLSLKeywords.h"
 #include "GLSLKeywords.h"
+#include "Helper.h"
 #include <algorithm>
 #include <cctype>
 
@@ -696,22 +699,15 @@ bool StructDecl::IsCastableTo(const BaseTypeDenoter& rhs) const
 
 VarDecl* StructDecl::FetchVarDecl(const std::string& ident, const StructDecl** owner) const
 {
-    /* Fetch symbol from members first */
-    for (const auto& varDeclStmnt : varMembers)
-    {
-        if (auto symbol = varDeclStmnt->FetchVarDecl(ident))
-        {
-            if (owner)
-                *owner = this;
-            return symbol;
-        }
-    }
+    /* Fetch symbol from member index (includes the members of all base structures) */
+    const auto& varDecls = GetMemberIndex().varDecls;
 
-    /* Now fetch symbol from base struct */
-    if (baseStructRef)
+    auto it = varDecls.find(ident);
+    if (it != varDecls.end())
     {
-        if (auto symbol = baseStructRef->FetchVarDecl(ident, owner))
-            return symbol;
+        if (owner)
+            *owner = it->second.second;
+        return it->second.first;
     }
 
     return nullptr;
@@ -738,30 +734,26 @@ StructDecl* StructDecl::FetchBaseStructDecl(const std::string& ident)
 FunctionDecl* StructDecl::FetchFunctionDecl(
     const std::string& ident, const std::vector<TypeDenoterPtr>& argTypeDenoters, const StructDecl** owner, bool throwErrorIfNoMatch) const
 {
-    /* Fetch symbol from base struct first */
-    if (baseStructRef)
-    {
-        if (auto symbol = baseStructRef->FetchFunctionDecl(ident, argTypeDenoters, owner))
-            return symbol;
-    }
+    /* Fetch member functions from member index */
+    const auto& funcDecls = GetMemberIndex().funcDecls;
 
-    /* Now fetch symbol from members */
-    std::vector<FunctionDecl*> funcDeclList;
-    funcDeclList.reserve(funcMembers.size());
+    auto it = funcDecls.find(ident);
+    if (it == funcDecls.end())
+        return nullptr;
 
-    for (const auto& funcDecl : funcMembers)
+    /* Fetch symbol from base structures first, then from this structure */
+    for (const auto& funcMembers : it->second)
     {
-        if (funcDecl->ident.Original() == ident)
-            funcDeclList.push_back(funcDecl.get());
-    }
+        if (owner)
+            *owner = funcMembers.owner;
 
-    if (funcDeclList.empty())
-        return nullptr;
+        const bool throwOnFailure = (funcMembers.owner == this && throwErrorIfNoMatch);
 
-    if (owner)
-        *owner = this;
+        if (auto symbol = FunctionDecl::FetchFunctionDeclFromList(funcMembers.funcDecls, ident, argTypeDenoters, throwOnFailure))
+            return symbol;
+    }
 
-    return FunctionDecl::FetchFunctionDeclFromList(funcDeclList, ident, argTypeDenoters, throwErrorIfNoMatch);
+    return nullptr;
 }
 
 std::string StructDecl::FetchSimilar(const std::string& ident)
@@ -1035,6 +1027,77 @@ bool StructDecl::AccumAlignedVectorSize(unsigned int& size, unsigned int& paddin
     return true;
 }
 
+void StructDecl::InvalidateMemberIndex()
+{
+    /* Reset member index of this structure, and invalidate all other member indices (the sub structures include the members of this structure) */
+    memberIndex_.index.reset();
+    if (auto cache = ResolutionCache::Active())
+        cache->InvalidateMemberIndices();
+}
+
+const StructDecl::MemberIndex& StructDecl::GetMemberIndex() const
+{
+    /* Member indices can only be invalidated within the active compilation, so they are rebuilt each time without an active cache */
+    auto cache = ResolutionCache::Active();
+    const auto epoch = (cache != nullptr ? cache->GetMemberIndexEpoch() : 0);
+
+    /* Is the member index still up to date? */
+    const auto& current = memberIndex_.index;
+    if ( cache != nullptr                                   &&
+         current                                            &&
+         current->cache             == cache                &&
+         current->epoch             == epoch                &&
+         current->numVarMembers     == varMembers.size()    &&
+         current->numFuncMembers    == funcMembers.size()   &&
+         current->baseStructRef     == baseStructRef )
+    {
+        return *current;
+    }
+
+    /* Build new member index */
+    auto index = MakeUnique<MemberIndex>();
+    {
+        index->cache            = cache;
+        index->epoch            = epoch;
+        index->numVarMembers    = varMembers.size();
+        index->numFuncMembers   = funcMembers.size();
+        index->baseStructRef    = baseStructRef;
+
+        /* Add member variables of this structure first (the first declaration of an identifier wins) */
+        for (const auto& varDeclStmnt : varMembers)
+        {
+            for (const auto& varDecl : varDeclStmnt->varDecls)
+                index->varDecls.insert({ varDecl->ident.Original(), { varDecl.get(), this } });
+        }
+
+        for (const auto& funcDecl : funcMembers)
+        {
+            auto& funcMembersOfIdent = index->funcDecls[funcDecl->ident.Original()];
+            if (funcMembersOfIdent.empty())
+                funcMembersOfIdent.push_back({ this, {} });
+            funcMembersOfIdent.back().funcDecls.push_back(funcDecl.get());
+        }
+
+        /* Add members of base structure, which are hidden by the members of this structure */
+        if (baseStructRef)
+        {
+            const auto& baseIndex = baseStructRef->GetMemberIndex();
+
+            for (const auto& it : baseIndex.varDecls)
+                index->varDecls.insert(it);
+
+            for (const auto& it : baseIndex.funcDecls)
+            {
+                auto& funcMembersOfIdent = index->funcDecls[it.first];
+                funcMembersOfIdent.insert(funcMembersOfIdent.begin(), it.second.begin(), it.second.end());
+            }
+        }
+    }
+    memberIndex_.index = std::move(index);
+
+    return *memberIndex_.index;
+}
+
 
 /* ----- AliasDecl ----- */
 
@@ -1642,7 +1705,7 @@ TypeDenoterPtr NullExpr::DeriveTypeDenoter(const TypeDenoter* /*expectedTypeDeno
     Return 'int' as type, because null expressions are only
     used as dynamic array dimensions (which must be integral types)
     */
-    return std::make_shared<BaseTypeDenoter>(DataType::Int);
+    return TypeContext::MakeBase(DataType::Int);
 }
 
 
@@ -1691,9 +1754,9 @@ void SequenceExpr::Append(const ExprPtr& expr)
 TypeDenoterPtr LiteralExpr::DeriveTypeDenoter(const TypeDenoter* /*expectedTypeDenoter*/)
 {
     if (IsNull())
-        return std::make_shared<NullTypeDenoter>();
+        return TypeContext::MakeNull();
     else
-        return std::make_shared<BaseTypeDenoter>(dataType);
+        return TypeContext::MakeBase(dataType);
 }
 
 void LiteralExpr::ConvertDataType(const DataType type)
@@ -1815,7 +1878,7 @@ TypeDenoterPtr TernaryExpr::DeriveTypeDenoter(const TypeDenoter* /*expectedTypeD
             {
                 /* Return common type denoter, based on conditional expression type dimension */
                 const auto subDataType = VectorDataType(baseSubTypeDen->dataType, condVecSize);
-                return std::make_shared<BaseTypeDenoter>(subDataType);
+                return TypeContext::MakeBase(subDataType);
             }
         }
     }
@@ -2371,7 +2434,7 @@ BaseTypeDenoterPtr ObjectExpr::GetTypeDenoterFromSubscript() const
             {
                 /* Get vector type from subscript */
                 auto vectorType = SubscriptDataType(baseTypeDen->dataType, ident);
-                return std::make_shared<BaseTypeDenoter>(vectorType);
+                return TypeContext::MakeBase(vectorType);
             }
             catch (const std::exception& e)
             {
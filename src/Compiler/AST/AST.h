@@ -23,7 +23,10 @@
 #include <string>
 #include <set>
 #include <map>
+#include <unordered_map>
+#include <memory>
 #include <functional>
+#include <cstdint>
 
 
 namespace Xsc
@@ -36,6 +39,7 @@ For simplicity only structs with public members are used here.
 */
 
 class Visitor;
+class ResolutionCache;
 
 // Enumeration for expression finding predicates.
 enum SearchFlags : unsigned int
@@ -254,6 +258,9 @@ struct TypedAST : public AST
 
     private:
 
+        friend class ASTCloner;
+        friend class ASTSerializer;
+
         // Buffered type denoter which is stored in the "GetTypeDenoter" function and can be reset with the "ResetTypeDenoter" function.
         TypeDenoterPtr bufferedTypeDenoter_;
 
@@ -737,6 +744,12 @@ struct StructDecl : public Decl
     // Accumulates the vector size for all members in this structure (with a 16 byte boundary for each member), and returns true on success.
     bool AccumAlignedVectorSize(unsigned int& size, unsigned int& padding, unsigned int* offset = nullptr);
 
+    /*
+    Invalidates the member index of this structure and all of its sub structures.
+    Must be called after member variables or functions have been added to or removed from this structure (see 'FetchVarDecl').
+    */
+    void InvalidateMemberIndex();
+
     bool                            isClass                 = false;    // This struct was declared as 'class'.
     std::string                     baseStructName;                     // May be empty (if no inheritance is used).
     std::vector<StmntPtr>           localStmnts;                        // Local declaration statements.
@@ -751,6 +764,49 @@ struct StructDecl : public Decl
     std::map<std::string, VarDecl*> systemValuesRef;                    // List of members with system value semantic (SV_...).
     std::set<StructDecl*>           parentStructDeclRefs;               // References to all structures that have a member variable with this structure type.
     std::set<VarDecl*>              shaderOutputVarDeclRefs;            // References to all variables from this structure that are used as entry point outputs.
+
+    private:
+
+        // Member functions of one structure in the inheritance chain with the same identifier.
+        struct FunctionMembers
+        {
+            const StructDecl*           owner;
+            std::vector<FunctionDecl*>  funcDecls;
+        };
+
+        // Index of all members by their original identifiers (including all base structures).
+        struct MemberIndex
+        {
+            std::unordered_map<std::string, std::pair<VarDecl*, const StructDecl*>> varDecls;   // Member variable and its owner.
+            std::unordered_map<std::string, std::vector<FunctionMembers>>           funcDecls;  // Member functions from the root base to this structure.
+
+            const ResolutionCache*                                                  cache           = nullptr;  // Compilation this index belongs to.
+            std::uint64_t                                                           epoch           = 0;
+            std::size_t                                                             numVarMembers   = 0;
+            std::size_t                                                             numFuncMembers  = 0;
+            const StructDecl*                                                       baseStructRef   = nullptr;
+        };
+
+        // Owner of the member index, which is not copied (a copied structure rebuilds its own index on demand).
+        struct MemberIndexOwner
+        {
+            MemberIndexOwner() = default;
+            MemberIndexOwner(const MemberIndexOwner&)
+            {
+            }
+            MemberIndexOwner& operator = (const MemberIndexOwner&)
+            {
+                index.reset();
+                return *this;
+            }
+
+            std::unique_ptr<MemberIndex> index;
+        };
+
+        // Returns the member index of this structure, which is (re-)built on demand.
+        const MemberIndex& GetMemberIndex() const;
+
+        mutable MemberIndexOwner memberIndex_;
 };
 
 // Type alias declaration.
@@ -0,0 +1,635 @@
+/*
+ * ASTCloner.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ASTCloner.h"
+#include "TypeContext.h"
+#include "Exception.h"
+#include <algorithm>
+
+
+namespace Xsc
+{
+
+
+ProgramPtr ASTCloner::Clone(const Program& program)
+{
+    /* References of the context analysis are not remapped, so the program must not have been analyzed yet */
+    if (program.entryPointRef != nullptr)
+        RuntimeErr("failed to copy program that has already been analyzed", &program);
+
+    astCopies_.Clear();
+    typeDenoterCopies_.Clear();
+    referringASTs_.clear();
+    referringTypeDenoters_.clear();
+
+    /* Copy all nodes and type denoters */
+    auto programCopy = std::static_pointer_cast<Program>(CopyAST(program));
+
+    /* Remap all references after all nodes have been copied, since a reference may point to a node that is copied later */
+    for (auto ast : referringASTs_)
+        RemapReferences(*ast);
+
+    for (auto typeDenoter : referringTypeDenoters_)
+        RemapReferences(*typeDenoter);
+
+    return programCopy;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+template <typename T>
+void ASTCloner::Copy(std::shared_ptr<T>& ast)
+{
+    if (ast)
+        ast = std::static_pointer_cast<T>(CopyAST(*ast));
+}
+
+template <typename T>
+void ASTCloner::Copy(std::vector<std::shared_ptr<T>>& astList)
+{
+    for (auto& ast : astList)
+        Copy(ast);
+}
+
+template <typename T>
+void ASTCloner::CopyTypeDenoter(std::shared_ptr<T>& typeDenoter)
+{
+    if (typeDenoter)
+        typeDenoter = std::static_pointer_cast<T>(CopyTypeDenoterPrimary(typeDenoter));
+}
+
+template <typename T>
+std::shared_ptr<T> ASTCloner::CopyNode(const T& ast)
+{
+    auto astCopy = std::make_shared<T>(ast);
+    CopyMembers(*astCopy);
+    return astCopy;
+}
+
+#define COPY_AST(AST_NAME)                                                  \
+    case AST::Types::AST_NAME:                                              \
+        astCopy = CopyNode(static_cast<const AST_NAME&>(ast));              \
+        break
+
+ASTPtr ASTCloner::CopyAST(const AST& ast)
+{
+    /* Return previous copy if this node has already been reached from another owner */
+    if (auto astCopy = astCopies_.Find(&ast))
+        return *astCopy;
+
+    ASTPtr astCopy;
+
+    switch (ast.Type())
+    {
+        COPY_AST( Program           );
+        COPY_AST( CodeBlock         );
+        COPY_AST( Attribute         );
+        COPY_AST( SwitchCase        );
+        COPY_AST( SamplerValue      );
+        COPY_AST( Register          );
+        COPY_AST( PackOffset        );
+        COPY_AST( ArrayDimension    );
+        COPY_AST( TypeSpecifier     );
+
+        COPY_AST( VarDecl           );
+        COPY_AST( BufferDecl        );
+        COPY_AST( SamplerDecl       );
+        COPY_AST( StructDecl        );
+        COPY_AST( AliasDecl         );
+        COPY_AST( FunctionDecl      );
+        COPY_AST( UniformBufferDecl );
+
+        COPY_AST( VarDeclStmnt      );
+        COPY_AST( BufferDeclStmnt   );
+        COPY_AST( SamplerDeclStmnt  );
+        COPY_AST( AliasDeclStmnt    );
+        COPY_AST( BasicDeclStmnt    );
+
+        COPY_AST( NullStmnt         );
+        COPY_AST( CodeBlockStmnt    );
+        COPY_AST( ForLoopStmnt      );
+        COPY_AST( WhileLoopStmnt    );
+        COPY_AST( DoWhileLoopStmnt  );
+        COPY_AST( IfStmnt           );
+        COPY_AST( ElseStmnt         );
+        COPY_AST( SwitchStmnt       );
+        COPY_AST( ExprStmnt         );
+        COPY_AST( ReturnStmnt       );
+        COPY_AST( CtrlTransferStmnt );
+        COPY_AST( LayoutStmnt       );
+
+        COPY_AST( NullExpr          );
+        COPY_AST( SequenceExpr      );
+        COPY_AST( LiteralExpr       );
+        COPY_AST( TypeSpecifierExpr );
+        COPY_AST( TernaryExpr       );
+        COPY_AST( BinaryExpr        );
+        COPY_AST( UnaryExpr         );
+        COPY_AST( PostUnaryExpr     );
+        COPY_AST( CallExpr          );
+        COPY_AST( BracketExpr       );
+        COPY_AST( ObjectExpr        );
+        COPY_AST( AssignExpr        );
+        COPY_AST( ArrayExpr         );
+        COPY_AST( CastExpr          );
+        COPY_AST( InitializerExpr   );
+
+        default:
+            RuntimeErr("failed to copy AST node of unknown type", &ast);
+    }
+
+    /* Record the copy of every node, for further owners and for the remapping of references */
+    astCopies_.Insert(&ast, astCopy);
+
+    return astCopy;
+}
+
+#undef COPY_AST
+
+TypeDenoterPtr ASTCloner::CopyTypeDenoterPrimary(const TypeDenoterPtr& typeDenoter)
+{
+    /* Share interned type denoters, since they are never modified */
+    if (TypeContext::FindCanonical(typeDenoter.get()) == typeDenoter)
+        return typeDenoter;
+
+    /* Return previous copy if this type denoter has multiple owners */
+    if (auto typeDenoterCopy = typeDenoterCopies_.Find(typeDenoter.get()))
+        return *typeDenoterCopy;
+
+    TypeDenoterPtr typeDenoterCopy;
+
+    switch (typeDenoter->Type())
+    {
+        case TypeDenoter::Types::Void:
+            typeDenoterCopy = std::make_shared<VoidTypeDenoter>(static_cast<const VoidTypeDenoter&>(*typeDenoter));
+            break;
+
+        case TypeDenoter::Types::Null:
+            typeDenoterCopy = std::make_shared<NullTypeDenoter>(static_cast<const NullTypeDenoter&>(*typeDenoter));
+            break;
+
+        case TypeDenoter::Types::Base:
+            typeDenoterCopy = std::make_shared<BaseTypeDenoter>(static_cast<const BaseTypeDenoter&>(*typeDenoter));
+            break;
+
+        case TypeDenoter::Types::Buffer:
+        {
+            auto bufferTypeDen = std::make_shared<BufferTypeDenoter>(static_cast<const BufferTypeDenoter&>(*typeDenoter));
+            CopyTypeDenoter(bufferTypeDen->genericTypeDenoter);
+            typeDenoterCopy = bufferTypeDen;
+        }
+        break;
+
+        case TypeDenoter::Types::Sampler:
+            typeDenoterCopy = std::make_shared<SamplerTypeDenoter>(static_cast<const SamplerTypeDenoter&>(*typeDenoter));
+            break;
+
+        case TypeDenoter::Types::Struct:
+            typeDenoterCopy = std::make_shared<StructTypeDenoter>(static_cast<const StructTypeDenoter&>(*typeDenoter));
+            break;
+
+        case TypeDenoter::Types::Alias:
+            typeDenoterCopy = std::make_shared<AliasTypeDenoter>(static_cast<const AliasTypeDenoter&>(*typeDenoter));
+            break;
+
+        case TypeDenoter::Types::Array:
+        {
+            auto arrayTypeDen = std::make_shared<ArrayTypeDenoter>(static_cast<const ArrayTypeDenoter&>(*typeDenoter));
+            CopyTypeDenoter(arrayTypeDen->subTypeDenoter);
+            Copy(arrayTypeDen->arrayDims);
+            typeDenoterCopy = arrayTypeDen;
+        }
+        break;
+
+        case TypeDenoter::Types::Function:
+            typeDenoterCopy = std::make_shared<FunctionTypeDenoter>(static_cast<const FunctionTypeDenoter&>(*typeDenoter));
+            break;
+    }
+
+    typeDenoterCopies_.Insert(typeDenoter.get(), typeDenoterCopy);
+
+    referringTypeDenoters_.push_back(typeDenoterCopy.get());
+
+    return typeDenoterCopy;
+}
+
+/* ------- Members of common AST nodes ------- */
+
+void ASTCloner::CopyMembers(AST& /*ast*/)
+{
+    // dummy
+}
+
+void ASTCloner::CopyMembers(Stmnt& ast)
+{
+    Copy(ast.attribs);
+}
+
+void ASTCloner::CopyMembers(TypedAST& ast)
+{
+    CopyTypeDenoter(ast.bufferedTypeDenoter_);
+}
+
+void ASTCloner::CopyMembers(Program& ast)
+{
+    Copy(ast.globalStmnts);
+    Copy(ast.disabledAST);
+}
+
+void ASTCloner::CopyMembers(CodeBlock& ast)
+{
+    Copy(ast.stmnts);
+}
+
+void ASTCloner::CopyMembers(SamplerValue& ast)
+{
+    Copy(ast.value);
+}
+
+void ASTCloner::CopyMembers(Attribute& ast)
+{
+    Copy(ast.arguments);
+}
+
+void ASTCloner::CopyMembers(SwitchCase& ast)
+{
+    Copy(ast.expr);
+    Copy(ast.stmnts);
+}
+
+void ASTCloner::CopyMembers(ArrayDimension& ast)
+{
+    CopyMembers(static_cast<TypedAST&>(ast));
+    Copy(ast.expr);
+}
+
+void ASTCloner::CopyMembers(TypeSpecifier& ast)
+{
+    CopyMembers(static_cast<TypedAST&>(ast));
+    Copy(ast.structDecl);
+    CopyTypeDenoter(ast.typeDenoter);
+}
+
+/* ------- Members of declaration objects ------- */
+
+void ASTCloner::CopyMembers(VarDecl& ast)
+{
+    referringASTs_.push_back(&ast);
+    CopyMembers(static_cast<TypedAST&>(ast));
+    Copy(ast.namespaceExpr);
+    Copy(ast.arrayDims);
+    Copy(ast.slotRegisters);
+    Copy(ast.packOffset);
+    Copy(ast.annotations);
+    Copy(ast.initializer);
+    CopyTypeDenoter(ast.customTypeDenoter);
+}
+
+void ASTCloner::CopyMembers(BufferDecl& ast)
+{
+    referringASTs_.push_back(&ast);
+    CopyMembers(static_cast<TypedAST&>(ast));
+    Copy(ast.arrayDims);
+    Copy(ast.slotRegisters);
+    Copy(ast.annotations);
+}
+
+void ASTCloner::CopyMembers(SamplerDecl& ast)
+{
+    referringASTs_.push_back(&ast);
+    CopyMembers(static_cast<TypedAST&>(ast));
+    Copy(ast.arrayDims);
+    Copy(ast.slotRegisters);
+    Copy(ast.samplerValues);
+}
+
+void ASTCloner::CopyMembers(StructDecl& ast)
+{
+    referringASTs_.push_back(&ast);
+    CopyMembers(static_cast<TypedAST&>(ast));
+    Copy(ast.localStmnts);
+    Copy(ast.varMembers);
+    Copy(ast.funcMembers);
+}
+
+void ASTCloner::CopyMembers(AliasDecl& ast)
+{
+    referringASTs_.push_back(&ast);
+    CopyMembers(static_cast<TypedAST&>(ast));
+    CopyTypeDenoter(ast.typeDenoter);
+}
+
+void ASTCloner::CopyMembers(FunctionDecl& ast)
+{
+    referringASTs_.push_back(&ast);
+    CopyMembers(static_cast<TypedAST&>(ast));
+    Copy(ast.returnType);
+    Copy(ast.parameters);
+    Copy(ast.annotations);
+    Copy(ast.codeBlock);
+}
+
+void ASTCloner::CopyMembers(UniformBufferDecl& ast)
+{
+    referringASTs_.push_back(&ast);
+    CopyMembers(static_cast<TypedAST&>(ast));
+    Copy(ast.slotRegisters);
+    Copy(ast.localStmnts);
+    Copy(ast.varMembers);
+}
+
+/* ------- Members of declaration statements ------- */
+
+void ASTCloner::CopyMembers(BufferDeclStmnt& ast)
+{
+    CopyMembers(static_cast<Stmnt&>(ast));
+    CopyTypeDenoter(ast.typeDenoter);
+    Copy(ast.bufferDecls);
+}
+
+void ASTCloner::CopyMembers(SamplerDeclStmnt& ast)
+{
+    CopyMembers(static_cast<Stmnt&>(ast));
+    CopyTypeDenoter(ast.typeDenoter);
+    Copy(ast.samplerDecls);
+}
+
+void ASTCloner::CopyMembers(BasicDeclStmnt& ast)
+{
+    CopyMembers(static_cast<Stmnt&>(ast));
+    Copy(ast.declObject);
+}
+
+void ASTCloner::CopyMembers(VarDeclStmnt& ast)
+{
+    CopyMembers(static_cast<Stmnt&>(ast));
+    Copy(ast.typeSpecifier);
+    Copy(ast.varDecls);
+}
+
+void ASTCloner::CopyMembers(AliasDeclStmnt& ast)
+{
+    CopyMembers(static_cast<Stmnt&>(ast));
+    Copy(ast.structDecl);
+    Copy(ast.aliasDecls);
+}
+
+/* ------- Members of common statements ------- */
+
+void ASTCloner::CopyMembers(CodeBlockStmnt& ast)
+{
+    CopyMembers(static_cast<Stmnt&>(ast));
+    Copy(ast.codeBlock);
+}
+
+void ASTCloner::CopyMembers(ForLoopStmnt& ast)
+{
+    CopyMembers(static_cast<Stmnt&>(ast));
+    Copy(ast.initStmnt);
+    Copy(ast.condition);
+    Copy(ast.iteration);
+    Copy(ast.bodyStmnt);
+}
+
+void ASTCloner::CopyMembers(WhileLoopStmnt& ast)
+{
+    CopyMembers(static_cast<Stmnt&>(ast));
+    Copy(ast.condition);
+    Copy(ast.bodyStmnt);
+}
+
+void ASTCloner::CopyMembers(DoWhileLoopStmnt& ast)
+{
+    CopyMembers(static_cast<Stmnt&>(ast));
+    Copy(ast.bodyStmnt);
+    Copy(ast.condition);
+}
+
+void ASTCloner::CopyMembers(IfStmnt& ast)
+{
+    CopyMembers(static_cast<Stmnt&>(ast));
+    Copy(ast.condition);
+    Copy(ast.bodyStmnt);
+    Copy(ast.elseStmnt);
+}
+
+void ASTCloner::CopyMembers(ElseStmnt& ast)
+{
+    CopyMembers(static_cast<Stmnt&>(ast));
+    Copy(ast.bodyStmnt);
+}
+
+void ASTCloner::CopyMembers(SwitchStmnt& ast)
+{
+    CopyMembers(static_cast<Stmnt&>(ast));
+    Copy(ast.selector);
+    Copy(ast.cases);
+}
+
+void ASTCloner::CopyMembers(ExprStmnt& ast)
+{
+    CopyMembers(static_cast<Stmnt&>(ast));
+    Copy(ast.expr);
+}
+
+void ASTCloner::CopyMembers(ReturnStmnt& ast)
+{
+    CopyMembers(static_cast<Stmnt&>(ast));
+    Copy(ast.expr);
+}
+
+/* ------- Members of expressions ------- */
+
+void ASTCloner::CopyMembers(SequenceExpr& ast)
+{
+    CopyMembers(static_cast<TypedAST&>(ast));
+    Copy(ast.exprs);
+}
+
+void ASTCloner::CopyMembers(TypeSpecifierExpr& ast)
+{
+    CopyMembers(static_cast<TypedAST&>(ast));
+    Copy(ast.typeSpecifier);
+}
+
+void ASTCloner::CopyMembers(TernaryExpr& ast)
+{
+    CopyMembers(static_cast<TypedAST&>(ast));
+    Copy(ast.condExpr);
+    Copy(ast.thenExpr);
+    Copy(ast.elseExpr);
+}
+
+void ASTCloner::CopyMembers(BinaryExpr& ast)
+{
+    CopyMembers(static_cast<TypedAST&>(ast));
+    Copy(ast.lhsExpr);
+    Copy(ast.rhsExpr);
+}
+
+void ASTCloner::CopyMembers(UnaryExpr& ast)
+{
+    CopyMembers(static_cast<TypedAST&>(ast));
+    Copy(ast.expr);
+}
+
+void ASTCloner::CopyMembers(PostUnaryExpr& ast)
+{
+    CopyMembers(static_cast<TypedAST&>(ast));
+    Copy(ast.expr);
+}
+
+void ASTCloner::CopyMembers(CallExpr& ast)
+{
+    CopyMembers(static_cast<TypedAST&>(ast));
+    Copy(ast.prefixExpr);
+    CopyTypeDenoter(ast.typeDenoter);
+    Copy(ast.arguments);
+}
+
+void ASTCloner::CopyMembers(BracketExpr& ast)
+{
+    CopyMembers(static_cast<TypedAST&>(ast));
+    Copy(ast.expr);
+}
+
+void ASTCloner::CopyMembers(AssignExpr& ast)
+{
+    CopyMembers(static_cast<TypedAST&>(ast));
+    Copy(ast.lvalueExpr);
+    Copy(ast.rvalueExpr);
+}
+
+void ASTCloner::CopyMembers(ObjectExpr& ast)
+{
+    CopyMembers(static_cast<TypedAST&>(ast));
+    Copy(ast.prefixExpr);
+}
+
+void ASTCloner::CopyMembers(ArrayExpr& ast)
+{
+    CopyMembers(static_cast<TypedAST&>(ast));
+    Copy(ast.prefixExpr);
+    Copy(ast.arrayIndices);
+}
+
+void ASTCloner::CopyMembers(CastExpr& ast)
+{
+    CopyMembers(static_cast<TypedAST&>(ast));
+    Copy(ast.typeSpecifier);
+    Copy(ast.expr);
+}
+
+void ASTCloner::CopyMembers(InitializerExpr& ast)
+{
+    CopyMembers(static_cast<TypedAST&>(ast));
+    Copy(ast.exprs);
+}
+
+/* ------- References ------- */
+
+template <typename T>
+void ASTCloner::Remap(T*& ref) const
+{
+    if (ref)
+    {
+        if (auto astCopy = astCopies_.Find(ref))
+            ref = static_cast<T*>(astCopy->get());
+    }
+}
+
+template <typename T>
+void ASTCloner::Remap(std::vector<T*>& refs) const
+{
+    for (auto& ref : refs)
+        Remap(ref);
+}
+
+void ASTCloner::RemapReferences(AST& ast)
+{
+    switch (ast.Type())
+    {
+        case AST::Types::VarDecl:
+        {
+            auto& varDecl = static_cast<VarDecl&>(ast);
+            Remap(varDecl.declStmntRef);
+            Remap(varDecl.bufferDeclRef);
+            Remap(varDecl.structDeclRef);
+        }
+        break;
+
+        case AST::Types::BufferDecl:
+            Remap(static_cast<BufferDecl&>(ast).declStmntRef);
+            break;
+
+        case AST::Types::SamplerDecl:
+            Remap(static_cast<SamplerDecl&>(ast).declStmntRef);
+            break;
+
+        case AST::Types::StructDecl:
+            Remap(static_cast<StructDecl&>(ast).declStmntRef);
+            break;
+
+        case AST::Types::AliasDecl:
+            Remap(static_cast<AliasDecl&>(ast).declStmntRef);
+            break;
+
+        case AST::Types::FunctionDecl:
+        {
+            auto& funcDecl = static_cast<FunctionDecl&>(ast);
+            Remap(funcDecl.declStmntRef);
+            Remap(funcDecl.structDeclRef);
+        }
+        break;
+
+        case AST::Types::UniformBufferDecl:
+            Remap(static_cast<UniformBufferDecl&>(ast).declStmntRef);
+            break;
+
+        default:
+            break;
+    }
+}
+
+void ASTCloner::RemapReferences(TypeDenoter& typeDenoter)
+{
+    switch (typeDenoter.Type())
+    {
+        case TypeDenoter::Types::Buffer:
+            Remap(static_cast<BufferTypeDenoter&>(typeDenoter).bufferDeclRef);
+            break;
+
+        case TypeDenoter::Types::Sampler:
+            Remap(static_cast<SamplerTypeDenoter&>(typeDenoter).samplerDeclRef);
+            break;
+
+        case TypeDenoter::Types::Struct:
+            Remap(static_cast<StructTypeDenoter&>(typeDenoter).structDeclRef);
+            break;
+
+        case TypeDenoter::Types::Alias:
+            Remap(static_cast<AliasTypeDenoter&>(typeDenoter).aliasDeclRef);
+            break;
+
+        case TypeDenoter::Types::Function:
+            Remap(static_cast<FunctionTypeDenoter&>(typeDenoter).funcDeclRefs);
+            break;
+
+        default:
+            break;
+    }
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
\ No newline at end of file
@@ -0,0 +1,240 @@
+/*
+ * ASTCloner.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_AST_CLONER_H
+#define XSC_AST_CLONER_H
+
+
+#include "AST.h"
+#include "Hash.h"
+#include <vector>
+#include <memory>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace Xsc
+{
+
+
+/*
+Deep copy of an entire program that has been parsed but not analyzed yet, so that each entry point can analyze its own copy.
+All AST nodes and all type denoters, that are not interned in the active type context, are copied,
+and every reference that is set by the parser (e.g. 'VarDecl::declStmntRef', 'StructTypeDenoter::structDeclRef') is remapped to the copy.
+The references of the context analysis (e.g. 'ObjectExpr::symbolRef') are not remapped, so a decorated program can not be copied.
+Nodes that are shared by multiple owners (e.g. the 'varMembers' and 'localStmnts' of a structure) are shared in the copy as well,
+since the copy of each node is recorded by its original.
+The identifiers of the copied nodes refer to the atoms of the original program,
+so the atom table and type context of the original program must outlive the copy.
+*/
+class ASTCloner
+{
+
+    public:
+
+        // Returns a deep copy of the specified program, which must not have been analyzed yet.
+        ProgramPtr Clone(const Program& program);
+
+    private:
+
+        /*
+        Hash table from original objects to their copies with open addressing.
+        A program may have hundreds of thousands of nodes, so this is considerably faster than 'std::unordered_map' with one allocation per entry.
+        */
+        template <typename TKey, typename TValue>
+        class CopyTable
+        {
+
+            public:
+
+                // Returns the copy of the specified original object, or null if there is no copy.
+                const TValue* Find(const TKey* key) const
+                {
+                    if (!entries_.empty())
+                    {
+                        for (auto i = IndexOf(key);; i = ((i + 1) & (entries_.size() - 1)))
+                        {
+                            const auto& entry = entries_[i];
+                            if (entry.key == key)
+                                return &(entry.value);
+                            if (entry.key == nullptr)
+                                break;
+                        }
+                    }
+                    return nullptr;
+                }
+
+                // Inserts the copy of the specified original object, which must not have been inserted before.
+                void Insert(const TKey* key, const TValue& value)
+                {
+                    /* Keep the load factor below 1/2 */
+                    if ((size_ + 1) * 2 > entries_.size())
+                        Rehash(entries_.empty() ? 1024 : entries_.size() * 2);
+
+                    InsertPrimary(key, value);
+                }
+
+                // Returns all copies in an unspecified order.
+                template <typename Func>
+                void ForEach(const Func& func) const
+                {
+                    for (const auto& entry : entries_)
+                    {
+                        if (entry.key != nullptr)
+                            func(entry.value);
+                    }
+                }
+
+                void Clear()
+                {
+                    entries_.clear();
+                    size_ = 0;
+                }
+
+            private:
+
+                struct Entry
+                {
+                    const TKey* key = nullptr;
+                    TValue      value;
+                };
+
+                // Returns the initial slot of the specified key.
+                std::size_t IndexOf(const TKey* key) const
+                {
+                    return (HashPointer(key) & (entries_.size() - 1));
+                }
+
+                void InsertPrimary(const TKey* key, TValue value)
+                {
+                    auto i = IndexOf(key);
+                    while (entries_[i].key != nullptr)
+                        i = ((i + 1) & (entries_.size() - 1));
+
+                    entries_[i].key     = key;
+                    entries_[i].value   = std::move(value);
+                    ++size_;
+                }
+
+                void Rehash(std::size_t capacity)
+                {
+                    std::vector<Entry> prevEntries(capacity);
+                    prevEntries.swap(entries_);
+                    size_ = 0;
+
+                    for (auto& entry : prevEntries)
+                    {
+                        if (entry.key != nullptr)
+                            InsertPrimary(entry.key, std::move(entry.value));
+                    }
+                }
+
+                std::vector<Entry>  entries_;   // Number of entries is always a power of two.
+                std::size_t         size_       = 0;
+
+        };
+
+        /* === Functions === */
+
+        // Replaces the specified node by its copy.
+        template <typename T>
+        void Copy(std::shared_ptr<T>& ast);
+
+        // Replaces all specified nodes by their copies.
+        template <typename T>
+        void Copy(std::vector<std::shared_ptr<T>>& astList);
+
+        // Replaces the specified type denoter by its copy.
+        template <typename T>
+        void CopyTypeDenoter(std::shared_ptr<T>& typeDenoter);
+
+        // Returns the copy of the specified node, or its previous copy if the node has already been reached from another owner.
+        ASTPtr CopyAST(const AST& ast);
+        TypeDenoterPtr CopyTypeDenoterPrimary(const TypeDenoterPtr& typeDenoter);
+
+        // Copies all members of the specified node and replaces all owned nodes by their copies.
+        template <typename T>
+        std::shared_ptr<T> CopyNode(const T& ast);
+
+        // Replaces the owned nodes of the specified node copy by their copies (nodes without owned nodes use the overload of their base class).
+        void CopyMembers(AST&               ast);
+        void CopyMembers(Stmnt&             ast);
+        void CopyMembers(TypedAST&          ast);
+        void CopyMembers(Program&           ast);
+        void CopyMembers(CodeBlock&         ast);
+        void CopyMembers(SamplerValue&      ast);
+        void CopyMembers(Attribute&         ast);
+        void CopyMembers(SwitchCase&        ast);
+        void CopyMembers(ArrayDimension&    ast);
+        void CopyMembers(TypeSpecifier&     ast);
+        void CopyMembers(VarDecl&           ast);
+        void CopyMembers(BufferDecl&        ast);
+        void CopyMembers(SamplerDecl&       ast);
+        void CopyMembers(StructDecl&        ast);
+        void CopyMembers(AliasDecl&         ast);
+        void CopyMembers(FunctionDecl&      ast);
+        void CopyMembers(UniformBufferDecl& ast);
+        void CopyMembers(BufferDeclStmnt&   ast);
+        void CopyMembers(SamplerDeclStmnt&  ast);
+        void CopyMembers(BasicDeclStmnt&    ast);
+        void CopyMembers(VarDeclStmnt&      ast);
+        void CopyMembers(AliasDeclStmnt&    ast);
+        void CopyMembers(CodeBlockStmnt&    ast);
+        void CopyMembers(ForLoopStmnt&      ast);
+        void CopyMembers(WhileLoopStmnt&    ast);
+        void CopyMembers(DoWhileLoopStmnt&  ast);
+        void CopyMembers(IfStmnt&           ast);
+        void CopyMembers(ElseStmnt&         ast);
+        void CopyMembers(SwitchStmnt&       ast);
+        void CopyMembers(ExprStmnt&         ast);
+        void CopyMembers(ReturnStmnt&       ast);
+        void CopyMembers(SequenceExpr&      ast);
+        void CopyMembers(TypeSpecifierExpr& ast);
+        void CopyMembers(TernaryExpr&       ast);
+        void CopyMembers(BinaryExpr&        ast);
+        void CopyMembers(UnaryExpr&         ast);
+        void CopyMembers(PostUnaryExpr&     ast);
+        void CopyMembers(CallExpr&          ast);
+        void CopyMembers(BracketExpr&       ast);
+        void CopyMembers(AssignExpr&        ast);
+        void CopyMembers(ObjectExpr&        ast);
+        void CopyMembers(ArrayExpr&         ast);
+        void CopyMembers(CastExpr&          ast);
+        void CopyMembers(InitializerExpr&   ast);
+
+        // Replaces the specified reference by the reference to its copy (if the referenced node has been copied).
+        template <typename T>
+        void Remap(T*& ref) const;
+
+        template <typename T>
+        void Remap(std::vector<T*>& refs) const;
+
+        void RemapReferences(AST& ast);
+        void RemapReferences(TypeDenoter& typeDenoter);
+
+        /* === Members === */
+
+        // Copies of all AST nodes and type denoters by their originals.
+        CopyTable<AST, ASTPtr>                  astCopies_;
+        CopyTable<TypeDenoter, TypeDenoterPtr>  typeDenoterCopies_;
+
+        // Copies of all AST nodes which have references from the parser to other AST nodes, and copies of all type denoters.
+        std::vector<AST*>                       referringASTs_;
+        std::vector<TypeDenoter*>               referringTypeDenoters_;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include "Exception.h"
 #include "Token.h"
 #include "ReportIdents.h"
+#include "IntrinsicTable.h"
 #include <map>
 #include <algorithm>
 
@@ -766,12 +767,11 @@ DataType SubscriptDataType(const DataType dataType, const std::string& subscript
 
 static DataType IntLiteralTokenToDataType(const Token& tkn)
 {
-    const auto& s = tkn.Spell();
-
-    if (!s.empty())
+    if (tkn.SpellSize() > 0)
     {
         /* Has literal the 'u' or 'U' suffix for unsigned integers? */
-        if (s.back() == 'u' || s.back() == 'U')
+        const auto back = tkn.SpellData()[tkn.SpellSize() - 1];
+        if (back == 'u' || back == 'U')
             return DataType::UInt;
     }
 
@@ -780,16 +780,15 @@ static DataType IntLiteralTokenToDataType(const Token& tkn)
 
 static DataType FloatLiteralTokenToDataType(const Token& tkn)
 {
-    const auto& s = tkn.Spell();
-
-    if (!s.empty())
+    if (tkn.SpellSize() > 0)
     {
         /* Has literal the 'f' or 'F' suffix for single precision floats? */
-        if (s.back() == 'f' || s.back() == 'F')
+        const auto back = tkn.SpellData()[tkn.SpellSize() - 1];
+        if (back == 'f' || back == 'F')
             return DataType::Float;
 
         /* Has literal the 'h' or 'H' suffix for half precision floats? */
-        if (s.back() == 'h' || s.back() == 'H')
+        if (back == 'h' || back == 'H')
             return DataType::Half;
     }
 
@@ -1288,6 +1287,8 @@ Intrinsic InterlockedToImageAtomicIntrinsic(const Intrinsic t)
 
 struct GatherIntrinsicInfo
 {
+    GatherIntrinsicInfo() = default;
+
     GatherIntrinsicInfo(int componentIdx, int offsetCount, bool isCompare = false) :
         componentIdx { componentIdx },
         offsetCount  { offsetCount  },
@@ -1300,7 +1301,7 @@ struct GatherIntrinsicInfo
     bool    isCompare       = false;
 };
 
-static std::map<Intrinsic, GatherIntrinsicInfo> GenerateGatherIntrinsicInfoMap()
+static IntrinsicTable<GatherIntrinsicInfo> GenerateGatherIntrinsicInfoTable()
 {
     using T = Intrinsic;
 
@@ -1360,22 +1361,20 @@ static std::map<Intrinsic, GatherIntrinsicInfo> GenerateGatherIntrinsicInfoMap()
     };
 }
 
-static const auto g_gatherIntrinsicInfoMap = GenerateGatherIntrinsicInfoMap();
+static const auto g_gatherIntrinsicInfoTable = GenerateGatherIntrinsicInfoTable();
 
 int GetGatherIntrinsicOffsetParamCount(const Intrinsic t)
 {
-    auto it = g_gatherIntrinsicInfoMap.find(t);
-    if (it != g_gatherIntrinsicInfoMap.end())
-        return it->second.offsetCount;
+    if (auto info = g_gatherIntrinsicInfoTable.Find(t))
+        return info->offsetCount;
     else
         return 0;
 }
 
 int GetGatherIntrinsicComponentIndex(const Intrinsic t)
 {
-    auto it = g_gatherIntrinsicInfoMap.find(t);
-    if (it != g_gatherIntrinsicInfoMap.end())
-        return it->second.componentIdx;
+    if (auto info = g_gatherIntrinsicInfoTable.Find(t))
+        return info->componentIdx;
     else
         return 0;
 }
@@ -1205,6 +1205,8 @@ class IndexedSemantic
 
     private:
 
+        friend class ASTSerializer;
+
         Semantic    semantic_   = Semantic::Undefined;
         int         index_      = 0;
         std::string userDefined_;
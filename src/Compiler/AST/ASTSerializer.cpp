@@ -0,0 +1,1498 @@
+/*
+ * ASTSerializer.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ASTSerializer.h"
+#include "TypeContext.h"
+#include "AtomTable.h"
+#include <stdexcept>
+#include <cstring>
+
+
+namespace Xsc
+{
+
+
+// Returns true if the specified node is an instance of the specified node class.
+template <typename T>
+static bool IsNodeOf(const AST& ast)
+{
+    return (ast.Type() == T::classType);
+}
+
+template <>
+bool IsNodeOf<AST>(const AST& /*ast*/)
+{
+    return true;
+}
+
+template <>
+bool IsNodeOf<Stmnt>(const AST& ast)
+{
+    return IsStmntAST(ast.Type());
+}
+
+template <>
+bool IsNodeOf<Expr>(const AST& ast)
+{
+    return IsExprAST(ast.Type());
+}
+
+template <>
+bool IsNodeOf<Decl>(const AST& ast)
+{
+    return IsDeclAST(ast.Type());
+}
+
+// Returns true if the specified type denoter is an instance of the specified type denoter class.
+template <typename T>
+static bool IsTypeDenoterOf(const TypeDenoter& typeDenoter)
+{
+    return (typeDenoter.Type() == T::classType);
+}
+
+template <>
+bool IsTypeDenoterOf<TypeDenoter>(const TypeDenoter& /*typeDenoter*/)
+{
+    return true;
+}
+
+void ASTSerializer::WriteProgram(const Program& program, SnapshotWriter& writer)
+{
+    Clear();
+
+    /* Collect all nodes, type denoters, strings, and source origins (the program is not modified in any mode but 'Modes::Read') */
+    mode_ = Modes::Enumerate;
+    RegisterNode(const_cast<Program*>(&program));
+    TransferTables();
+
+    /* Write tables and the members of all nodes and type denoters */
+    mode_   = Modes::Write;
+    writer_ = &writer;
+
+    WriteHeader();
+    TransferTables();
+
+    Clear();
+}
+
+ProgramPtr ASTSerializer::ReadProgram(SnapshotReader& reader)
+{
+    Clear();
+
+    /* Read tables, and make all nodes and type denoters before their members are read, so all references can be resolved immediately */
+    mode_   = Modes::Read;
+    reader_ = &reader;
+
+    ReadHeader();
+
+    if (nodeOwners_.empty() || nodeOwners_.front()->Type() != AST::Types::Program)
+        throw std::runtime_error("missing program in serialized AST");
+
+    TransferTables();
+
+    auto program = std::static_pointer_cast<Program>(nodeOwners_.front());
+
+    Clear();
+
+    return program;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void ASTSerializer::Clear()
+{
+    writer_ = nullptr;
+    reader_ = nullptr;
+
+    nodes_.clear();
+    nodeOwners_.clear();
+    typeDenoters_.clear();
+    canonicalTypes_.clear();
+    nodeIndices_.clear();
+    typeDenoterIndices_.clear();
+    strings_.clear();
+    atoms_.clear();
+    stringIndices_.clear();
+    origins_.clear();
+    originIndices_.clear();
+}
+
+void ASTSerializer::TransferTables()
+{
+    /* Tables can grow while they are enumerated, since nodes and type denoters are registered by their owners */
+    for (std::size_t i = 0, j = 0; i < nodes_.size() || j < typeDenoters_.size();)
+    {
+        for (; i < nodes_.size(); ++i)
+            TransferAST(*nodes_[i]);
+
+        for (; j < typeDenoters_.size(); ++j)
+        {
+            /* Interned type denoters are made from their table entry only */
+            if (!canonicalTypes_[j])
+                TransferMembers(*typeDenoters_[j]);
+        }
+    }
+}
+
+void ASTSerializer::WriteHeader()
+{
+    /* Write tables of strings and source origins */
+    writer_->WriteVarUInt(strings_.size());
+    for (const auto& s : strings_)
+        writer_->WriteString(s);
+
+    writer_->WriteVarUInt(origins_.size());
+    for (const auto& origin : origins_)
+    {
+        writer_->WriteString(origin->filename);
+        writer_->WriteUInt32(static_cast<std::uint32_t>(origin->lineOffset));
+    }
+
+    /* Write types of all nodes and type denoters (and the data type of interned base types) */
+    writer_->WriteVarUInt(nodes_.size());
+    for (auto ast : nodes_)
+        writer_->WriteVarUInt(static_cast<std::uint64_t>(ast->Type()));
+
+    writer_->WriteVarUInt(typeDenoters_.size());
+    for (std::size_t i = 0; i < typeDenoters_.size(); ++i)
+    {
+        const auto& typeDenoter = *typeDenoters_[i];
+
+        writer_->WriteVarUInt(static_cast<std::uint64_t>(typeDenoter.Type()));
+        writer_->WriteUInt8(canonicalTypes_[i] ? 1 : 0);
+
+        if (canonicalTypes_[i])
+        {
+            if (auto baseTypeDen = typeDenoter.As<BaseTypeDenoter>())
+                writer_->WriteVarUInt(static_cast<std::uint64_t>(baseTypeDen->dataType));
+        }
+    }
+}
+
+void ASTSerializer::ReadHeader()
+{
+    /* Read tables of strings and source origins */
+    strings_.resize(reader_->ReadVarCount());
+    for (auto& s : strings_)
+        s = reader_->ReadString();
+
+    atoms_.resize(strings_.size(), nullptr);
+
+    origins_.resize(reader_->ReadVarCount());
+    for (auto& origin : origins_)
+    {
+        origin = std::make_shared<SourceOrigin>();
+        origin->filename    = reader_->ReadString();
+        origin->lineOffset  = static_cast<int>(reader_->ReadUInt32());
+    }
+
+    /* Make all nodes and type denoters */
+    const auto numNodes = reader_->ReadVarCount();
+
+    nodes_.reserve(numNodes);
+    nodeOwners_.reserve(numNodes);
+
+    for (std::size_t i = 0; i < numNodes; ++i)
+    {
+        const auto type = reader_->ReadVarUInt();
+        if (type > static_cast<std::uint64_t>(AST::Types::InitializerExpr))
+            throw std::runtime_error("invalid node type in serialized AST");
+
+        auto ast = MakeNode(static_cast<AST::Types>(type));
+        nodes_.push_back(ast.get());
+        nodeOwners_.push_back(std::move(ast));
+    }
+
+    const auto numTypeDenoters = reader_->ReadVarCount();
+
+    typeDenoters_.reserve(numTypeDenoters);
+    canonicalTypes_.reserve(numTypeDenoters);
+
+    for (std::size_t i = 0; i < numTypeDenoters; ++i)
+    {
+        const auto type = reader_->ReadVarUInt();
+        if (type > static_cast<std::uint64_t>(TypeDenoter::Types::Function))
+            throw std::runtime_error("invalid type denoter in serialized AST");
+
+        const bool isCanonical = (reader_->ReadUInt8() != 0);
+
+        typeDenoters_.push_back(MakeTypeDenoter(static_cast<TypeDenoter::Types>(type), isCanonical));
+        canonicalTypes_.push_back(isCanonical);
+    }
+}
+
+#define MAKE_AST(AST_NAME)                              \
+    case AST::Types::AST_NAME:                          \
+        return std::make_shared<AST_NAME>(SourceArea::ignore)
+
+ASTPtr ASTSerializer::MakeNode(AST::Types type)
+{
+    switch (type)
+    {
+        MAKE_AST( Program           );
+        MAKE_AST( CodeBlock         );
+        MAKE_AST( Attribute         );
+        MAKE_AST( SwitchCase        );
+        MAKE_AST( SamplerValue      );
+        MAKE_AST( Register          );
+        MAKE_AST( PackOffset        );
+        MAKE_AST( ArrayDimension    );
+        MAKE_AST( TypeSpecifier     );
+
+        MAKE_AST( VarDecl           );
+        MAKE_AST( BufferDecl        );
+        MAKE_AST( SamplerDecl       );
+        MAKE_AST( StructDecl        );
+        MAKE_AST( AliasDecl         );
+        MAKE_AST( FunctionDecl      );
+        MAKE_AST( UniformBufferDecl );
+
+        MAKE_AST( VarDeclStmnt      );
+        MAKE_AST( BufferDeclStmnt   );
+        MAKE_AST( SamplerDeclStmnt  );
+        MAKE_AST( AliasDeclStmnt    );
+        MAKE_AST( BasicDeclStmnt    );
+
+        MAKE_AST( NullStmnt         );
+        MAKE_AST( CodeBlockStmnt    );
+        MAKE_AST( ForLoopStmnt      );
+        MAKE_AST( WhileLoopStmnt    );
+        MAKE_AST( DoWhileLoopStmnt  );
+        MAKE_AST( IfStmnt           );
+        MAKE_AST( ElseStmnt         );
+        MAKE_AST( SwitchStmnt       );
+        MAKE_AST( ExprStmnt         );
+        MAKE_AST( ReturnStmnt       );
+        MAKE_AST( CtrlTransferStmnt );
+        MAKE_AST( LayoutStmnt       );
+
+        MAKE_AST( NullExpr          );
+        MAKE_AST( SequenceExpr      );
+        MAKE_AST( LiteralExpr       );
+        MAKE_AST( TypeSpecifierExpr );
+        MAKE_AST( TernaryExpr       );
+        MAKE_AST( BinaryExpr        );
+        MAKE_AST( UnaryExpr         );
+        MAKE_AST( PostUnaryExpr     );
+        MAKE_AST( CallExpr          );
+        MAKE_AST( BracketExpr       );
+        MAKE_AST( ObjectExpr        );
+        MAKE_AST( AssignExpr        );
+        MAKE_AST( ArrayExpr         );
+        MAKE_AST( CastExpr          );
+        MAKE_AST( InitializerExpr   );
+    }
+    throw std::runtime_error("invalid node type in serialized AST");
+}
+
+#undef MAKE_AST
+
+TypeDenoterPtr ASTSerializer::MakeTypeDenoter(TypeDenoter::Types type, bool isCanonical)
+{
+    if (isCanonical)
+    {
+        /* Take interned type denoter from the active type context */
+        switch (type)
+        {
+            case TypeDenoter::Types::Void:
+                return TypeContext::MakeVoid();
+
+            case TypeDenoter::Types::Null:
+                return TypeContext::MakeNull();
+
+            case TypeDenoter::Types::Base:
+            {
+                const auto dataType = reader_->ReadVarUInt();
+                if (dataType > static_cast<std::uint64_t>(DataType::Double4x4))
+                    throw std::runtime_error("invalid data type in serialized AST");
+                return TypeContext::MakeBase(static_cast<DataType>(dataType));
+            }
+
+            default:
+                throw std::runtime_error("invalid interned type denoter in serialized AST");
+        }
+    }
+
+    switch (type)
+    {
+        case TypeDenoter::Types::Void:
+            return std::make_shared<VoidTypeDenoter>();
+        case TypeDenoter::Types::Null:
+            return std::make_shared<NullTypeDenoter>();
+        case TypeDenoter::Types::Base:
+            return std::make_shared<BaseTypeDenoter>();
+        case TypeDenoter::Types::Buffer:
+            return std::make_shared<BufferTypeDenoter>();
+        case TypeDenoter::Types::Sampler:
+            return std::make_shared<SamplerTypeDenoter>();
+        case TypeDenoter::Types::Struct:
+            return std::make_shared<StructTypeDenoter>();
+        case TypeDenoter::Types::Alias:
+            return std::make_shared<AliasTypeDenoter>();
+        case TypeDenoter::Types::Array:
+            return std::make_shared<ArrayTypeDenoter>();
+        case TypeDenoter::Types::Function:
+            return std::make_shared<FunctionTypeDenoter>();
+    }
+
+    throw std::runtime_error("invalid type denoter in serialized AST");
+}
+
+std::uint32_t ASTSerializer::RegisterNode(AST* ast)
+{
+    auto result = nodeIndices_.emplace(ast, static_cast<std::uint32_t>(nodes_.size()));
+    if (result.second)
+        nodes_.push_back(ast);
+    return result.first->second;
+}
+
+std::uint32_t ASTSerializer::RegisterTypeDenoter(const TypeDenoterPtr& typeDenoter)
+{
+    auto result = typeDenoterIndices_.emplace(typeDenoter.get(), static_cast<std::uint32_t>(typeDenoters_.size()));
+    if (result.second)
+    {
+        typeDenoters_.push_back(typeDenoter);
+        canonicalTypes_.push_back(TypeContext::FindCanonical(typeDenoter.get()) == typeDenoter);
+    }
+    return result.first->second;
+}
+
+std::uint32_t ASTSerializer::RegisterString(const std::string& s)
+{
+    auto result = stringIndices_.emplace(s, static_cast<std::uint32_t>(strings_.size()));
+    if (result.second)
+        strings_.push_back(s);
+    return result.first->second;
+}
+
+template <typename T>
+T* ASTSerializer::FetchNode(std::uint64_t index) const
+{
+    if (index == 0)
+        return nullptr;
+
+    if (index > nodes_.size())
+        throw std::runtime_error("invalid node index in serialized AST");
+
+    auto ast = nodes_[static_cast<std::size_t>(index - 1)];
+    if (!IsNodeOf<T>(*ast))
+        throw std::runtime_error("unexpected node type in serialized AST");
+
+    return static_cast<T*>(ast);
+}
+
+std::size_t ASTSerializer::FetchStringIndex(std::uint64_t index) const
+{
+    if (index >= strings_.size())
+        throw std::runtime_error("invalid string index in serialized AST");
+    return static_cast<std::size_t>(index);
+}
+
+/* ------- Values ------- */
+
+std::uint64_t ASTSerializer::TransferVarUInt(std::uint64_t value)
+{
+    switch (mode_)
+    {
+        case Modes::Write:
+            writer_->WriteVarUInt(value);
+            break;
+        case Modes::Read:
+            return reader_->ReadVarUInt();
+        default:
+            break;
+    }
+    return value;
+}
+
+std::size_t ASTSerializer::TransferCount(std::size_t count)
+{
+    switch (mode_)
+    {
+        case Modes::Write:
+            writer_->WriteVarUInt(count);
+            break;
+        case Modes::Read:
+            return reader_->ReadVarCount();
+        default:
+            break;
+    }
+    return count;
+}
+
+void ASTSerializer::Transfer(bool& value)
+{
+    value = (TransferVarUInt(value ? 1 : 0) != 0);
+}
+
+void ASTSerializer::Transfer(int& value)
+{
+    auto longValue = static_cast<long long>(value);
+    Transfer(longValue);
+    value = static_cast<int>(longValue);
+}
+
+void ASTSerializer::Transfer(unsigned int& value)
+{
+    value = static_cast<unsigned int>(TransferVarUInt(value));
+}
+
+void ASTSerializer::Transfer(long long& value)
+{
+    /* Map signed integers to unsigned integers with zig-zag encoding, so small negative values take a single byte as well */
+    const auto encoded = ((static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63));
+    const auto decoded = TransferVarUInt(encoded);
+    value = static_cast<long long>((decoded >> 1) ^ (~(decoded & 1) + 1));
+}
+
+void ASTSerializer::Transfer(float& value)
+{
+    std::uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    bits = static_cast<std::uint32_t>(TransferVarUInt(bits));
+    std::memcpy(&value, &bits, sizeof(bits));
+}
+
+void ASTSerializer::Transfer(double& value)
+{
+    std::uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    if (mode_ == Modes::Write)
+        writer_->WriteUInt64(bits);
+    else if (mode_ == Modes::Read)
+    {
+        bits = reader_->ReadUInt64();
+        std::memcpy(&value, &bits, sizeof(bits));
+    }
+}
+
+void ASTSerializer::Transfer(std::string& value)
+{
+    switch (mode_)
+    {
+        case Modes::Enumerate:
+            RegisterString(value);
+            break;
+        case Modes::Write:
+            writer_->WriteVarUInt(stringIndices_.find(value)->second);
+            break;
+        case Modes::Read:
+            value = strings_[FetchStringIndex(reader_->ReadVarUInt())];
+            break;
+    }
+}
+
+void ASTSerializer::TransferAtom(Atom& atom)
+{
+    switch (mode_)
+    {
+        case Modes::Enumerate:
+            if (atom)
+                RegisterString(*atom);
+            break;
+
+        case Modes::Write:
+            writer_->WriteVarUInt(atom ? stringIndices_.find(*atom)->second + 1 : 0);
+            break;
+
+        case Modes::Read:
+        {
+            /* Intern each string only once */
+            const auto index = reader_->ReadVarUInt();
+            if (index > 0)
+            {
+                const auto stringIndex = FetchStringIndex(index - 1);
+                if (!atoms_[stringIndex])
+                    atoms_[stringIndex] = AtomTable::InternActive(strings_[stringIndex]);
+                atom = atoms_[stringIndex];
+            }
+            else
+                atom = nullptr;
+        }
+        break;
+    }
+}
+
+template <typename T>
+void ASTSerializer::TransferEnum(T& value)
+{
+    value = static_cast<T>(TransferVarUInt(static_cast<std::uint64_t>(value)));
+}
+
+template <typename T>
+void ASTSerializer::TransferEnumList(std::vector<T>& values)
+{
+    values.resize(TransferCount(values.size()));
+    for (auto& value : values)
+        TransferEnum(value);
+}
+
+template <typename T>
+void ASTSerializer::TransferEnumSet(std::set<T>& values)
+{
+    std::vector<T> valueList;
+
+    if (mode_ != Modes::Read)
+        valueList.assign(values.begin(), values.end());
+
+    TransferEnumList(valueList);
+
+    if (mode_ == Modes::Read)
+        values = std::set<T>(valueList.begin(), valueList.end());
+}
+
+void ASTSerializer::Transfer(Identifier& ident)
+{
+    /* Transfer the atoms instead of the final identifier, since an identifier may also have no original or an empty renamed identifier */
+    TransferAtom(ident.original_);
+    TransferAtom(ident.renamed_);
+    Transfer(ident.counter_);
+}
+
+void ASTSerializer::Transfer(SourceArea& area)
+{
+    const auto& pos = area.Pos();
+
+    auto row    = pos.Row();
+    auto column = pos.Column();
+    auto length = area.Length();
+    auto offset = area.Offset();
+
+    Transfer(row);
+    Transfer(column);
+    Transfer(length);
+    Transfer(offset);
+
+    switch (mode_)
+    {
+        case Modes::Enumerate:
+            if (auto origin = pos.GetOrigin())
+            {
+                if (originIndices_.emplace(origin, static_cast<std::uint32_t>(origins_.size())).second)
+                    origins_.push_back(pos.GetSharedOrigin());
+            }
+            break;
+
+        case Modes::Write:
+            writer_->WriteVarUInt(pos.GetOrigin() != nullptr ? originIndices_.find(pos.GetOrigin())->second + 1 : 0);
+            break;
+
+        case Modes::Read:
+        {
+            const auto index = reader_->ReadVarUInt();
+            if (index > origins_.size())
+                throw std::runtime_error("invalid source origin in serialized AST");
+
+            area = SourceArea(SourcePosition(row, column, (index > 0 ? origins_[index - 1] : nullptr)), length, offset);
+        }
+        break;
+    }
+}
+
+void ASTSerializer::Transfer(Flags& flags)
+{
+    unsigned int bitMask = flags;
+    Transfer(bitMask);
+    flags = bitMask;
+}
+
+void ASTSerializer::Transfer(IndexedSemantic& semantic)
+{
+    TransferEnum(semantic.semantic_);
+    Transfer(semantic.index_);
+    Transfer(semantic.userDefined_);
+}
+
+void ASTSerializer::Transfer(Variant& value)
+{
+    auto type = value.Type();
+    TransferEnum(type);
+
+    switch (type)
+    {
+        case Variant::Types::Undefined:
+        {
+            if (mode_ == Modes::Read)
+                value = Variant();
+        }
+        break;
+
+        case Variant::Types::Bool:
+        {
+            auto boolValue = value.Bool();
+            Transfer(boolValue);
+            if (mode_ == Modes::Read)
+                value = Variant(boolValue);
+        }
+        break;
+
+        case Variant::Types::Int:
+        {
+            auto intValue = value.Int();
+            Transfer(intValue);
+            if (mode_ == Modes::Read)
+                value = Variant(intValue);
+        }
+        break;
+
+        case Variant::Types::Real:
+        {
+            auto realValue = value.Real();
+            Transfer(realValue);
+            if (mode_ == Modes::Read)
+                value = Variant(realValue);
+        }
+        break;
+
+        case Variant::Types::Array:
+        {
+            auto subValues = value.Array();
+            subValues.resize(TransferCount(subValues.size()));
+
+            for (auto& subValue : subValues)
+                Transfer(subValue);
+
+            if (mode_ == Modes::Read)
+                value = Variant(std::move(subValues));
+        }
+        break;
+
+        default:
+            throw std::runtime_error("invalid variant in serialized AST");
+    }
+}
+
+void ASTSerializer::Transfer(IntrinsicUsage& usage)
+{
+    const auto numArgLists = TransferCount(usage.argLists.size());
+
+    if (mode_ == Modes::Read)
+    {
+        for (std::size_t i = 0; i < numArgLists; ++i)
+        {
+            IntrinsicUsage::ArgumentList argList;
+            TransferEnumList(argList.argTypes);
+            usage.argLists.insert(std::move(argList));
+        }
+    }
+    else
+    {
+        for (const auto& argList : usage.argLists)
+        {
+            auto argTypes = argList.argTypes;
+            TransferEnumList(argTypes);
+        }
+    }
+}
+
+void ASTSerializer::Transfer(MatrixSubscriptUsage& usage)
+{
+    usage.indices.resize(TransferCount(usage.indices.size()));
+
+    for (auto& index : usage.indices)
+    {
+        Transfer(index.first);
+        Transfer(index.second);
+    }
+
+    TransferEnum(usage.dataTypeIn);
+    TransferEnum(usage.dataTypeOut);
+}
+
+/* ------- Nodes and references ------- */
+
+template <typename T>
+void ASTSerializer::TransferNode(std::shared_ptr<T>& ast)
+{
+    switch (mode_)
+    {
+        case Modes::Enumerate:
+            if (ast)
+                RegisterNode(ast.get());
+            break;
+
+        case Modes::Write:
+            writer_->WriteVarUInt(ast ? nodeIndices_.find(ast.get())->second + 1 : 0);
+            break;
+
+        case Modes::Read:
+        {
+            const auto index = reader_->ReadVarUInt();
+            if (FetchNode<T>(index) != nullptr)
+                ast = std::static_pointer_cast<T>(nodeOwners_[static_cast<std::size_t>(index - 1)]);
+            else
+                ast.reset();
+        }
+        break;
+    }
+}
+
+template <typename T>
+void ASTSerializer::TransferNodes(std::vector<std::shared_ptr<T>>& astList)
+{
+    astList.resize(TransferCount(astList.size()));
+    for (auto& ast : astList)
+        TransferNode(ast);
+}
+
+template <typename T>
+void ASTSerializer::TransferRef(T*& ref)
+{
+    switch (mode_)
+    {
+        case Modes::Enumerate:
+            break;
+
+        case Modes::Write:
+        {
+            if (ref)
+            {
+                /* References to nodes that are not owned by the program can not be restored */
+                auto it = nodeIndices_.find(ref);
+                if (it == nodeIndices_.end())
+                    throw std::runtime_error("reference to a node that is not part of the program");
+                writer_->WriteVarUInt(it->second + 1);
+            }
+            else
+                writer_->WriteVarUInt(0);
+        }
+        break;
+
+        case Modes::Read:
+            ref = FetchNode<T>(reader_->ReadVarUInt());
+            break;
+    }
+}
+
+template <typename T>
+void ASTSerializer::TransferRefs(std::vector<T*>& refs)
+{
+    refs.resize(TransferCount(refs.size()));
+    for (auto& ref : refs)
+        TransferRef(ref);
+}
+
+template <typename T>
+void ASTSerializer::TransferRefSet(std::set<T*>& refs)
+{
+    std::vector<T*> refList;
+
+    if (mode_ != Modes::Read)
+        refList.assign(refs.begin(), refs.end());
+
+    TransferRefs(refList);
+
+    if (mode_ == Modes::Read)
+        refs = std::set<T*>(refList.begin(), refList.end());
+}
+
+template <typename T>
+void ASTSerializer::TransferTypeDenoter(std::shared_ptr<T>& typeDenoter)
+{
+    switch (mode_)
+    {
+        case Modes::Enumerate:
+            if (typeDenoter)
+                RegisterTypeDenoter(typeDenoter);
+            break;
+
+        case Modes::Write:
+            writer_->WriteVarUInt(typeDenoter ? typeDenoterIndices_.find(typeDenoter.get())->second + 1 : 0);
+            break;
+
+        case Modes::Read:
+        {
+            const auto index = reader_->ReadVarUInt();
+            if (index > typeDenoters_.size())
+                throw std::runtime_error("invalid type denoter index in serialized AST");
+
+            if (index > 0)
+            {
+                const auto& typeDenoterEntry = typeDenoters_[static_cast<std::size_t>(index - 1)];
+                if (!IsTypeDenoterOf<T>(*typeDenoterEntry))
+                    throw std::runtime_error("unexpected type denoter in serialized AST");
+                typeDenoter = std::static_pointer_cast<T>(typeDenoterEntry);
+            }
+            else
+                typeDenoter.reset();
+        }
+        break;
+    }
+}
+
+/* ------- Members of type denoters ------- */
+
+void ASTSerializer::TransferMembers(TypeDenoter& typeDenoter)
+{
+    switch (typeDenoter.Type())
+    {
+        case TypeDenoter::Types::Base:
+        {
+            auto& baseTypeDen = static_cast<BaseTypeDenoter&>(typeDenoter);
+            TransferEnum(baseTypeDen.dataType);
+
+            #ifdef XSC_ENABLE_LANGUAGE_EXT
+
+            std::string srcSpace { baseTypeDen.vectorSpace.src.begin(), baseTypeDen.vectorSpace.src.end() };
+            std::string dstSpace { baseTypeDen.vectorSpace.dst.begin(), baseTypeDen.vectorSpace.dst.end() };
+
+            Transfer(srcSpace);
+            Transfer(dstSpace);
+
+            if (mode_ == Modes::Read)
+                baseTypeDen.vectorSpace.Set(ToCiString(srcSpace), ToCiString(dstSpace));
+
+            #endif // /XSC_ENABLE_LANGUAGE_EXT
+        }
+        break;
+
+        case TypeDenoter::Types::Buffer:
+        {
+            auto& bufferTypeDen = static_cast<BufferTypeDenoter&>(typeDenoter);
+            TransferEnum(bufferTypeDen.bufferType);
+            TransferTypeDenoter(bufferTypeDen.genericTypeDenoter);
+            Transfer(bufferTypeDen.genericSize);
+            TransferRef(bufferTypeDen.bufferDeclRef);
+
+            #ifdef XSC_ENABLE_LANGUAGE_EXT
+            TransferEnum(bufferTypeDen.layoutFormat);
+            #endif
+        }
+        break;
+
+        case TypeDenoter::Types::Sampler:
+        {
+            auto& samplerTypeDen = static_cast<SamplerTypeDenoter&>(typeDenoter);
+            TransferEnum(samplerTypeDen.samplerType);
+            TransferRef(samplerTypeDen.samplerDeclRef);
+        }
+        break;
+
+        case TypeDenoter::Types::Struct:
+        {
+            auto& structTypeDen = static_cast<StructTypeDenoter&>(typeDenoter);
+            Transfer(structTypeDen.ident);
+            TransferRef(structTypeDen.structDeclRef);
+        }
+        break;
+
+        case TypeDenoter::Types::Alias:
+        {
+            auto& aliasTypeDen = static_cast<AliasTypeDenoter&>(typeDenoter);
+            Transfer(aliasTypeDen.ident);
+            TransferRef(aliasTypeDen.aliasDeclRef);
+        }
+        break;
+
+        case TypeDenoter::Types::Array:
+        {
+            auto& arrayTypeDen = static_cast<ArrayTypeDenoter&>(typeDenoter);
+            TransferTypeDenoter(arrayTypeDen.subTypeDenoter);
+            TransferNodes(arrayTypeDen.arrayDims);
+        }
+        break;
+
+        case TypeDenoter::Types::Function:
+        {
+            auto& funcTypeDen = static_cast<FunctionTypeDenoter&>(typeDenoter);
+            Transfer(funcTypeDen.ident);
+            TransferRefs(funcTypeDen.funcDeclRefs);
+        }
+        break;
+
+        default:
+            break;
+    }
+}
+
+/* ------- Members of common AST nodes ------- */
+
+#define TRANSFER_AST(AST_NAME)                              \
+    case AST::Types::AST_NAME:                              \
+        TransferMembers(static_cast<AST_NAME&>(ast));       \
+        break
+
+void ASTSerializer::TransferAST(AST& ast)
+{
+    switch (ast.Type())
+    {
+        TRANSFER_AST( Program           );
+        TRANSFER_AST( CodeBlock         );
+        TRANSFER_AST( Attribute         );
+        TRANSFER_AST( SwitchCase        );
+        TRANSFER_AST( SamplerValue      );
+        TRANSFER_AST( Register          );
+        TRANSFER_AST( PackOffset        );
+        TRANSFER_AST( ArrayDimension    );
+        TRANSFER_AST( TypeSpecifier     );
+
+        TRANSFER_AST( VarDecl           );
+        TRANSFER_AST( BufferDecl        );
+        TRANSFER_AST( SamplerDecl       );
+        TRANSFER_AST( StructDecl        );
+        TRANSFER_AST( AliasDecl         );
+        TRANSFER_AST( FunctionDecl      );
+        TRANSFER_AST( UniformBufferDecl );
+
+        TRANSFER_AST( VarDeclStmnt      );
+        TRANSFER_AST( BufferDeclStmnt   );
+        TRANSFER_AST( SamplerDeclStmnt  );
+        TRANSFER_AST( AliasDeclStmnt    );
+        TRANSFER_AST( BasicDeclStmnt    );
+
+        TRANSFER_AST( NullStmnt         );
+        TRANSFER_AST( CodeBlockStmnt    );
+        TRANSFER_AST( ForLoopStmnt      );
+        TRANSFER_AST( WhileLoopStmnt    );
+        TRANSFER_AST( DoWhileLoopStmnt  );
+        TRANSFER_AST( IfStmnt           );
+        TRANSFER_AST( ElseStmnt         );
+        TRANSFER_AST( SwitchStmnt       );
+        TRANSFER_AST( ExprStmnt         );
+        TRANSFER_AST( ReturnStmnt       );
+        TRANSFER_AST( CtrlTransferStmnt );
+        TRANSFER_AST( LayoutStmnt       );
+
+        TRANSFER_AST( NullExpr          );
+        TRANSFER_AST( SequenceExpr      );
+        TRANSFER_AST( LiteralExpr       );
+        TRANSFER_AST( TypeSpecifierExpr );
+        TRANSFER_AST( TernaryExpr       );
+        TRANSFER_AST( BinaryExpr        );
+        TRANSFER_AST( UnaryExpr         );
+        TRANSFER_AST( PostUnaryExpr     );
+        TRANSFER_AST( CallExpr          );
+        TRANSFER_AST( BracketExpr       );
+        TRANSFER_AST( ObjectExpr        );
+        TRANSFER_AST( AssignExpr        );
+        TRANSFER_AST( ArrayExpr         );
+        TRANSFER_AST( CastExpr          );
+        TRANSFER_AST( InitializerExpr   );
+    }
+}
+
+#undef TRANSFER_AST
+
+void ASTSerializer::TransferMembers(AST& ast)
+{
+    Transfer(ast.area);
+    Transfer(ast.flags);
+}
+
+void ASTSerializer::TransferMembers(Stmnt& ast)
+{
+    TransferMembers(static_cast<AST&>(ast));
+    Transfer(ast.comment);
+    TransferNodes(ast.attribs);
+}
+
+void ASTSerializer::TransferMembers(TypedAST& ast)
+{
+    TransferMembers(static_cast<AST&>(ast));
+    TransferTypeDenoter(ast.bufferedTypeDenoter_);
+}
+
+void ASTSerializer::TransferMembers(Decl& ast)
+{
+    TransferMembers(static_cast<TypedAST&>(ast));
+    Transfer(ast.ident);
+}
+
+void ASTSerializer::TransferMembers(Program& ast)
+{
+    TransferMembers(static_cast<AST&>(ast));
+    TransferNodes(ast.globalStmnts);
+    TransferNodes(ast.disabledAST);
+    TransferRef(ast.entryPointRef);
+
+    /* Transfer used intrinsics and matrix subscripts */
+    const auto numIntrinsics = TransferCount(ast.usedIntrinsics.size());
+
+    if (mode_ == Modes::Read)
+    {
+        for (std::size_t i = 0; i < numIntrinsics; ++i)
+        {
+            auto intrinsic = Intrinsic::Undefined;
+            TransferEnum(intrinsic);
+            Transfer(ast.usedIntrinsics[intrinsic]);
+        }
+    }
+    else
+    {
+        for (auto& it : ast.usedIntrinsics)
+        {
+            auto intrinsic = it.first;
+            TransferEnum(intrinsic);
+            Transfer(it.second);
+        }
+    }
+
+    const auto numMatrixSubscripts = TransferCount(ast.usedMatrixSubscripts.size());
+
+    if (mode_ == Modes::Read)
+    {
+        for (std::size_t i = 0; i < numMatrixSubscripts; ++i)
+        {
+            MatrixSubscriptUsage usage;
+            Transfer(usage);
+            ast.usedMatrixSubscripts.insert(std::move(usage));
+        }
+    }
+    else
+    {
+        for (const auto& usage : ast.usedMatrixSubscripts)
+        {
+            auto usageCopy = usage;
+            Transfer(usageCopy);
+        }
+    }
+
+    /* Transfer program layouts */
+    Transfer(ast.layoutTessControl.outputControlPoints);
+    Transfer(ast.layoutTessControl.maxTessFactor);
+    TransferRef(ast.layoutTessControl.patchConstFunctionRef);
+
+    TransferEnum(ast.layoutTessEvaluation.domainType);
+    TransferEnum(ast.layoutTessEvaluation.partitioning);
+    TransferEnum(ast.layoutTessEvaluation.outputTopology);
+
+    TransferEnum(ast.layoutGeometry.inputPrimitive);
+    TransferEnum(ast.layoutGeometry.outputPrimitive);
+    Transfer(ast.layoutGeometry.maxVertices);
+
+    Transfer(ast.layoutFragment.fragCoordUsed);
+    Transfer(ast.layoutFragment.pixelCenterInteger);
+    Transfer(ast.layoutFragment.earlyDepthStencil);
+
+    for (auto& numThreads : ast.layoutCompute.numThreads)
+        Transfer(numThreads);
+}
+
+void ASTSerializer::TransferMembers(CodeBlock& ast)
+{
+    TransferMembers(static_cast<AST&>(ast));
+    TransferNodes(ast.stmnts);
+}
+
+void ASTSerializer::TransferMembers(SamplerValue& ast)
+{
+    TransferMembers(static_cast<AST&>(ast));
+    Transfer(ast.name);
+    TransferNode(ast.value);
+}
+
+void ASTSerializer::TransferMembers(Attribute& ast)
+{
+    TransferMembers(static_cast<AST&>(ast));
+    TransferEnum(ast.attributeType);
+    TransferNodes(ast.arguments);
+}
+
+void ASTSerializer::TransferMembers(SwitchCase& ast)
+{
+    TransferMembers(static_cast<AST&>(ast));
+    TransferNode(ast.expr);
+    TransferNodes(ast.stmnts);
+}
+
+void ASTSerializer::TransferMembers(Register& ast)
+{
+    TransferMembers(static_cast<AST&>(ast));
+    TransferEnum(ast.shaderTarget);
+    TransferEnum(ast.registerType);
+    Transfer(ast.slot);
+}
+
+void ASTSerializer::TransferMembers(PackOffset& ast)
+{
+    TransferMembers(static_cast<AST&>(ast));
+    Transfer(ast.registerName);
+    Transfer(ast.vectorComponent);
+}
+
+void ASTSerializer::TransferMembers(ArrayDimension& ast)
+{
+    TransferMembers(static_cast<TypedAST&>(ast));
+    TransferNode(ast.expr);
+    Transfer(ast.size);
+}
+
+void ASTSerializer::TransferMembers(TypeSpecifier& ast)
+{
+    TransferMembers(static_cast<TypedAST&>(ast));
+    Transfer(ast.isInput);
+    Transfer(ast.isOutput);
+    Transfer(ast.isUniform);
+    TransferEnumSet(ast.storageClasses);
+    TransferEnumSet(ast.interpModifiers);
+    TransferEnumSet(ast.typeModifiers);
+    TransferEnum(ast.primitiveType);
+    TransferNode(ast.structDecl);
+    TransferTypeDenoter(ast.typeDenoter);
+}
+
+/* ------- Members of declaration objects ------- */
+
+void ASTSerializer::TransferMembers(VarDecl& ast)
+{
+    TransferMembers(static_cast<Decl&>(ast));
+    TransferNode(ast.namespaceExpr);
+    TransferNodes(ast.arrayDims);
+    TransferNodes(ast.slotRegisters);
+    Transfer(ast.semantic);
+    TransferNode(ast.packOffset);
+    TransferNodes(ast.annotations);
+    TransferNode(ast.initializer);
+    TransferTypeDenoter(ast.customTypeDenoter);
+    Transfer(ast.initializerValue);
+    TransferRef(ast.declStmntRef);
+    TransferRef(ast.bufferDeclRef);
+    TransferRef(ast.structDeclRef);
+    TransferRef(ast.staticMemberVarRef);
+}
+
+void ASTSerializer::TransferMembers(BufferDecl& ast)
+{
+    TransferMembers(static_cast<Decl&>(ast));
+    TransferNodes(ast.arrayDims);
+    TransferNodes(ast.slotRegisters);
+    TransferNodes(ast.annotations);
+    TransferRef(ast.declStmntRef);
+}
+
+void ASTSerializer::TransferMembers(SamplerDecl& ast)
+{
+    TransferMembers(static_cast<Decl&>(ast));
+    TransferNodes(ast.arrayDims);
+    TransferNodes(ast.slotRegisters);
+    Transfer(ast.textureIdent);
+    TransferNodes(ast.samplerValues);
+    TransferRef(ast.declStmntRef);
+}
+
+void ASTSerializer::TransferMembers(StructDecl& ast)
+{
+    TransferMembers(static_cast<Decl&>(ast));
+    Transfer(ast.isClass);
+    Transfer(ast.baseStructName);
+    TransferNodes(ast.localStmnts);
+    TransferNodes(ast.varMembers);
+    TransferNodes(ast.funcMembers);
+    TransferRef(ast.declStmntRef);
+    TransferRef(ast.baseStructRef);
+    TransferRef(ast.compatibleStructRef);
+
+    const auto numSystemValues = TransferCount(ast.systemValuesRef.size());
+
+    if (mode_ == Modes::Read)
+    {
+        for (std::size_t i = 0; i < numSystemValues; ++i)
+        {
+            std::string ident;
+            Transfer(ident);
+            TransferRef(ast.systemValuesRef[ident]);
+        }
+    }
+    else
+    {
+        for (auto& it : ast.systemValuesRef)
+        {
+            auto ident = it.first;
+            Transfer(ident);
+            TransferRef(it.second);
+        }
+    }
+
+    TransferRefSet(ast.parentStructDeclRefs);
+    TransferRefSet(ast.shaderOutputVarDeclRefs);
+}
+
+void ASTSerializer::TransferMembers(AliasDecl& ast)
+{
+    TransferMembers(static_cast<Decl&>(ast));
+    TransferTypeDenoter(ast.typeDenoter);
+    TransferRef(ast.declStmntRef);
+}
+
+void ASTSerializer::TransferMembers(FunctionDecl& ast)
+{
+    TransferMembers(static_cast<Decl&>(ast));
+    TransferNode(ast.returnType);
+    TransferNodes(ast.parameters);
+    Transfer(ast.semantic);
+    TransferNodes(ast.annotations);
+    TransferNode(ast.codeBlock);
+    TransferRefs(ast.inputSemantics.varDeclRefs);
+    TransferRefs(ast.inputSemantics.varDeclRefsSV);
+    TransferRefs(ast.outputSemantics.varDeclRefs);
+    TransferRefs(ast.outputSemantics.varDeclRefsSV);
+    TransferRef(ast.declStmntRef);
+    TransferRef(ast.funcImplRef);
+    TransferRefs(ast.funcForwardDeclRefs);
+    TransferRef(ast.structDeclRef);
+
+    ast.paramStructs.resize(TransferCount(ast.paramStructs.size()));
+
+    for (auto& paramStruct : ast.paramStructs)
+    {
+        TransferRef(paramStruct.expr);
+        TransferRef(paramStruct.varDecl);
+        TransferRef(paramStruct.structDecl);
+    }
+}
+
+void ASTSerializer::TransferMembers(UniformBufferDecl& ast)
+{
+    TransferMembers(static_cast<Decl&>(ast));
+    TransferEnum(ast.bufferType);
+    TransferNodes(ast.slotRegisters);
+    TransferNodes(ast.localStmnts);
+    TransferNodes(ast.varMembers);
+    TransferEnum(ast.commonStorageLayout);
+    TransferRef(ast.declStmntRef);
+}
+
+/* ------- Members of declaration statements ------- */
+
+void ASTSerializer::TransferMembers(BufferDeclStmnt& ast)
+{
+    TransferMembers(static_cast<Stmnt&>(ast));
+    TransferTypeDenoter(ast.typeDenoter);
+    TransferNodes(ast.bufferDecls);
+}
+
+void ASTSerializer::TransferMembers(SamplerDeclStmnt& ast)
+{
+    TransferMembers(static_cast<Stmnt&>(ast));
+    TransferTypeDenoter(ast.typeDenoter);
+    TransferNodes(ast.samplerDecls);
+}
+
+void ASTSerializer::TransferMembers(BasicDeclStmnt& ast)
+{
+    TransferMembers(static_cast<Stmnt&>(ast));
+    TransferNode(ast.declObject);
+}
+
+void ASTSerializer::TransferMembers(VarDeclStmnt& ast)
+{
+    TransferMembers(static_cast<Stmnt&>(ast));
+    TransferNode(ast.typeSpecifier);
+    TransferNodes(ast.varDecls);
+}
+
+void ASTSerializer::TransferMembers(AliasDeclStmnt& ast)
+{
+    TransferMembers(static_cast<Stmnt&>(ast));
+    TransferNode(ast.structDecl);
+    TransferNodes(ast.aliasDecls);
+}
+
+/* ------- Members of common statements ------- */
+
+void ASTSerializer::TransferMembers(NullStmnt& ast)
+{
+    TransferMembers(static_cast<Stmnt&>(ast));
+}
+
+void ASTSerializer::TransferMembers(CodeBlockStmnt& ast)
+{
+    TransferMembers(static_cast<Stmnt&>(ast));
+    TransferNode(ast.codeBlock);
+}
+
+void ASTSerializer::TransferMembers(ForLoopStmnt& ast)
+{
+    TransferMembers(static_cast<Stmnt&>(ast));
+    TransferNode(ast.initStmnt);
+    TransferNode(ast.condition);
+    TransferNode(ast.iteration);
+    TransferNode(ast.bodyStmnt);
+}
+
+void ASTSerializer::TransferMembers(WhileLoopStmnt& ast)
+{
+    TransferMembers(static_cast<Stmnt&>(ast));
+    TransferNode(ast.condition);
+    TransferNode(ast.bodyStmnt);
+}
+
+void ASTSerializer::TransferMembers(DoWhileLoopStmnt& ast)
+{
+    TransferMembers(static_cast<Stmnt&>(ast));
+    TransferNode(ast.bodyStmnt);
+    TransferNode(ast.condition);
+}
+
+void ASTSerializer::TransferMembers(IfStmnt& ast)
+{
+    TransferMembers(static_cast<Stmnt&>(ast));
+    TransferNode(ast.condition);
+    TransferNode(ast.bodyStmnt);
+    TransferNode(ast.elseStmnt);
+}
+
+void ASTSerializer::TransferMembers(ElseStmnt& ast)
+{
+    TransferMembers(static_cast<Stmnt&>(ast));
+    TransferNode(ast.bodyStmnt);
+}
+
+void ASTSerializer::TransferMembers(SwitchStmnt& ast)
+{
+    TransferMembers(static_cast<Stmnt&>(ast));
+    TransferNode(ast.selector);
+    TransferNodes(ast.cases);
+}
+
+void ASTSerializer::TransferMembers(ExprStmnt& ast)
+{
+    TransferMembers(static_cast<Stmnt&>(ast));
+    TransferNode(ast.expr);
+}
+
+void ASTSerializer::TransferMembers(ReturnStmnt& ast)
+{
+    TransferMembers(static_cast<Stmnt&>(ast));
+    TransferNode(ast.expr);
+}
+
+void ASTSerializer::TransferMembers(CtrlTransferStmnt& ast)
+{
+    TransferMembers(static_cast<Stmnt&>(ast));
+    TransferEnum(ast.transfer);
+}
+
+void ASTSerializer::TransferMembers(LayoutStmnt& ast)
+{
+    TransferMembers(static_cast<Stmnt&>(ast));
+    Transfer(ast.isInput);
+    Transfer(ast.isOutput);
+}
+
+/* ------- Members of expressions ------- */
+
+void ASTSerializer::TransferMembers(NullExpr& ast)
+{
+    TransferMembers(static_cast<TypedAST&>(ast));
+}
+
+void ASTSerializer::TransferMembers(SequenceExpr& ast)
+{
+    TransferMembers(static_cast<TypedAST&>(ast));
+    TransferNodes(ast.exprs);
+}
+
+void ASTSerializer::TransferMembers(LiteralExpr& ast)
+{
+    TransferMembers(static_cast<TypedAST&>(ast));
+    Transfer(ast.value);
+    TransferEnum(ast.dataType);
+}
+
+void ASTSerializer::TransferMembers(TypeSpecifierExpr& ast)
+{
+    TransferMembers(static_cast<TypedAST&>(ast));
+    TransferNode(ast.typeSpecifier);
+}
+
+void ASTSerializer::TransferMembers(TernaryExpr& ast)
+{
+    TransferMembers(static_cast<TypedAST&>(ast));
+    TransferNode(ast.condExpr);
+    TransferNode(ast.thenExpr);
+    TransferNode(ast.elseExpr);
+}
+
+void ASTSerializer::TransferMembers(BinaryExpr& ast)
+{
+    TransferMembers(static_cast<TypedAST&>(ast));
+    TransferNode(ast.lhsExpr);
+    TransferEnum(ast.op);
+    TransferNode(ast.rhsExpr);
+}
+
+void ASTSerializer::TransferMembers(UnaryExpr& ast)
+{
+    TransferMembers(static_cast<TypedAST&>(ast));
+    TransferEnum(ast.op);
+    TransferNode(ast.expr);
+}
+
+void ASTSerializer::TransferMembers(PostUnaryExpr& ast)
+{
+    TransferMembers(static_cast<TypedAST&>(ast));
+    TransferNode(ast.expr);
+    TransferEnum(ast.op);
+}
+
+void ASTSerializer::TransferMembers(CallExpr& ast)
+{
+    TransferMembers(static_cast<TypedAST&>(ast));
+    TransferNode(ast.prefixExpr);
+    Transfer(ast.isStatic);
+    Transfer(ast.ident);
+    TransferTypeDenoter(ast.typeDenoter);
+    TransferNodes(ast.arguments);
+    TransferRef(ast.funcDeclRef);
+    TransferEnum(ast.intrinsic);
+    TransferRefs(ast.defaultParamRefs);
+}
+
+void ASTSerializer::TransferMembers(BracketExpr& ast)
+{
+    TransferMembers(static_cast<TypedAST&>(ast));
+    TransferNode(ast.expr);
+}
+
+void ASTSerializer::TransferMembers(AssignExpr& ast)
+{
+    TransferMembers(static_cast<TypedAST&>(ast));
+    TransferNode(ast.lvalueExpr);
+    TransferEnum(ast.op);
+    TransferNode(ast.rvalueExpr);
+}
+
+void ASTSerializer::TransferMembers(ObjectExpr& ast)
+{
+    TransferMembers(static_cast<TypedAST&>(ast));
+    TransferNode(ast.prefixExpr);
+    Transfer(ast.isStatic);
+    Transfer(ast.ident);
+    TransferRef(ast.symbolRef);
+}
+
+void ASTSerializer::TransferMembers(ArrayExpr& ast)
+{
+    TransferMembers(static_cast<TypedAST&>(ast));
+    TransferNode(ast.prefixExpr);
+    TransferNodes(ast.arrayIndices);
+}
+
+void ASTSerializer::TransferMembers(CastExpr& ast)
+{
+    TransferMembers(static_cast<TypedAST&>(ast));
+    TransferNode(ast.typeSpecifier);
+    TransferNode(ast.expr);
+}
+
+void ASTSerializer::TransferMembers(InitializerExpr& ast)
+{
+    TransferMembers(static_cast<TypedAST&>(ast));
+    TransferNodes(ast.exprs);
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
\ No newline at end of file
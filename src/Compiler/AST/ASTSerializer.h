@@ -0,0 +1,233 @@
+/*
+ * ASTSerializer.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_AST_SERIALIZER_H
+#define XSC_AST_SERIALIZER_H
+
+
+#include "AST.h"
+#include "SnapshotStream.h"
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <set>
+#include <memory>
+#include <cstdint>
+
+
+namespace Xsc
+{
+
+
+/*
+Binary serialization of an entire program (decorated or not), to skip the front-end for a program that has already been analyzed (see ProgramSnapshot).
+All AST nodes and all type denoters are stored in two tables, so the shared ownership of nodes and all references between nodes are preserved.
+The members of each node class are enumerated only once (see TransferMembers), and this enumeration is used to collect the tables,
+to write the nodes, and to read them back. When a program is read, its identifiers are interned
+in the active atom table, and interned type denoters are taken from the active type context. The source areas of all nodes are preserved,
+but the source code itself is not part of the serialized program.
+When a member is added to or removed from a node class, its TransferMembers function must be updated and the snapshot format version
+must be increased (see ProgramSnapshot.cpp). The presets with "--snapshot-check" in test/presetting.txt detect members that are not transferred.
+*/
+class ASTSerializer
+{
+
+    public:
+
+        // Writes the specified program with all its nodes and type denoters to the specified writer.
+        void WriteProgram(const Program& program, SnapshotWriter& writer);
+
+        // Reads a program from the specified reader, or throws an std::runtime_error if the serialized program is corrupted.
+        ProgramPtr ReadProgram(SnapshotReader& reader);
+
+    private:
+
+        enum class Modes
+        {
+            Enumerate,  // Collect all nodes, type denoters, strings, and source origins.
+            Write,      // Write all members to 'writer_'.
+            Read,       // Read all members from 'reader_'.
+        };
+
+        /* === Functions === */
+
+        void Clear();
+
+        // Transfers the members of all nodes and type denoters in the order of the tables.
+        void TransferTables();
+
+        void WriteHeader();
+        void ReadHeader();
+
+        ASTPtr MakeNode(AST::Types type);
+        TypeDenoterPtr MakeTypeDenoter(TypeDenoter::Types type, bool isCanonical);
+
+        std::uint32_t RegisterNode(AST* ast);
+        std::uint32_t RegisterTypeDenoter(const TypeDenoterPtr& typeDenoter);
+        std::uint32_t RegisterString(const std::string& s);
+
+        // Returns the node of the specified one-based index (zero for null), or throws an std::runtime_error if the node has another type.
+        template <typename T>
+        T* FetchNode(std::uint64_t index) const;
+
+        // Returns the specified index into the string table, or throws an std::runtime_error if the index is out of range.
+        std::size_t FetchStringIndex(std::uint64_t index) const;
+
+        /* ----- Values ----- */
+
+        // Writes or reads the specified value, and returns the value as it was written or read.
+        std::uint64_t TransferVarUInt(std::uint64_t value);
+
+        void Transfer(bool& value);
+        void Transfer(int& value);
+        void Transfer(unsigned int& value);
+        void Transfer(long long& value);
+        void Transfer(float& value);
+        void Transfer(double& value);
+        void Transfer(std::string& value);
+
+        // Transfers an optional atom (null atoms are preserved).
+        void TransferAtom(Atom& atom);
+
+        template <typename T>
+        void TransferEnum(T& value);
+
+        template <typename T>
+        void TransferEnumList(std::vector<T>& values);
+
+        template <typename T>
+        void TransferEnumSet(std::set<T>& values);
+
+        void Transfer(Identifier& ident);
+        void Transfer(SourceArea& area);
+        void Transfer(Flags& flags);
+        void Transfer(IndexedSemantic& semantic);
+        void Transfer(Variant& value);
+        void Transfer(IntrinsicUsage& usage);
+        void Transfer(MatrixSubscriptUsage& usage);
+
+        /* ----- Nodes and references ----- */
+
+        // Transfers an owned node (see TransferMembers).
+        template <typename T>
+        void TransferNode(std::shared_ptr<T>& ast);
+
+        template <typename T>
+        void TransferNodes(std::vector<std::shared_ptr<T>>& astList);
+
+        // Transfers a reference to a node of the program (e.g. 'ObjectExpr::symbolRef').
+        template <typename T>
+        void TransferRef(T*& ref);
+
+        template <typename T>
+        void TransferRefs(std::vector<T*>& refs);
+
+        template <typename T>
+        void TransferRefSet(std::set<T*>& refs);
+
+        template <typename T>
+        void TransferTypeDenoter(std::shared_ptr<T>& typeDenoter);
+
+        // Returns the number of elements of a list that is written or read.
+        std::size_t TransferCount(std::size_t count);
+
+        /* ----- Members ----- */
+
+        void TransferAST(AST& ast);
+        void TransferMembers(TypeDenoter& typeDenoter);
+
+        void TransferMembers(AST&               ast);
+        void TransferMembers(Stmnt&             ast);
+        void TransferMembers(TypedAST&          ast);
+        void TransferMembers(Decl&              ast);
+        void TransferMembers(Program&           ast);
+        void TransferMembers(CodeBlock&         ast);
+        void TransferMembers(SamplerValue&      ast);
+        void TransferMembers(Attribute&         ast);
+        void TransferMembers(SwitchCase&        ast);
+        void TransferMembers(Register&          ast);
+        void TransferMembers(PackOffset&        ast);
+        void TransferMembers(ArrayDimension&    ast);
+        void TransferMembers(TypeSpecifier&     ast);
+        void TransferMembers(VarDecl&           ast);
+        void TransferMembers(BufferDecl&        ast);
+        void TransferMembers(SamplerDecl&       ast);
+        void TransferMembers(StructDecl&        ast);
+        void TransferMembers(AliasDecl&         ast);
+        void TransferMembers(FunctionDecl&      ast);
+        void TransferMembers(UniformBufferDecl& ast);
+        void TransferMembers(BufferDeclStmnt&   ast);
+        void TransferMembers(SamplerDeclStmnt&  ast);
+        void TransferMembers(BasicDeclStmnt&    ast);
+        void TransferMembers(VarDeclStmnt&      ast);
+        void TransferMembers(AliasDeclStmnt&    ast);
+        void TransferMembers(NullStmnt&         ast);
+        void TransferMembers(CodeBlockStmnt&    ast);
+        void TransferMembers(ForLoopStmnt&      ast);
+        void TransferMembers(WhileLoopStmnt&    ast);
+        void TransferMembers(DoWhileLoopStmnt&  ast);
+        void TransferMembers(IfStmnt&           ast);
+        void TransferMembers(ElseStmnt&         ast);
+        void TransferMembers(SwitchStmnt&       ast);
+        void TransferMembers(ExprStmnt&         ast);
+        void TransferMembers(ReturnStmnt&       ast);
+        void TransferMembers(CtrlTransferStmnt& ast);
+        void TransferMembers(LayoutStmnt&       ast);
+        void TransferMembers(NullExpr&          ast);
+        void TransferMembers(SequenceExpr&      ast);
+        void TransferMembers(LiteralExpr&       ast);
+        void TransferMembers(TypeSpecifierExpr& ast);
+        void TransferMembers(TernaryExpr&       ast);
+        void TransferMembers(BinaryExpr&        ast);
+        void TransferMembers(UnaryExpr&         ast);
+        void TransferMembers(PostUnaryExpr&     ast);
+        void TransferMembers(CallExpr&          ast);
+        void TransferMembers(BracketExpr&       ast);
+        void TransferMembers(AssignExpr&        ast);
+        void TransferMembers(ObjectExpr&        ast);
+        void TransferMembers(ArrayExpr&         ast);
+        void TransferMembers(CastExpr&          ast);
+        void TransferMembers(InitializerExpr&   ast);
+
+        /* === Members === */
+
+        template <typename T>
+        using IndexMap = std::unordered_map<const T*, std::uint32_t>;
+
+        Modes                                       mode_               = Modes::Enumerate;
+
+        SnapshotWriter*                             writer_             = nullptr;
+        SnapshotReader*                             reader_             = nullptr;
+
+        // Tables of all nodes and type denoters; the program is always the first node.
+        std::vector<AST*>                           nodes_;
+        std::vector<ASTPtr>                         nodeOwners_;        // Only used for reading.
+        std::vector<TypeDenoterPtr>                 typeDenoters_;
+        std::vector<bool>                           canonicalTypes_;    // Type denoters that are interned in the type context.
+
+        IndexMap<AST>                               nodeIndices_;
+        IndexMap<TypeDenoter>                       typeDenoterIndices_;
+
+        // Tables of all strings (identifiers, literals, etc.) and source origins.
+        std::vector<std::string>                    strings_;
+        std::vector<Atom>                           atoms_;             // Atoms of the strings that are interned on demand.
+        std::unordered_map<std::string, std::uint32_t> stringIndices_;
+
+        std::vector<SourceOriginPtr>                origins_;
+        IndexMap<SourceOrigin>                      originIndices_;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
\ No newline at end of file
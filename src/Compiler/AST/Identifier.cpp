@@ -15,24 +15,14 @@ namespace Xsc
 
 Identifier& Identifier::operator = (const Identifier& rhs)
 {
-    *this = rhs.Final();
+    /* Take atom of the other identifier, which is already interned */
+    Assign(rhs.FinalAtom());
     return *this;
 }
 
 Identifier& Identifier::operator = (const std::string& s)
 {
-    if (!originalSet_)
-    {
-        /* Set original identifier for the first time */
-        originalSet_ = true;
-        original_ = s;
-    }
-    else
-    {
-        /* Set renamed identifier */
-        renamedSet_ = true;
-        renamed_ = s;
-    }
+    Assign(AtomTable::InternActive(s));
     return *this;
 }
 
@@ -67,9 +57,23 @@ Identifier& Identifier::RemovePrefix(const std::string& prefix)
     return *this;
 }
 
-const std::string& Identifier::Final() const
+
+/*
+ * ======= Private: =======
+ */
+
+void Identifier::Assign(Atom atom)
 {
-    return (renamedSet_ ? renamed_ : original_);
+    if (original_ == nullptr)
+    {
+        /* Set original identifier for the first time */
+        original_ = atom;
+    }
+    else
+    {
+        /* Set renamed identifier */
+        renamed_ = atom;
+    }
 }
 
 
@@ -77,4 +81,4 @@ const std::string& Identifier::Final() const
 
 
 
-// ================================================================================
+// ================================================================================
\ No newline at end of file
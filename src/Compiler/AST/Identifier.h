@@ -9,6 +9,7 @@
 #define XSC_IDENTIFIER_H
 
 
+#include "AtomTable.h"
 #include <string>
 
 
@@ -19,6 +20,8 @@ namespace Xsc
 /*
 Class to manage identifiers that can be renamed (maybe several times),
 to keep track of the original identifier (e.g. for error reports).
+The original and renamed identifiers are atoms of the active atom table (see AtomTable),
+so copying and renaming an identifier does not copy any strings, and equal identifiers are mostly compared by their atoms.
 */
 class Identifier
 {
@@ -41,7 +44,16 @@ class Identifier
         Identifier& RemovePrefix(const std::string& prefix);
 
         // Returns the final identifier (i.e. renamed identifier if set, otherwise original).
-        const std::string& Final() const;
+        inline const std::string& Final() const
+        {
+            return *FinalAtom();
+        }
+
+        // Returns the atom of the final identifier.
+        inline Atom FinalAtom() const
+        {
+            return (renamed_ != nullptr ? renamed_ : OriginalAtom());
+        }
 
         // Returns true if the final of this identifier is empty.
         inline bool Empty() const
@@ -58,57 +70,66 @@ class Identifier
         // Returns the original identifier.
         inline const std::string& Original() const
         {
-            return original_;
+            return *OriginalAtom();
         }
 
         // Returns true if this identifier is renamed.
         inline bool IsRenamed() const
         {
-            return !renamed_.empty();
+            return (renamed_ != nullptr && !renamed_->empty());
         }
 
     private:
 
-        bool        originalSet_    = false;
-        std::string original_;
+        friend class ASTSerializer;
+
+        // Returns the atom of the original identifier, or the empty atom if the original identifier has not been set yet.
+        inline Atom OriginalAtom() const
+        {
+            static const std::string emptyIdent;
+            return (original_ != nullptr ? original_ : &emptyIdent);
+        }
 
-        bool        renamedSet_     = false;
-        std::string renamed_;
+        // Sets either the original identifier (for the first time) or the renamed identifier.
+        void Assign(Atom atom);
 
-        int         counter_        = 0;
+        Atom    original_   = nullptr;
+        Atom    renamed_    = nullptr;
+        int     counter_    = 0;
 
 };
 
 
 inline bool operator == (const Identifier& lhs, const Identifier& rhs)
 {
-    return (std::string(lhs) == std::string(rhs));
+    /* Identifiers with the same atom are equal; otherwise they might still be interned in different tables */
+    return (lhs.FinalAtom() == rhs.FinalAtom() || lhs.Final() == rhs.Final());
 }
 
 inline bool operator == (const std::string& lhs, const Identifier& rhs)
 {
-    return (lhs == std::string(rhs));
+    return (lhs == rhs.Final());
 }
 
 inline bool operator == (const Identifier& lhs, const std::string& rhs)
 {
-    return (std::string(lhs) == rhs);
+    return (lhs.Final() == rhs);
 }
 
 
 inline bool operator != (const Identifier& lhs, const Identifier& rhs)
 {
-    return (std::string(lhs) != std::string(rhs));
+    return !(lhs == rhs);
 }
 
 inline bool operator != (const std::string& lhs, const Identifier& rhs)
 {
-    return (lhs != std::string(rhs));
+    return (lhs != rhs.Final());
 }
 
 inline bool operator != (const Identifier& lhs, const std::string& rhs)
 {
-    return (std::string(lhs) != rhs);
+    return (lhs.Final() != rhs);
 }
 
 
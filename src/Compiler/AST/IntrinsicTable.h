@@ -0,0 +1,75 @@
+/*
+ * IntrinsicTable.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_INTRINSIC_TABLE_H
+#define XSC_INTRINSIC_TABLE_H
+
+
+#include "ASTEnums.h"
+#include <array>
+#include <utility>
+#include <initializer_list>
+#include <cstddef>
+
+
+namespace Xsc
+{
+
+
+/*
+Read-only table of values that is indexed by the 'Intrinsic' enumeration.
+The table is generated once from a fixed list of entries, and each lookup is then a single array access.
+Intrinsics without an entry have no value (see Find). If the same intrinsic occurs multiple times in the initializer list,
+only the first entry is used (like 'std::map::insert').
+*/
+template <typename T>
+class IntrinsicTable
+{
+
+    public:
+
+        IntrinsicTable(const std::initializer_list<std::pair<Intrinsic, T>>& entries)
+        {
+            valid_.fill(false);
+
+            for (const auto& entry : entries)
+            {
+                const auto idx = static_cast<std::size_t>(entry.first);
+                if (idx < numIntrinsics && !valid_[idx])
+                {
+                    values_[idx]    = entry.second;
+                    valid_[idx]     = true;
+                }
+            }
+        }
+
+        // Returns a pointer to the value which is associated to the specified intrinsic, or null if there is no such entry.
+        inline const T* Find(const Intrinsic intrinsic) const
+        {
+            const auto idx = static_cast<std::size_t>(intrinsic);
+            return (idx < numIntrinsics && valid_[idx] ? &(values_[idx]) : nullptr);
+        }
+
+    private:
+
+        // Number of all intrinsics including 'Intrinsic::Undefined' (the last enumeration entry must be 'Intrinsic::PackHalf2x16').
+        static const std::size_t numIntrinsics = (static_cast<std::size_t>(Intrinsic::PackHalf2x16) + 1u);
+
+        std::array<T, numIntrinsics>    values_;
+        std::array<bool, numIntrinsics> valid_;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
\ No newline at end of file
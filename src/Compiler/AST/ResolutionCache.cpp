@@ -0,0 +1,161 @@
+/*
+ * ResolutionCache.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ResolutionCache.h"
+#include "TypeContext.h"
+#include "AST.h"
+#include <functional>
+
+
+namespace Xsc
+{
+
+
+thread_local static ResolutionCache* g_activeCache = nullptr;
+
+ResolutionCache::ResolutionCache(Statistics& statistics) :
+    statistics_ { statistics }
+{
+}
+
+ResolutionCache* ResolutionCache::Active()
+{
+    return g_activeCache;
+}
+
+std::uint64_t ResolutionCache::NewSymbolKey()
+{
+    if (auto cache = g_activeCache)
+        return ++(cache->nextSymbolKey_);
+    else
+        return 0;
+}
+
+FunctionDecl* ResolutionCache::FindFunctionDecl(std::uint64_t symbolKey, const std::vector<TypeDenoterPtr>& argTypeDenoters)
+{
+    Key key;
+    if (symbolKey != 0 && MakeKey(key, symbolKey, argTypeDenoters))
+    {
+        auto it = functionDecls_.find(key);
+        if (it != functionDecls_.end())
+        {
+            ++statistics_.functionHits;
+            return it->second;
+        }
+        ++statistics_.functionMisses;
+    }
+    return nullptr;
+}
+
+void ResolutionCache::StoreFunctionDecl(std::uint64_t symbolKey, const std::vector<TypeDenoterPtr>& argTypeDenoters, FunctionDecl* funcDecl)
+{
+    Key key;
+    if (symbolKey != 0 && funcDecl != nullptr && MakeKey(key, symbolKey, argTypeDenoters))
+        functionDecls_[std::move(key)] = funcDecl;
+}
+
+TypeDenoterPtr ResolutionCache::FindIntrinsicReturnType(const Intrinsic intrinsic, const std::vector<ExprPtr>& args)
+{
+    Key key;
+    if (MakeKey(key, static_cast<std::uint64_t>(intrinsic), args))
+    {
+        auto it = intrinsicReturnTypes_.find(key);
+        if (it != intrinsicReturnTypes_.end())
+        {
+            ++statistics_.intrinsicHits;
+            return it->second;
+        }
+        ++statistics_.intrinsicMisses;
+    }
+    return nullptr;
+}
+
+void ResolutionCache::StoreIntrinsicReturnType(const Intrinsic intrinsic, const std::vector<ExprPtr>& args, const TypeDenoterPtr& returnTypeDenoter)
+{
+    /* Only store the canonical return type, since the derived one may refer to a modifiable type of an argument */
+    Key key;
+    if (auto canonicalTypeDen = TypeContext::FindCanonical(returnTypeDenoter.get()))
+    {
+        if (MakeKey(key, static_cast<std::uint64_t>(intrinsic), args))
+            intrinsicReturnTypes_[std::move(key)] = canonicalTypeDen;
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool ResolutionCache::Key::operator == (const Key& rhs) const
+{
+    return (owner == rhs.owner && argTypes == rhs.argTypes);
+}
+
+std::size_t ResolutionCache::KeyHash::operator () (const Key& key) const
+{
+    std::size_t h = std::hash<std::uint64_t>()(key.owner);
+
+    for (auto typeDen : key.argTypes)
+        h = (h ^ std::hash<const TypeDenoter*>()(typeDen)) * 31u;
+
+    return h;
+}
+
+bool ResolutionCache::MakeKey(Key& key, std::uint64_t owner, const std::vector<TypeDenoterPtr>& argTypeDenoters)
+{
+    key.owner = owner;
+    key.argTypes.reserve(argTypeDenoters.size());
+
+    for (const auto& typeDen : argTypeDenoters)
+    {
+        if (auto canonicalTypeDen = TypeContext::FindCanonical(typeDen.get()))
+            key.argTypes.push_back(canonicalTypeDen.get());
+        else
+            return false;
+    }
+
+    return true;
+}
+
+bool ResolutionCache::MakeKey(Key& key, std::uint64_t owner, const std::vector<ExprPtr>& args)
+{
+    key.owner = owner;
+    key.argTypes.reserve(args.size());
+
+    for (const auto& arg : args)
+    {
+        if (auto canonicalTypeDen = TypeContext::FindCanonical(arg->GetTypeDenoter().get()))
+            key.argTypes.push_back(canonicalTypeDen.get());
+        else
+            return false;
+    }
+
+    return true;
+}
+
+
+/*
+ * Scope class
+ */
+
+ResolutionCache::Scope::Scope(ResolutionCache& cache) :
+    prevCache_ { g_activeCache }
+{
+    g_activeCache = &cache;
+}
+
+ResolutionCache::Scope::~Scope()
+{
+    g_activeCache = prevCache_;
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
\ No newline at end of file
@@ -0,0 +1,140 @@
+/*
+ * ResolutionCache.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_RESOLUTION_CACHE_H
+#define XSC_RESOLUTION_CACHE_H
+
+
+#include "TypeDenoter.h"
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace Xsc
+{
+
+
+/*
+Per-compilation cache of overload resolutions for user defined functions and intrinsics, and of the member indices of structures.
+While a cache is active on the current thread (see ResolutionCache::Scope), the function declaration of an overloaded symbol
+and the return type of an intrinsic are memoized by the identity of their argument type denoters.
+Argument types are identified by their canonical instance in the active type context (see TypeContext::FindCanonical),
+and calls with any other argument type are resolved without the cache. Failed resolutions are never memoized, so their errors are reported for each call.
+*/
+class ResolutionCache
+{
+
+    public:
+
+        // Hit and miss counters of the cache.
+        struct Statistics
+        {
+            std::size_t functionHits    = 0;
+            std::size_t functionMisses  = 0;
+            std::size_t intrinsicHits   = 0;
+            std::size_t intrinsicMisses = 0;
+        };
+
+        // Scope guard that activates the specified cache on the current thread, and restores the previously active cache on destruction.
+        class Scope
+        {
+
+            public:
+
+                Scope(ResolutionCache& cache);
+                ~Scope();
+
+                Scope(const Scope&) = delete;
+                Scope& operator = (const Scope&) = delete;
+
+            private:
+
+                ResolutionCache* prevCache_ = nullptr;
+
+        };
+
+        // Constructs the cache with the counters it accumulates its hits and misses in, which must outlive the cache.
+        ResolutionCache(Statistics& statistics);
+
+        ResolutionCache(const ResolutionCache&) = delete;
+        ResolutionCache& operator = (const ResolutionCache&) = delete;
+
+        // Returns the active cache of the current thread, or null if there is no active cache.
+        static ResolutionCache* Active();
+
+        /*
+        Returns a new key for the set of overloads of a symbol, or zero if there is no active cache.
+        A new key must be acquired whenever an overload is registered, which invalidates all previous resolutions of that symbol.
+        */
+        static std::uint64_t NewSymbolKey();
+
+        // Returns the memoized function declaration for the specified symbol key and argument types, or null if there is none.
+        FunctionDecl* FindFunctionDecl(std::uint64_t symbolKey, const std::vector<TypeDenoterPtr>& argTypeDenoters);
+
+        // Memoizes the function declaration for the specified symbol key and argument types.
+        void StoreFunctionDecl(std::uint64_t symbolKey, const std::vector<TypeDenoterPtr>& argTypeDenoters, FunctionDecl* funcDecl);
+
+        // Returns the memoized return type of the specified intrinsic and argument types, or null if there is none.
+        TypeDenoterPtr FindIntrinsicReturnType(const Intrinsic intrinsic, const std::vector<ExprPtr>& args);
+
+        // Memoizes the return type of the specified intrinsic and argument types, if the return type has a canonical instance.
+        void StoreIntrinsicReturnType(const Intrinsic intrinsic, const std::vector<ExprPtr>& args, const TypeDenoterPtr& returnTypeDenoter);
+
+        // Returns the epoch of the member indices of all structures in this compilation (see StructDecl::InvalidateMemberIndex).
+        inline std::uint64_t GetMemberIndexEpoch() const
+        {
+            return memberIndexEpoch_;
+        }
+
+        // Invalidates the member indices of all structures in this compilation.
+        inline void InvalidateMemberIndices()
+        {
+            ++memberIndexEpoch_;
+        }
+
+    private:
+
+        struct Key
+        {
+            std::uint64_t                   owner;
+            std::vector<const TypeDenoter*> argTypes;
+
+            bool operator == (const Key& rhs) const;
+        };
+
+        struct KeyHash
+        {
+            std::size_t operator () (const Key& key) const;
+        };
+
+        // Returns true if the specified key could be built from the argument types (i.e. all of them have a canonical instance).
+        static bool MakeKey(Key& key, std::uint64_t owner, const std::vector<TypeDenoterPtr>& argTypeDenoters);
+        static bool MakeKey(Key& key, std::uint64_t owner, const std::vector<ExprPtr>& args);
+
+    private:
+
+        std::uint64_t                                           nextSymbolKey_      = 0;
+        std::uint64_t                                           memberIndexEpoch_   = 0;
+
+        std::unordered_map<Key, FunctionDecl*, KeyHash>         functionDecls_;
+        std::unordered_map<Key, TypeDenoterPtr, KeyHash>        intrinsicReturnTypes_;
+
+        Statistics&                                             statistics_;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
\ No newline at end of file
@@ -31,10 +31,7 @@ bool SourceArea::IsValid() const
 
 void SourceArea::Update(const SourceArea& area)
 {
-    if (area.pos_.Row() > pos_.Row())
-        length_ = ~0;
-    else if (area.pos_.Row() == pos_.Row() && area.pos_.Column() + area.length_ > pos_.Column() + length_)
-        length_ = (area.pos_.Column() - pos_.Column() + area.length_);
+    UpdateRowColumn(area.pos_.Row(), area.pos_.Column(), area.length_);
 }
 
 void SourceArea::Update(const std::string& lengthFromIdent)
@@ -44,7 +41,8 @@ void SourceArea::Update(const std::string& lengthFromIdent)
 
 void SourceArea::Update(const Token& tkn)
 {
-    Update(tkn.Area());
+    /* Take the token position without copying its source origin */
+    UpdateRowColumn(tkn.Row(), tkn.Column(), static_cast<unsigned int>(tkn.SpellSize()));
 }
 
 void SourceArea::Update(const AST& ast)
@@ -59,10 +57,12 @@ void SourceArea::Offset(unsigned int offset)
 
 void SourceArea::Offset(const SourcePosition& pos)
 {
-    if (pos.Row() == pos_.Row() && pos.Column() >= pos_.Column())
-        offset_ = (pos.Column() - pos_.Column());
-    else
-        offset_ = ~0;
+    OffsetRowColumn(pos.Row(), pos.Column());
+}
+
+void SourceArea::Offset(const Token& tkn)
+{
+    OffsetRowColumn(tkn.Row(), tkn.Column());
 }
 
 unsigned int SourceArea::Offset() const
@@ -71,6 +71,27 @@ unsigned int SourceArea::Offset() const
 }
 
 
+/*
+ * ======= Private: =======
+ */
+
+void SourceArea::UpdateRowColumn(unsigned int row, unsigned int column, unsigned int length)
+{
+    if (row > pos_.Row())
+        length_ = ~0;
+    else if (row == pos_.Row() && column + length > pos_.Column() + length_)
+        length_ = (column - pos_.Column() + length);
+}
+
+void SourceArea::OffsetRowColumn(unsigned int row, unsigned int column)
+{
+    if (row == pos_.Row() && column >= pos_.Column())
+        offset_ = (column - pos_.Column());
+    else
+        offset_ = ~0;
+}
+
+
 } // /namespace Xsc
 
 
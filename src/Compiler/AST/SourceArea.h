@@ -55,6 +55,9 @@ class SourceArea
         // Sets the new offset of the marker pointer by a source position.
         void Offset(const SourcePosition& pos);
 
+        // Sets the new offset of the marker pointer by the source position of the specified token.
+        void Offset(const Token& tkn);
+
         // Returns the offset of the marker pointer (e.g. "^~~~") clamped to the range [0, length).
         unsigned int Offset() const;
 
@@ -72,6 +75,9 @@ class SourceArea
 
     private:
 
+        void UpdateRowColumn(unsigned int row, unsigned int column, unsigned int length);
+        void OffsetRowColumn(unsigned int row, unsigned int column);
+
         SourcePosition  pos_;
         unsigned int    length_ = 0;
         unsigned int    offset_ = 0;
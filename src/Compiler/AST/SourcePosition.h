@@ -17,6 +17,8 @@ namespace Xsc
 {
 
 
+class SourceCode;
+
 /*
 Source code origin with filename and line offset.
 This is used to track the filename and correct source position line for each AST within a pre-processed source code.
@@ -24,8 +26,9 @@ This is necessary because the pre-processsor eliminates all include directives.
 */
 struct SourceOrigin
 {
-    std::string filename;
-    int         lineOffset;
+    std::string                 filename;
+    int                         lineOffset;
+    std::weak_ptr<SourceCode>   sourceCode; // Source code the rows refer to (used for line markers in reports, as long as the source code is alive).
 };
 
 using SourceOriginPtr = std::shared_ptr<SourceOrigin>;
@@ -85,6 +88,12 @@ class SourcePosition
             return origin_.get();
         }
 
+        // Returns the current origin as shared pointer.
+        inline const SourceOriginPtr& GetSharedOrigin() const
+        {
+            return origin_;
+        }
+
         // Equivalent to a call to 'IsValid()'.
         inline operator bool () const
         {
@@ -7,37 +7,34 @@
 
 #include "Token.h"
 #include "ReportIdents.h"
+#include <cstring>
 
 
 namespace Xsc
 {
 
 
-Token::Token(Token&& other) :
-    type_  { other.type_             },
-    pos_   { other.pos_              },
-    spell_ { std::move(other.spell_) }
+Token::Token(
+    const Types             type,
+    unsigned int            row,
+    unsigned int            column,
+    const SourceOriginPtr*  origin,
+    const char*             spell,
+    std::size_t             spellSize)
+:
+    type_       { type                                  },
+    row_        { row                                   },
+    column_     { column                                },
+    spellSize_  { static_cast<unsigned int>(spellSize)  },
+    origin_     { origin                                },
+    spell_      { spell                                 }
 {
 }
 
-Token::Token(const SourcePosition& pos, const Types type) :
-    type_ { type },
-    pos_  { pos  }
-{
-}
-
-Token::Token(const SourcePosition& pos, const Types type, const std::string& spell) :
-    type_  { type  },
-    pos_   { pos   },
-    spell_ { spell }
-{
-}
-
-Token::Token(const SourcePosition& pos, const Types type, std::string&& spell) :
-    type_  { type             },
-    pos_   { pos              },
-    spell_ { std::move(spell) }
+const SourceOriginPtr& Token::SharedOrigin() const
 {
+    static const SourceOriginPtr noOrigin;
+    return (origin_ != nullptr ? *origin_ : noOrigin);
 }
 
 SourceArea Token::Area() const
@@ -46,7 +43,7 @@ SourceArea Token::Area() const
     return
     {
         Pos(),
-        static_cast<unsigned int>(Spell().size())
+        static_cast<unsigned int>(SpellSize())
     };
 }
 
@@ -137,15 +134,25 @@ std::string Token::TypeToString(const Types type)
 
 std::string Token::SpellContent() const
 {
-    if (Type() == Types::StringLiteral && Spell().size() >= 2)
-        return Spell().substr(1, Spell().size() - 2);
+    if (Type() == Types::StringLiteral && SpellSize() >= 2)
+        return std::string(SpellData() + 1, SpellSize() - 2);
     else
         return Spell();
 }
 
+bool Token::EqualsSpell(const std::string& spell) const
+{
+    return (spell.size() == SpellSize() && spell.compare(0, spell.size(), SpellData(), SpellSize()) == 0);
+}
+
+bool Token::EqualsSpell(const char* spell) const
+{
+    return (std::strncmp(spell, SpellData(), SpellSize()) == 0 && spell[SpellSize()] == '\0');
+}
+
 
 } // /namespace Xsc
 
 
 
-// ================================================================================
+// ================================================================================
\ No newline at end of file
@@ -10,9 +10,11 @@
 
 
 #include "SourceArea.h"
+#include "PerfectHashMap.h"
 #include <string>
 #include <memory>
 #include <map>
+#include <cstddef>
 
 
 namespace Xsc
@@ -146,11 +148,14 @@ class Token
             EndOfStream,        // End-of-stream
         };
 
-        Token(Token&& other);
-
-        Token(const SourcePosition& pos, const Types type);
-        Token(const SourcePosition& pos, const Types type, const std::string& spell);
-        Token(const SourcePosition& pos, const Types type, std::string&& spell);
+        Token(
+            const Types             type,
+            unsigned int            row,
+            unsigned int            column,
+            const SourceOriginPtr*  origin,
+            const char*             spell,
+            std::size_t             spellSize
+        );
 
         // Returns the source area of this token.
         SourceArea Area() const;
@@ -161,37 +166,143 @@ class Token
         // Returns the token spelling of the content (e.g. only the content of a string literal within the quotes).
         std::string SpellContent() const;
 
+        // Returns true if the token spelling is equal to the specified string (without allocating a new string).
+        bool EqualsSpell(const std::string& spell) const;
+
+        // Returns true if the token spelling is equal to the specified null-terminated string (e.g. a keyword literal).
+        bool EqualsSpell(const char* spell) const;
+
         // Returns the token type.
         inline Types Type() const
         {
             return type_;
         }
 
-        // Returns the token source position.
-        inline const SourcePosition& Pos() const
+        /*
+        Returns the token source position.
+        This copies the shared source origin, so hot paths should rather use the 'Row', 'Column', and 'Origin' functions.
+        */
+        inline SourcePosition Pos() const
+        {
+            return SourcePosition(row_, column_, SharedOrigin());
+        }
+
+        // Returns the source row of this token.
+        inline unsigned int Row() const
+        {
+            return row_;
+        }
+
+        // Returns the source column of this token.
+        inline unsigned int Column() const
+        {
+            return column_;
+        }
+
+        // Returns the source origin of this token, or null if the token has no origin.
+        inline const SourceOrigin* Origin() const
+        {
+            return (origin_ != nullptr ? origin_->get() : nullptr);
+        }
+
+        // Returns the source origin of this token as shared pointer.
+        const SourceOriginPtr& SharedOrigin() const;
+
+        /*
+        Returns a copy of the token spelling.
+        Hot paths should rather use the 'SpellData' and 'SpellSize' functions, or 'EqualsSpell', which do not allocate a new string.
+        */
+        inline std::string Spell() const
         {
-            return pos_;
+            return std::string(spell_, spellSize_);
         }
 
-        // Returns the token spelling.
-        inline const std::string& Spell() const
+        // Returns the pointer to the token spelling (which is not null-terminated).
+        inline const char* SpellData() const
         {
             return spell_;
         }
 
+        // Returns the length of the token spelling.
+        inline std::size_t SpellSize() const
+        {
+            return spellSize_;
+        }
+
+    private:
+
+        Types                   type_;                  // Type of this token.
+        unsigned int            row_        = 0;        // Source row of this token.
+        unsigned int            column_     = 0;        // Source column of this token.
+        unsigned int            spellSize_  = 0;        // Length of the token spelling.
+        const SourceOriginPtr*  origin_     = nullptr;  // Interned source origin (owned by the token arena).
+        const char*             spell_      = "";       // Token spelling as view into the source code or the token arena.
+
+};
+
+/*
+Non-owning token reference.
+All tokens are owned by the token arena of the parser that created them (see TokenArena),
+so copying a token reference does neither allocate memory nor modify any reference counter.
+*/
+class TokenRef
+{
+
+    public:
+
+        TokenRef() = default;
+
+        TokenRef(std::nullptr_t)
+        {
+        }
+
+        TokenRef(Token* tkn) :
+            tkn_ { tkn }
+        {
+        }
+
+        // Returns the raw pointer to the token.
+        inline Token* get() const
+        {
+            return tkn_;
+        }
+
+        inline Token* operator -> () const
+        {
+            return tkn_;
+        }
+
+        inline Token& operator * () const
+        {
+            return *tkn_;
+        }
+
+        inline explicit operator bool () const
+        {
+            return (tkn_ != nullptr);
+        }
+
     private:
 
-        Types           type_;  // Type of this token.
-        SourcePosition  pos_;   // Source area of this token.
-        std::string     spell_; // Token spelling.
+        Token* tkn_ = nullptr;
 
 };
 
-// Token shared pointer type.
-using TokenPtr = std::shared_ptr<Token>;
+inline bool operator == (const TokenRef& lhs, const TokenRef& rhs)
+{
+    return (lhs.get() == rhs.get());
+}
+
+inline bool operator != (const TokenRef& lhs, const TokenRef& rhs)
+{
+    return (lhs.get() != rhs.get());
+}
+
+// Token reference type (the name is kept from the former shared pointer type).
+using TokenPtr = TokenRef;
 
 // Keyword-to-Token map type.
-using KeywordMapType = std::map<std::string, Token::Types>;
+using KeywordMapType = PerfectHashMap<Token::Types>;
 
 
 } // /namespace Xsc
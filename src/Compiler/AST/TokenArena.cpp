@@ -0,0 +1,77 @@
+/*
+ * TokenArena.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "TokenArena.h"
+#include <algorithm>
+
+
+namespace Xsc
+{
+
+
+TokenPtr TokenArena::MakeToken(const SourcePosition& pos, const Token::Types type, const char* spell, std::size_t spellSize)
+{
+    return MakeTokenView(pos, type, arena_.CopyString(spell, spellSize), spellSize);
+}
+
+TokenPtr TokenArena::MakeToken(const SourcePosition& pos, const Token::Types type, const std::string& spell)
+{
+    return MakeToken(pos, type, spell.data(), spell.size());
+}
+
+TokenPtr TokenArena::MakeTokenView(const SourcePosition& pos, const Token::Types type, const char* spell, std::size_t spellSize)
+{
+    return arena_.New<Token>(type, pos.Row(), pos.Column(), InternOrigin(pos.GetSharedOrigin()), spell, spellSize);
+}
+
+TokenPtr TokenArena::MakeTokenView(const Token& posTkn, const Token::Types type, const char* spell, std::size_t spellSize)
+{
+    return arena_.New<Token>(type, posTkn.Row(), posTkn.Column(), InternOrigin(posTkn.SharedOrigin()), spell, spellSize);
+}
+
+void TokenArena::RetainSource(const SourceCodePtr& source)
+{
+    if (source && std::find(sources_.begin(), sources_.end(), source) == sources_.end())
+        sources_.push_back(source);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+const SourceOriginPtr* TokenArena::InternOrigin(const SourceOriginPtr& origin)
+{
+    if (!origin)
+        return nullptr;
+
+    /* Most tokens share the same origin as their predecessor */
+    if (lastOrigin_ != nullptr && *lastOrigin_ == origin)
+        return lastOrigin_;
+
+    /* Search origin in reverse order, since new origins are appended */
+    for (auto it = origins_.rbegin(); it != origins_.rend(); ++it)
+    {
+        if (*it == origin)
+        {
+            lastOrigin_ = &(*it);
+            return lastOrigin_;
+        }
+    }
+
+    origins_.push_back(origin);
+    lastOrigin_ = &(origins_.back());
+
+    return lastOrigin_;
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
\ No newline at end of file
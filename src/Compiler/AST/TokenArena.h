@@ -0,0 +1,73 @@
+/*
+ * TokenArena.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_TOKEN_ARENA_H
+#define XSC_TOKEN_ARENA_H
+
+
+#include "Token.h"
+#include "MemoryArena.h"
+#include "SourceCode.h"
+#include <deque>
+#include <vector>
+
+
+namespace Xsc
+{
+
+
+/*
+Owner of all tokens of a parser (incl. the pre-processor).
+Tokens are allocated in a monotonic memory arena, and their spellings are either views into the source code (which is retained by this arena)
+or copies in the same arena. Source origins are interned, so a token only stores a pointer to the shared origin instead of a reference counter.
+*/
+class TokenArena
+{
+
+    public:
+
+        TokenArena() = default;
+
+        TokenArena(const TokenArena&) = delete;
+        TokenArena& operator = (const TokenArena&) = delete;
+
+        // Creates a new token and copies the specified spelling into this arena.
+        TokenPtr MakeToken(const SourcePosition& pos, const Token::Types type, const char* spell, std::size_t spellSize);
+
+        // Creates a new token and copies the specified spelling into this arena.
+        TokenPtr MakeToken(const SourcePosition& pos, const Token::Types type, const std::string& spell = "");
+
+        // Creates a new token whose spelling refers to the specified characters, which must be retained by this arena (see RetainSource).
+        TokenPtr MakeTokenView(const SourcePosition& pos, const Token::Types type, const char* spell, std::size_t spellSize);
+
+        // Creates a new token at the source position of the specified token, whose spelling refers to characters that are retained by this arena.
+        TokenPtr MakeTokenView(const Token& posTkn, const Token::Types type, const char* spell, std::size_t spellSize);
+
+        // Keeps the specified source code alive as long as this arena, so token spellings can refer to its buffer.
+        void RetainSource(const SourceCodePtr& source);
+
+    private:
+
+        // Returns the interned pointer of the specified source origin.
+        const SourceOriginPtr* InternOrigin(const SourceOriginPtr& origin);
+
+        MemoryArena                 arena_;
+        std::deque<SourceOriginPtr> origins_;
+        const SourceOriginPtr*      lastOrigin_ = nullptr;
+        std::vector<SourceCodePtr>  sources_;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
\ No newline at end of file
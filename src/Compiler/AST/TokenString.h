@@ -11,6 +11,7 @@
 
 #include "Token.h"
 #include <vector>
+#include <string>
 #include <ostream>
 
 
@@ -217,8 +218,11 @@ bool operator == (const BasicTokenString<TokenType, TokenOfInterestFunctor>& lhs
             return false;
 
         /* Compare values */
-        if (lhsTkn->Spell() != rhsTkn->Spell())
+        if (lhsTkn->SpellSize() != rhsTkn->SpellSize() ||
+            std::char_traits<char>::compare(lhsTkn->SpellData(), rhsTkn->SpellData(), lhsTkn->SpellSize()) != 0)
+        {
             return false;
+        }
     }
 
     /* Check if both strings reached the end */
@@ -235,7 +239,7 @@ template <typename TokenType, typename TokenOfInterestFunctor>
 std::ostream& operator << (std::ostream& lhs, const BasicTokenString<TokenType, TokenOfInterestFunctor>& rhs)
 {
     for (const auto& tkn : rhs.GetTokens())
-        lhs << tkn->Spell();
+        lhs.write(tkn->SpellData(), static_cast<std::streamsize>(tkn->SpellSize()));
     return lhs;
 }
 
@@ -0,0 +1,122 @@
+/*
+ * TypeContext.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "TypeContext.h"
+
+
+namespace Xsc
+{
+
+
+thread_local static TypeContext* g_activeContext = nullptr;
+
+static const std::size_t g_numDataTypes = static_cast<std::size_t>(DataType::Double4x4) + 1;
+
+TypeContext::TypeContext() :
+    baseTypeDenoters_ ( g_numDataTypes )
+{
+}
+
+TypeContext* TypeContext::Active()
+{
+    return g_activeContext;
+}
+
+BaseTypeDenoterPtr TypeContext::MakeBase(const DataType dataType)
+{
+    #ifndef XSC_ENABLE_LANGUAGE_EXT
+
+    /* Base type denoters can only be interned without vector spaces, which are assigned to derived types individually */
+    if (auto context = g_activeContext)
+    {
+        auto& typeDen = context->baseTypeDenoters_[static_cast<std::size_t>(dataType)];
+        if (!typeDen)
+            typeDen = std::make_shared<BaseTypeDenoter>(dataType);
+        return typeDen;
+    }
+
+    #endif
+
+    return std::make_shared<BaseTypeDenoter>(dataType);
+}
+
+VoidTypeDenoterPtr TypeContext::MakeVoid()
+{
+    if (auto context = g_activeContext)
+    {
+        if (!context->voidTypeDenoter_)
+            context->voidTypeDenoter_ = std::make_shared<VoidTypeDenoter>();
+        return context->voidTypeDenoter_;
+    }
+    return std::make_shared<VoidTypeDenoter>();
+}
+
+NullTypeDenoterPtr TypeContext::MakeNull()
+{
+    if (auto context = g_activeContext)
+    {
+        if (!context->nullTypeDenoter_)
+            context->nullTypeDenoter_ = std::make_shared<NullTypeDenoter>();
+        return context->nullTypeDenoter_;
+    }
+    return std::make_shared<NullTypeDenoter>();
+}
+
+#ifdef XSC_ENABLE_LANGUAGE_EXT
+
+TypeDenoterPtr TypeContext::FindCanonical(const TypeDenoter* /*typeDenoter*/)
+{
+    /* Derived types are not interned with vector spaces (see MakeBase), so no type denoter identifies its type */
+    return nullptr;
+}
+
+#else
+
+TypeDenoterPtr TypeContext::FindCanonical(const TypeDenoter* typeDenoter)
+{
+    if (g_activeContext != nullptr && typeDenoter != nullptr)
+    {
+        switch (typeDenoter->Type())
+        {
+            case TypeDenoter::Types::Void:
+                return MakeVoid();
+            case TypeDenoter::Types::Null:
+                return MakeNull();
+            case TypeDenoter::Types::Base:
+                return MakeBase(static_cast<const BaseTypeDenoter*>(typeDenoter)->dataType);
+            default:
+                break;
+        }
+    }
+
+    return nullptr;
+}
+
+#endif
+
+
+/*
+ * Scope class
+ */
+
+TypeContext::Scope::Scope(TypeContext& context) :
+    prevContext_ { g_activeContext }
+{
+    g_activeContext = &context;
+}
+
+TypeContext::Scope::~Scope()
+{
+    g_activeContext = prevContext_;
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
\ No newline at end of file
@@ -0,0 +1,89 @@
+/*
+ * TypeContext.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_TYPE_CONTEXT_H
+#define XSC_TYPE_CONTEXT_H
+
+
+#include "TypeDenoter.h"
+#include <vector>
+
+
+namespace Xsc
+{
+
+
+/*
+Per-compilation context of interned type denoters (also referred to as "hash-consing").
+While a context is active on the current thread (see TypeContext::Scope), the type denoters that are derived from expressions
+(e.g. swizzles, array accesses, common types of binary expressions, and intrinsic return types) share a single instance per type,
+so their derivation does not allocate any memory and equal types can be compared by their pointers.
+Interned type denoters must not be modified; use 'TypeDenoter::Copy' to get a modifiable instance.
+*/
+class TypeContext
+{
+
+    public:
+
+        // Scope guard that activates the specified context on the current thread, and restores the previously active context on destruction.
+        class Scope
+        {
+
+            public:
+
+                Scope(TypeContext& context);
+                ~Scope();
+
+                Scope(const Scope&) = delete;
+                Scope& operator = (const Scope&) = delete;
+
+            private:
+
+                TypeContext* prevContext_ = nullptr;
+
+        };
+
+        TypeContext();
+
+        TypeContext(const TypeContext&) = delete;
+        TypeContext& operator = (const TypeContext&) = delete;
+
+        // Returns the active context of the current thread, or null if there is no active context.
+        static TypeContext* Active();
+
+        // Returns the interned base type denoter of the specified data type, or a new instance if there is no active context.
+        static BaseTypeDenoterPtr MakeBase(const DataType dataType);
+
+        // Returns the interned void type denoter, or a new instance if there is no active context.
+        static VoidTypeDenoterPtr MakeVoid();
+
+        // Returns the interned null type denoter, or a new instance if there is no active context.
+        static NullTypeDenoterPtr MakeNull();
+
+        /*
+        Returns the interned instance that is equal to the specified type denoter, i.e. a pointer that identifies its type,
+        or null if the type cannot be interned or there is no active context.
+        */
+        static TypeDenoterPtr FindCanonical(const TypeDenoter* typeDenoter);
+
+    private:
+
+        std::vector<BaseTypeDenoterPtr> baseTypeDenoters_;  // Indexed by DataType
+        VoidTypeDenoterPtr              voidTypeDenoter_;
+        NullTypeDenoterPtr              nullTypeDenoter_;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
\ No newline at end of file
@@ -6,6 +6,7 @@
  */
 
 #include "TypeDenoter.h"
+#include "TypeContext.h"
 #include "Exception.h"
 #include "AST.h"
 #include "ReportIdents.h"
@@ -340,7 +341,7 @@ static TypeDenoterPtr FindCommonTypeDenoterScalarAndScalar(BaseTypeDenoter* lhsT
 {
     /* Return scalar type with highest order data type */
     auto commonType = HighestOrderDataType(lhsTypeDen->dataType, rhsTypeDen->dataType);
-    return std::make_shared<BaseTypeDenoter>(commonType);
+    return TypeContext::MakeBase(commonType);
 }
 
 static TypeDenoterPtr FindCommonTypeDenoterScalarAndVector(BaseTypeDenoter* lhsTypeDen, BaseTypeDenoter* rhsTypeDen, bool useMinDimension)
@@ -349,13 +350,13 @@ static TypeDenoterPtr FindCommonTypeDenoterScalarAndVector(BaseTypeDenoter* lhsT
     if (useMinDimension)
     {
         /* Return scalar type (minimal dimension) */
-        return std::make_shared<BaseTypeDenoter>(commonType);
+        return TypeContext::MakeBase(commonType);
     }
     else
     {
         /* Return vector type */
         auto rhsDim = VectorTypeDim(rhsTypeDen->dataType);
-        return std::make_shared<BaseTypeDenoter>(VectorDataType(commonType, rhsDim));
+        return TypeContext::MakeBase(VectorDataType(commonType, rhsDim));
     }
 }
 
@@ -365,13 +366,13 @@ static TypeDenoterPtr FindCommonTypeDenoterScalarAndMatrix(BaseTypeDenoter* lhsT
     if (useMinDimension)
     {
         /* Return scalar type (minimal dimension) */
-        return std::make_shared<BaseTypeDenoter>(commonType);
+        return TypeContext::MakeBase(commonType);
     }
     else
     {
         /* Return matrix type */
         auto rhsDim = MatrixTypeDim(rhsTypeDen->dataType);
-        return std::make_shared<BaseTypeDenoter>(MatrixDataType(commonType, rhsDim.first, rhsDim.second));
+        return TypeContext::MakeBase(MatrixDataType(commonType, rhsDim.first, rhsDim.second));
     }
 }
 
@@ -384,7 +385,7 @@ static TypeDenoterPtr FindCommonTypeDenoterVectorAndVector(BaseTypeDenoter* lhsT
     auto rhsDim = VectorTypeDim(rhsTypeDen->dataType);
     auto commonDim = std::min(lhsDim, rhsDim);
 
-    return std::make_shared<BaseTypeDenoter>(VectorDataType(commonType, commonDim));
+    return TypeContext::MakeBase(VectorDataType(commonType, commonDim));
 }
 
 static TypeDenoterPtr FindCommonTypeDenoterVectorAndMatrix(BaseTypeDenoter* lhsTypeDen, BaseTypeDenoter* rhsTypeDen, bool rowVector)
@@ -395,7 +396,7 @@ static TypeDenoterPtr FindCommonTypeDenoterVectorAndMatrix(BaseTypeDenoter* lhsT
     auto matrixDim = MatrixTypeDim(rhsTypeDen->dataType);
     auto commonDim = (rowVector ? matrixDim.first : matrixDim.second);
 
-    return std::make_shared<BaseTypeDenoter>(VectorDataType(commonType, commonDim));
+    return TypeContext::MakeBase(VectorDataType(commonType, commonDim));
 }
 
 static TypeDenoterPtr FindCommonTypeDenoterAnyAndAny(TypeDenoter* lhsTypeDen, TypeDenoter* rhsTypeDen)
@@ -485,12 +486,12 @@ BaseTypeDenoterPtr TypeDenoter::MakeBoolTypeWithDimensionOf(const TypeDenoter& t
     {
         /* Make vector boolean type denoter with dimension of the specified type denoter */
         auto vecBoolType = VectorDataType(DataType::Bool, VectorTypeDim(baseTypeDen->dataType));
-        return std::make_shared<BaseTypeDenoter>(vecBoolType);
+        return TypeContext::MakeBase(vecBoolType);
     }
     else
     {
         /* Make single boolean type denoter */
-        return std::make_shared<BaseTypeDenoter>(DataType::Bool);
+        return TypeContext::MakeBase(DataType::Bool);
     }
 }
 
@@ -595,6 +596,10 @@ TypeDenoterPtr BaseTypeDenoter::Copy() const
 
 bool BaseTypeDenoter::Equals(const TypeDenoter& rhs, const Flags& /*compareFlags*/) const
 {
+    /* Interned type denoters are equal if they share the same instance (see TypeContext) */
+    if (this == &rhs)
+        return true;
+
     /* Compare data types of both type denoters */
     if (auto rhsBaseTypeDen = rhs.As<BaseTypeDenoter>())
         return (dataType == rhsBaseTypeDen->dataType);
@@ -648,7 +653,7 @@ TypeDenoterPtr BaseTypeDenoter::GetSubObject(const std::string& ident, const AST
     try
     {
         auto subscriptDataType = SubscriptDataType(dataType, ident);
-        auto subTypeDen = std::make_shared<BaseTypeDenoter>(subscriptDataType);
+        auto subTypeDen = TypeContext::MakeBase(subscriptDataType);
 
         #ifdef XSC_ENABLE_LANGUAGE_EXT
         subTypeDen->vectorSpace = vectorSpace;
@@ -673,7 +678,7 @@ TypeDenoterPtr BaseTypeDenoter::GetSubArray(const std::size_t numArrayIndices, c
             if (numArrayIndices > 1)
                 RuntimeErr(R_TooManyArrayDimensions(R_VectorTypeDen), ast);
             else
-                return std::make_shared<BaseTypeDenoter>(BaseDataType(dataType));
+                return TypeContext::MakeBase(BaseDataType(dataType));
         }
         else if (IsMatrixType(dataType))
         {
@@ -681,10 +686,10 @@ TypeDenoterPtr BaseTypeDenoter::GetSubArray(const std::size_t numArrayIndices, c
             if (numArrayIndices == 1)
             {
                 auto matrixDim = MatrixTypeDim(dataType);
-                return std::make_shared<BaseTypeDenoter>(VectorDataType(BaseDataType(dataType), matrixDim.second));
+                return TypeContext::MakeBase(VectorDataType(BaseDataType(dataType), matrixDim.second));
             }
             else if (numArrayIndices == 2)
-                return std::make_shared<BaseTypeDenoter>(BaseDataType(dataType));
+                return TypeContext::MakeBase(BaseDataType(dataType));
             else if (numArrayIndices > 2)
                 RuntimeErr(R_TooManyArrayDimensions(R_MatrixTypeDen), ast);
         }
@@ -797,7 +802,7 @@ TypeDenoterPtr BufferTypeDenoter::GetGenericTypeDenoter() const
     if (genericTypeDenoter)
         return genericTypeDenoter;
     else
-        return std::make_shared<BaseTypeDenoter>(DataType::Float4);
+        return TypeContext::MakeBase(DataType::Float4);
 }
 
 AST* BufferTypeDenoter::SymbolRef() const
@@ -0,0 +1,114 @@
+/*
+ * CallGraphAnalyzer.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "CallGraphAnalyzer.h"
+#include "AST.h"
+
+
+namespace Xsc
+{
+
+
+// Returns the function declaration of the specified global statement, or null if the statement is not a function declaration.
+static FunctionDecl* GetFunctionDeclOfStmnt(const Stmnt& stmnt)
+{
+    if (auto declStmnt = stmnt.As<BasicDeclStmnt>())
+    {
+        if (auto funcDecl = declStmnt->declObject->As<FunctionDecl>())
+            return funcDecl;
+    }
+    return nullptr;
+}
+
+std::size_t CallGraphAnalyzer::DisableUnreachableFunctions(
+    Program& program, const std::string& entryPoint, const std::string& secondaryEntryPoint)
+{
+    /* Gather all global function declarations, and the references of all other global statements */
+    for (auto& stmnt : program.globalStmnts)
+    {
+        if (auto funcDecl = GetFunctionDeclOfStmnt(*stmnt))
+            functionStmnts_[funcDecl->ident.Original()].push_back(stmnt.get());
+        else
+            Visit(stmnt);
+    }
+
+    if (functionStmnts_.find(entryPoint) == functionStmnts_.end())
+        return 0;
+
+    /* Visit all functions that are reachable from the entry points */
+    Reference(entryPoint);
+
+    if (!secondaryEntryPoint.empty())
+        Reference(secondaryEntryPoint);
+
+    while (!pendingIdents_.empty())
+    {
+        auto ident = std::move(pendingIdents_.back());
+        pendingIdents_.pop_back();
+
+        auto it = functionStmnts_.find(ident);
+        if (it != functionStmnts_.end())
+        {
+            for (auto stmnt : it->second)
+                Visit(stmnt);
+        }
+    }
+
+    /* Move all unreferenced function declarations into the disabled AST (in a single pass, since there might be thousands of them) */
+    const auto numStmnts = program.globalStmnts.size();
+
+    std::size_t numActiveStmnts = 0;
+
+    for (auto& stmnt : program.globalStmnts)
+    {
+        auto funcDecl = GetFunctionDeclOfStmnt(*stmnt);
+        if (funcDecl != nullptr && referencedIdents_.find(funcDecl->ident.Original()) == referencedIdents_.end())
+            program.disabledAST.push_back(std::move(stmnt));
+        else
+            program.globalStmnts[numActiveStmnts++] = std::move(stmnt);
+    }
+
+    program.globalStmnts.resize(numActiveStmnts);
+
+    return (numStmnts - program.globalStmnts.size());
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void CallGraphAnalyzer::Reference(const std::string& ident)
+{
+    if (referencedIdents_.insert(ident).second)
+        pendingIdents_.push_back(ident);
+}
+
+/* ------- Visit functions ------- */
+
+void CallGraphAnalyzer::VisitCallExpr(CallExpr* ast, void* args)
+{
+    /* Reference function name (type constructors have no identifier) */
+    if (!ast->ident.empty())
+        Reference(ast->ident);
+
+    Visitor::VisitCallExpr(ast, args);
+}
+
+void CallGraphAnalyzer::VisitLiteralExpr(LiteralExpr* ast, void* /*args*/)
+{
+    /* Reference string literals, since attributes refer to functions by their name (e.g. "[patchconstantfunc("PatchFunc")]") */
+    if (ast->dataType == DataType::String)
+        Reference(ast->GetStringValue());
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
\ No newline at end of file
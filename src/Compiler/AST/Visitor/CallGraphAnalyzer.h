@@ -0,0 +1,69 @@
+/*
+ * CallGraphAnalyzer.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_CALL_GRAPH_ANALYZER_H
+#define XSC_CALL_GRAPH_ANALYZER_H
+
+
+#include "Visitor.h"
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <string>
+
+
+namespace Xsc
+{
+
+
+/*
+Call graph analyzer for the undecorated AST.
+This is a helper class for the context analyzer to skip all global functions that can not be reached from the entry points.
+The call graph is built by the identifiers of the call expressions (and the string literals of attributes, e.g. "patchconstantfunc"),
+so it is a conservative approximation: all overloads of a function name are reachable together,
+and every function that is called from a global statement other than a function (e.g. a member function) is reachable as well.
+*/
+class CallGraphAnalyzer : private Visitor
+{
+
+    public:
+
+        /*
+        Moves all global function declarations, which are not reachable from the specified entry points, into the disabled AST of the program.
+        Returns the number of disabled function declaration statements. Nothing is disabled, if the main entry point was not found.
+        */
+        std::size_t DisableUnreachableFunctions(Program& program, const std::string& entryPoint, const std::string& secondaryEntryPoint);
+
+    private:
+
+        // Marks the specified identifier as referenced.
+        void Reference(const std::string& ident);
+
+        /* ----- Visitor implementation ----- */
+
+        DECL_VISIT_PROC( CallExpr    );
+        DECL_VISIT_PROC( LiteralExpr );
+
+        /* === Members === */
+
+        // Global function declaration statements by their original identifier.
+        std::unordered_map<std::string, std::vector<Stmnt*>>   functionStmnts_;
+
+        std::unordered_set<std::string>                         referencedIdents_;
+        std::vector<std::string>                                pendingIdents_;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
\ No newline at end of file
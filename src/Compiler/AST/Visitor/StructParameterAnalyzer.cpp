@@ -31,12 +31,7 @@ void StructParameterAnalyzer::MarkStructsFromEntryPoint(Program& program, const
 
 bool StructParameterAnalyzer::NotVisited(const AST* ast)
 {
-    if (visitSet_.find(ast) == visitSet_.end())
-    {
-        visitSet_.insert(ast);
-        return true;
-    }
-    return false;
+    return visitSet_.insert(ast).second;
 }
 
 void StructParameterAnalyzer::VisitStmntList(const std::vector<StmntPtr>& stmnts)
@@ -235,11 +230,9 @@ IMPLEMENT_VISIT_PROC(CallExpr)
 
 IMPLEMENT_VISIT_PROC(ObjectExpr)
 {
-    if (NotVisited(ast))
-    {
-        Visit(ast->symbolRef);
-        VISIT_DEFAULT(ObjectExpr);
-    }
+    /* Expressions are only reached through their owners, which are already tracked in the visit set */
+    Visit(ast->symbolRef);
+    VISIT_DEFAULT(ObjectExpr);
 }
 
 #undef IMPLEMENT_VISIT_PROC
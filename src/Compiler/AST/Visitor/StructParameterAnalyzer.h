@@ -11,7 +11,7 @@
 
 #include "VisitorTracker.h"
 #include <Xsc/Targets.h>
-#include <set>
+#include <unordered_set>
 
 
 namespace Xsc
@@ -63,10 +63,10 @@ class StructParameterAnalyzer : private VisitorTracker
 
         /* === Members === */
 
-        Program*                program_        = nullptr;
-        ShaderTarget            shaderTarget_   = ShaderTarget::VertexShader;
+        Program*                        program_        = nullptr;
+        ShaderTarget                    shaderTarget_   = ShaderTarget::VertexShader;
 
-        std::set<const AST*>    visitSet_;
+        std::unordered_set<const AST*>  visitSet_;
 
 };
 
@@ -0,0 +1,112 @@
+/*
+ * AtomTable.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "AtomTable.h"
+#include "Hash.h"
+#include "Exception.h"
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+
+namespace Xsc
+{
+
+
+thread_local static AtomTable* g_activeTable = nullptr;
+
+AtomTable::AtomTable() :
+    slots_ ( 1024, nullptr )
+{
+}
+
+Atom AtomTable::Intern(const char* s, std::size_t len)
+{
+    /* Find atom or free slot with linear probing */
+    const auto mask = slots_.size() - 1;
+
+    for (auto i = HashFNV1a32(s, len) & mask; ; i = (i + 1) & mask)
+    {
+        auto& slot = slots_[i];
+
+        if (slot == nullptr)
+        {
+            /* Insert new atom, and keep the load factor below 1/2 */
+            atoms_.emplace_back(s, len);
+            slot = &(atoms_.back());
+
+            auto atom = slot;
+            if (atoms_.size() * 2 > slots_.size())
+                Grow();
+
+            return atom;
+        }
+
+        if (slot->size() == len && std::memcmp(slot->data(), s, len) == 0)
+            return slot;
+    }
+}
+
+AtomTable* AtomTable::Active()
+{
+    return g_activeTable;
+}
+
+Atom AtomTable::InternActive(const std::string& s)
+{
+    /* Identifiers must only be created within a compilation, whose atom table releases all atoms at once */
+    if (g_activeTable == nullptr)
+        RuntimeErr("missing active atom table to intern identifier '" + s + "'");
+
+    return g_activeTable->Intern(s);
+}
+
+
+
+
+/*
+ * ======= Private: =======
+ */
+
+void AtomTable::Grow()
+{
+    std::vector<Atom> slots(slots_.size() * 2, nullptr);
+    const auto mask = slots.size() - 1;
+
+    for (const auto& atom : atoms_)
+    {
+        auto i = HashFNV1a32(atom.data(), atom.size()) & mask;
+        while (slots[i] != nullptr)
+            i = (i + 1) & mask;
+        slots[i] = &atom;
+    }
+
+    slots_ = std::move(slots);
+}
+
+
+/*
+ * Scope class
+ */
+
+AtomTable::Scope::Scope(AtomTable& table) :
+    prevTable_ { g_activeTable }
+{
+    g_activeTable = &table;
+}
+
+AtomTable::Scope::~Scope()
+{
+    g_activeTable = prevTable_;
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
\ No newline at end of file
@@ -0,0 +1,98 @@
+/*
+ * AtomTable.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_ATOM_TABLE_H
+#define XSC_ATOM_TABLE_H
+
+
+#include <string>
+#include <deque>
+#include <vector>
+#include <cstddef>
+
+
+namespace Xsc
+{
+
+
+// Interned string (see AtomTable). Two atoms of the same table are equal if and only if their pointers are equal.
+using Atom = const std::string*;
+
+/*
+Table of interned strings (also referred to as "atoms") of a compilation, e.g. for identifiers (see Identifier).
+Each distinct string is stored only once, and its atom stays valid as long as the table.
+While a table is active on the current thread (see AtomTable::Scope), all identifiers are interned in that table.
+Hence, the table must outlive all identifiers that have been interned within it, and no identifier can be created while no table is active.
+*/
+class AtomTable
+{
+
+    public:
+
+        // Scope guard that activates the specified table on the current thread, and restores the previously active table on destruction.
+        class Scope
+        {
+
+            public:
+
+                Scope(AtomTable& table);
+                ~Scope();
+
+                Scope(const Scope&) = delete;
+                Scope& operator = (const Scope&) = delete;
+
+            private:
+
+                AtomTable* prevTable_ = nullptr;
+
+        };
+
+        AtomTable();
+
+        AtomTable(const AtomTable&) = delete;
+        AtomTable& operator = (const AtomTable&) = delete;
+
+        // Returns the atom of the specified string, and inserts the string into this table on first use.
+        Atom Intern(const char* s, std::size_t len);
+
+        // Returns the atom of the specified string, and inserts the string into this table on first use.
+        inline Atom Intern(const std::string& s)
+        {
+            return Intern(s.data(), s.size());
+        }
+
+        // Returns the number of atoms in this table.
+        inline std::size_t Size() const
+        {
+            return atoms_.size();
+        }
+
+        // Returns the active table of the current thread, or null if there is no active table.
+        static AtomTable* Active();
+
+        // Returns the atom of the specified string within the active table. Throws std::runtime_error if there is no active table.
+        static Atom InternActive(const std::string& s);
+
+    private:
+
+        // Doubles the number of hash slots and re-inserts all atoms.
+        void Grow();
+
+        std::deque<std::string> atoms_; // Storage of all atoms (a deque does not move its elements when it grows)
+        std::vector<Atom>       slots_; // Open addressing hash table with linear probing; the size is always a power of two
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
\ No newline at end of file
@@ -307,6 +307,7 @@ IMPLEMENT_VISIT_PROC(StructDecl)
 
         ast->localStmnts.insert(ast->localStmnts.begin(), baseMember);
         ast->varMembers.insert(ast->varMembers.begin(), baseMember);
+        ast->InvalidateMemberIndex();
     }
 
     PushStructDecl(ast);
@@ -318,7 +319,10 @@ IMPLEMENT_VISIT_PROC(StructDecl)
     PopStructDecl();
 
     if (!UseSeparateSamplers())
+    {
         RemoveSamplerStateVarDeclStmnts(ast->varMembers);
+        ast->InvalidateMemberIndex();
+    }
 
     /* Moved nested struct declarations out of the uniform buffer declaration */
     MoveNestedStructDecls(ast->localStmnts, false);
@@ -329,6 +333,7 @@ IMPLEMENT_VISIT_PROC(StructDecl)
         /* Add dummy member if the structure is empty (GLSL does not support empty structures) */
         auto dummyMember = ASTFactory::MakeVarDeclStmnt(DataType::Int, GetNameMangling().temporaryPrefix + g_stdNameDummy);
         ast->varMembers.push_back(dummyMember);
+        ast->InvalidateMemberIndex();
     }
 }
 
@@ -21,10 +21,8 @@ namespace Xsc
  * GLSLExtensionAgent class
  */
 
-GLSLExtensionAgent::GLSLExtensionAgent()
-{
-    /* Establish intrinsic-to-extension map */
-    intrinsicExtMap_ = std::map<Intrinsic, const char*>
+GLSLExtensionAgent::GLSLExtensionAgent() :
+    intrinsicExtTable_
     {
         { Intrinsic::AsDouble,                  E_GL_ARB_gpu_shader_int64         },
         { Intrinsic::AsFloat,                   E_GL_ARB_shader_bit_encoding      },
@@ -44,7 +42,8 @@ GLSLExtensionAgent::GLSLExtensionAgent()
         { Intrinsic::F16toF32,                  E_GL_ARB_shading_language_packing },
         { Intrinsic::F32toF16,                  E_GL_ARB_shading_language_packing },
         { Intrinsic::PackHalf2x16,              E_GL_ARB_shading_language_packing },
-    };
+    }
+{
 }
 
 static OutputShaderVersion GetMinGLSLVersionForTarget(const ShaderTarget shaderTarget)
@@ -312,9 +311,8 @@ IMPLEMENT_VISIT_PROC(CallExpr)
     /* Check for special intrinsics */
     if (ast->intrinsic != Intrinsic::Undefined)
     {
-        auto it = intrinsicExtMap_.find(ast->intrinsic);
-        if (it != intrinsicExtMap_.end())
-            AcquireExtension(it->second, R_Intrinsic(ast->ident), ast);
+        if (auto ext = intrinsicExtTable_.Find(ast->intrinsic))
+            AcquireExtension(*ext, R_Intrinsic(ast->ident), ast);
     }
 
     VISIT_DEFAULT(CallExpr);
@@ -12,10 +12,10 @@
 #include <Xsc/Targets.h>
 #include "Visitor.h"
 #include "ASTEnums.h"
+#include "IntrinsicTable.h"
 #include "ReportHandler.h"
 #include <set>
 #include <string>
-#include <map>
 
 
 namespace Xsc
@@ -82,8 +82,8 @@ class GLSLExtensionAgent : private Visitor
         // Resulting set of required GLSL extensions.
         std::set<std::string>               extensions_;
 
-        // Intrinsic name to GLSL extension map.
-        std::map<Intrinsic, const char*>    intrinsicExtMap_;
+        // Intrinsic to GLSL extension table.
+        IntrinsicTable<const char*>         intrinsicExtTable_;
 
 };
 
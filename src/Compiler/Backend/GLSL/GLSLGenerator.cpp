@@ -1138,9 +1138,17 @@ void GLSLGenerator::PreProcessReferenceAnalyzer(const ShaderInput& inputDesc)
 
 void GLSLGenerator::PreProcessExprConverterSecondary()
 {
-    /* Convert AST for GLSL code generation (After reference analysis) */
-    ExprConverter converter;
-    converter.Convert(*GetProgram(), ExprConverter::ConvertMatrixSubscripts, nameMangling_);
+    /*
+    Convert AST for GLSL code generation (After reference analysis).
+    The reference analyzer has collected all matrix subscripts that are reachable from the entry point,
+    so the AST only needs to be traversed again if there are any.
+    */
+    auto program = GetProgram();
+    if (!program->usedMatrixSubscripts.empty())
+    {
+        ExprConverter converter;
+        converter.Convert(*program, ExprConverter::ConvertMatrixSubscripts, nameMangling_);
+    }
 }
 
 void GLSLGenerator::PreProcessPackedUniforms()
@@ -1191,7 +1199,7 @@ void GLSLGenerator::WriteLineMark(int lineNumber)
 
 void GLSLGenerator::WriteLineMark(const TokenPtr& tkn)
 {
-    WriteLineMark(tkn->Pos().Row());
+    WriteLineMark(tkn->Row());
 }
 
 void GLSLGenerator::WriteLineMark(const AST* ast)
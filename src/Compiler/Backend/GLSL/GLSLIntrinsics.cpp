@@ -6,14 +6,14 @@
  */
 
 #include "GLSLIntrinsics.h"
-#include <map>
+#include "IntrinsicTable.h"
 
 
 namespace Xsc
 {
 
 
-static std::map<Intrinsic, std::string> GenerateIntrinsicMap()
+static IntrinsicTable<std::string> GenerateIntrinsicTable()
 {
     using T = Intrinsic;
 
@@ -262,9 +262,8 @@ static std::map<Intrinsic, std::string> GenerateIntrinsicMap()
 
 const std::string* IntrinsicToGLSLKeyword(const Intrinsic intr)
 {
-    static const auto intrinsicMap = GenerateIntrinsicMap();
-    auto it = intrinsicMap.find(intr);
-    return (it != intrinsicMap.end() ? &(it->second) : nullptr);
+    static const auto intrinsicTable = GenerateIntrinsicTable();
+    return intrinsicTable.Find(intr);
 }
 
 
@@ -13,6 +13,10 @@
 #include "Optimizer.h"
 #include "ReflectionAnalyzer.h"
 #include "ASTPrinter.h"
+#include "ASTCloner.h"
+#include "ASTSerializer.h"
+#include "AtomTable.h"
+#include "TypeContext.h"
 
 #include "GLSLPreProcessor.h"
 #include "GLSLParser.h"
@@ -24,51 +28,296 @@
 
 #include <sstream>
 #include <stdexcept>
+#include <algorithm>
+#include <iterator>
 
 
 namespace Xsc
 {
 
 
+// Returns the intrinsic adept for the language of the specified input shader version.
+static std::unique_ptr<IntrinsicAdept> MakeIntrinsicAdept(const InputShaderVersion shaderVersion)
+{
+    if (IsLanguageHLSL(shaderVersion))
+        return MakeUnique<HLSLIntrinsicAdept>();
+
+    if (IsLanguageGLSL(shaderVersion))
+    {
+        #if 0
+        return MakeUnique<GLSLIntrinsicAdept>();
+        #else //!!!
+        return MakeUnique<HLSLIntrinsicAdept>();
+        #endif
+    }
+
+    return nullptr;
+}
+
+// Returns true if the parser produces the same program for both output descriptors.
+static bool HasEqualParserOptions(const ShaderOutput& lhs, const ShaderOutput& rhs)
+{
+    return
+    (
+        lhs.options.rowMajorAlignment       == rhs.options.rowMajorAlignment        &&
+        lhs.nameMangling.inputPrefix        == rhs.nameMangling.inputPrefix         &&
+        lhs.nameMangling.outputPrefix       == rhs.nameMangling.outputPrefix        &&
+        lhs.nameMangling.reservedWordPrefix == rhs.nameMangling.reservedWordPrefix  &&
+        lhs.nameMangling.temporaryPrefix    == rhs.nameMangling.temporaryPrefix
+    );
+}
+
+// Returns true if the specified entry point can share the pre-processed input and the parsed program with other entry points.
+static bool CanShareInput(const ShaderInput& inputDesc, const ShaderOutput& outputDesc)
+{
+    return (!inputDesc.programSnapshot && !outputDesc.options.preprocessOnly && !outputDesc.options.scanDependenciesOnly);
+}
+
 Compiler::Compiler(Log* log) :
     log_ { log }
 {
 }
 
 bool Compiler::CompileShader(
-    const ShaderInput&          inputDesc,
-    const ShaderOutput&         outputDesc,
-    Reflection::ReflectionData* reflectionData,
-    StageTimePoints*            stageTimePoints)
+    const ShaderInput&              inputDesc,
+    const ShaderOutput&             outputDesc,
+    Reflection::ReflectionData*     reflectionData,
+    StageTimePoints*                stageTimePoints,
+    ResolutionCache::Statistics*    resolutionStats)
 {
     /* Make copy of output descriptor to support validation without output stream */
     std::stringstream dummyOutputStream;
 
-    auto outputDescCopy = outputDesc;
+    auto outputDescCopy = PrepareOutputDesc(inputDesc, outputDesc, dummyOutputStream);
+
+    /* Compile shader with primary function */
+    auto result = CompileShaderPrimary(inputDesc, outputDescCopy, reflectionData);
+
+    /* Copy time points and statistics to output */
+    if (stageTimePoints)
+        *stageTimePoints = timePoints_;
+    if (resolutionStats)
+        *resolutionStats = resolutionStats_;
+
+    return result;
+}
+
+bool Compiler::CompileShaders(
+    const ShaderInput&                      inputDesc,
+    const std::vector<ShaderEntryPoint>&    entryPoints,
+    std::vector<bool>*                      entryPointResults,
+    std::vector<StageTimePoints>*           stageTimePoints,
+    ResolutionCache::Statistics*            resolutionStats)
+{
+    const auto numEntryPoints = entryPoints.size();
+
+    std::vector<bool>               results(numEntryPoints, false);
+    std::vector<StageTimePoints>    timePoints(numEntryPoints);
+
+    /* Make input descriptor for each entry point, and copy output descriptors to support validation without output stream */
+    std::vector<ShaderInput>        inputDescs(numEntryPoints, inputDesc);
+    std::vector<ShaderOutput>       outputDescs(numEntryPoints);
+    std::vector<std::stringstream>  dummyOutputStreams(numEntryPoints);
 
-    if (!IsLanguageHLSL(inputDesc.shaderVersion) && !outputDesc.options.preprocessOnly)
+    std::vector<std::size_t>        sharedEntryPoints;
+    bool                            passTokenStream     = true;
+
+    for (std::size_t i = 0; i < numEntryPoints; ++i)
     {
-        Warning(R_GLSLFrontendIsIncomplete);
-        outputDescCopy.options.validateOnly = true;
+        const auto& entryPoint = entryPoints[i];
+
+        inputDescs[i].shaderTarget          = entryPoint.shaderTarget;
+        inputDescs[i].entryPoint            = entryPoint.entryPoint;
+        inputDescs[i].secondaryEntryPoint   = entryPoint.secondaryEntryPoint;
+
+        outputDescs[i] = PrepareOutputDesc(inputDescs[i], entryPoint.outputDesc, dummyOutputStreams[i]);
+
+        ValidateArguments(inputDescs[i], outputDescs[i]);
+
+        /* Entry points that only run the pre-processor or use a program snapshot can not share the pre-processed output */
+        if (CanShareInput(inputDescs[i], outputDescs[i]))
+        {
+            sharedEntryPoints.push_back(i);
+            passTokenStream = (passTokenStream && outputDescs[i].options.passTokenStream);
+        }
     }
 
-    if (outputDescCopy.options.validateOnly)
-        outputDescCopy.sourceCode = &dummyOutputStream;
+    if (!sharedEntryPoints.empty())
+    {
+        /* ----- Pre-processing (only once for all entry points) ----- */
 
-    /* Implicitly enable 'explicitBinding' option of 'autoBinding' is enabled */
-    if (outputDescCopy.options.autoBinding)
-        outputDescCopy.options.explicitBinding = true;
+        timePoints_.preprocessor = Time::now();
 
-    /* Compile shader with primary function */
-    auto result = CompileShaderPrimary(inputDesc, outputDescCopy, reflectionData);
+        auto sharedOutputDesc = outputDescs[sharedEntryPoints.front()];
+        sharedOutputDesc.options.passTokenStream = passTokenStream;
+
+        Reflection::ReflectionData  sharedReflectionData;
+        ProcessedInput              processedInput;
+
+        if (PreProcessInput(inputDesc, sharedOutputDesc, &sharedReflectionData, processedInput))
+        {
+            /* Keep the pre-processed source code in one buffer, which is referred to by the source code of each entry point */
+            std::string processedText;
+
+            if (processedInput.source)
+                processedText.assign(std::istreambuf_iterator<char>(*processedInput.source), std::istreambuf_iterator<char>());
+
+            /* Share the atom table, type context, and resolution cache between all entry points, since their programs are copies of each other */
+            AtomTable atomTable;
+            AtomTable::Scope atomTableScope(atomTable);
+
+            TypeContext typeContext;
+            TypeContext::Scope typeContextScope(typeContext);
+
+            ResolutionCache resolutionCache(resolutionStats_);
+            ResolutionCache::Scope resolutionCacheScope(resolutionCache);
+
+            auto intrinsicAdept = MakeIntrinsicAdept(inputDesc.shaderVersion);
+
+            /* Parse the input only once for all entry points with equal parser options, and analyze a copy of the parsed program for each entry point */
+            ProgramPtr          parsedProgram;
+            const ShaderOutput* parsedOutputDesc    = nullptr;
+
+            for (auto i : sharedEntryPoints)
+            {
+                /* Only the first entry point includes the duration of the pre-processor */
+                if (i != sharedEntryPoints.front())
+                    timePoints_.preprocessor = Time::now();
+
+                if (auto reflectionData = entryPoints[i].reflectionData)
+                {
+                    reflectionData->macros          = sharedReflectionData.macros;
+                    reflectionData->usedMacros      = sharedReflectionData.usedMacros;
+                    reflectionData->dependencies    = sharedReflectionData.dependencies;
+                }
+
+                /* ----- Parsing (or copying the parsed program) ----- */
+
+                timePoints_.parser = Time::now();
+
+                if (parsedOutputDesc == nullptr || !HasEqualParserOptions(*parsedOutputDesc, outputDescs[i]))
+                {
+                    SourceCodePtr processedSource;
+                    if (!processedInput.tokens)
+                        processedSource = std::make_shared<SourceCode>(processedText.data(), processedText.size());
+
+                    parsedProgram       = ParseProcessedInput(inputDescs[i], outputDescs[i], processedSource, processedInput.tokens.get());
+                    parsedOutputDesc    = &(outputDescs[i]);
+                }
+
+                if (parsedProgram)
+                {
+                    /* The last entry point can take the parsed program itself */
+                    ProgramPtr program;
+
+                    if (i == sharedEntryPoints.back())
+                        program = std::move(parsedProgram);
+                    else
+                        program = ASTCloner().Clone(*parsedProgram);
+
+                    results[i] = CompileProgram(*program, inputDescs[i], outputDescs[i], entryPoints[i].reflectionData);
+                }
+                else
+                    results[i] = ReturnWithError(R_ParsingSourceFailed);
 
-    /* Copy time points to output */
+                timePoints[i] = timePoints_;
+            }
+        }
+    }
+
+    /* Compile remaining entry points individually */
+    for (std::size_t i = 0; i < numEntryPoints; ++i)
+    {
+        if (!CanShareInput(inputDescs[i], outputDescs[i]))
+        {
+            results[i]      = CompileShaderPrimary(inputDescs[i], outputDescs[i], entryPoints[i].reflectionData);
+            timePoints[i]   = timePoints_;
+        }
+    }
+
+    /* Copy results, time points, and statistics to output */
     if (stageTimePoints)
-        *stageTimePoints = timePoints_;
+        *stageTimePoints = std::move(timePoints);
+    if (resolutionStats)
+        *resolutionStats = resolutionStats_;
+
+    const bool result = (std::find(results.begin(), results.end(), false) == results.end());
+
+    if (entryPointResults)
+        *entryPointResults = std::move(results);
 
     return result;
 }
 
+bool Compiler::AnalyzeShader(
+    const ShaderInput&  inputDesc,
+    const ShaderOutput& outputDesc,
+    ProgramState&       programState)
+{
+    /* Make copy of output descriptor to support validation without output stream */
+    std::stringstream dummyOutputStream;
+
+    auto outputDescCopy = outputDesc;
+    {
+        outputDescCopy.sourceCode                   = &dummyOutputStream;
+        outputDescCopy.options.preprocessOnly       = false;
+        outputDescCopy.options.scanDependenciesOnly = false;
+    }
+
+    ValidateArguments(inputDesc, outputDescCopy);
+
+    /* ----- Pre-processing ----- */
+
+    timePoints_.preprocessor = Time::now();
+
+    Reflection::ReflectionData  reflectionData;
+    ProcessedInput              processedInput;
+
+    if (!PreProcessInput(inputDesc, outputDescCopy, &reflectionData, processedInput))
+        return false;
+
+    programState.macros         = std::move(reflectionData.macros);
+    programState.usedMacros     = std::move(reflectionData.usedMacros);
+    programState.dependencies   = std::move(reflectionData.dependencies);
+    programState.includes       = processedInput.preProcessor->ListIncludes();
+
+    /* ----- Parsing ----- */
+
+    timePoints_.parser = Time::now();
+
+    SourceCodePtr processedSource;
+    if (processedInput.source)
+        processedSource = std::make_shared<SourceCode>(std::move(processedInput.source));
+
+    AtomTable atomTable;
+    AtomTable::Scope atomTableScope(atomTable);
+
+    TypeContext typeContext;
+    TypeContext::Scope typeContextScope(typeContext);
+
+    ResolutionCache resolutionCache(resolutionStats_);
+    ResolutionCache::Scope resolutionCacheScope(resolutionCache);
+
+    auto intrinsicAdept = MakeIntrinsicAdept(inputDesc.shaderVersion);
+
+    auto program = ParseProcessedInput(inputDesc, outputDescCopy, processedSource, processedInput.tokens.get());
+    if (!program)
+        return ReturnWithError(R_ParsingSourceFailed);
+
+    /* ----- Context analysis ----- */
+
+    if (!AnalyzeProgram(*program, inputDesc, outputDescCopy))
+        return false;
+
+    /* Serialize the analyzed program (before it is modified by the optimizer and the code generation) */
+    SnapshotWriter writer;
+    ASTSerializer().WriteProgram(*program, writer);
+
+    programState.programBuffer = writer.GetBuffer();
+
+    return true;
+}
+
 
 /*
  * ======= Private: =======
@@ -89,12 +338,35 @@ void Compiler::Warning(const std::string& msg)
 
 void Compiler::ValidateArguments(const ShaderInput& inputDesc, const ShaderOutput& outputDesc)
 {
-    if (!inputDesc.sourceCode)
+    const bool useProgramSnapshot =
+    (
+        inputDesc.programSnapshot != nullptr    &&
+        !outputDesc.options.preprocessOnly      &&
+        !outputDesc.options.scanDependenciesOnly
+    );
+
+    if (!inputDesc.sourceCode && !inputDesc.sourceCodeBuffer && !useProgramSnapshot)
         throw std::invalid_argument(R_InputStreamCantBeNull);
 
     if (!outputDesc.sourceCode)
         throw std::invalid_argument(R_OutputStreamCantBeNull);
 
+    if (auto snapshot = inputDesc.preProcessorSnapshot)
+    {
+        if (!snapshot->IsValid())
+            throw std::invalid_argument(R_InvalidPreProcessorSnapshot);
+        if (IsLanguageHLSL(GetPreProcessorState(*snapshot).shaderVersion) != IsLanguageHLSL(inputDesc.shaderVersion))
+            throw std::invalid_argument(R_PreProcessorSnapshotLangMismatch);
+    }
+
+    if (useProgramSnapshot)
+    {
+        if (!inputDesc.programSnapshot->IsValid())
+            throw std::invalid_argument(R_InvalidProgramSnapshot);
+        if (GetProgramState(*inputDesc.programSnapshot).optionsHash != ComputeProgramOptionsHash(inputDesc, outputDesc))
+            throw std::invalid_argument(R_ProgramSnapshotMismatch);
+    }
+
     const auto& nameMngl = outputDesc.nameMangling;
 
     if (nameMngl.reservedWordPrefix.empty())
@@ -132,6 +404,26 @@ void Compiler::ValidateArguments(const ShaderInput& inputDesc, const ShaderOutpu
     #endif
 }
 
+ShaderOutput Compiler::PrepareOutputDesc(const ShaderInput& inputDesc, const ShaderOutput& outputDesc, std::ostream& dummyOutputStream)
+{
+    auto outputDescCopy = outputDesc;
+
+    if (!IsLanguageHLSL(inputDesc.shaderVersion) && !outputDesc.options.preprocessOnly && !outputDesc.options.scanDependenciesOnly)
+    {
+        Warning(R_GLSLFrontendIsIncomplete);
+        outputDescCopy.options.validateOnly = true;
+    }
+
+    if (outputDescCopy.options.validateOnly || outputDescCopy.options.scanDependenciesOnly)
+        outputDescCopy.sourceCode = &dummyOutputStream;
+
+    /* Implicitly enable 'explicitBinding' option of 'autoBinding' is enabled */
+    if (outputDescCopy.options.autoBinding)
+        outputDescCopy.options.explicitBinding = true;
+
+    return outputDescCopy;
+}
+
 bool Compiler::CompileShaderPrimary(
     const ShaderInput&          inputDesc,
     const ShaderOutput&         outputDesc,
@@ -140,17 +432,49 @@ bool Compiler::CompileShaderPrimary(
     /* Validate arguments */
     ValidateArguments(inputDesc, outputDesc);
 
+    /* Skip the front-end for a program that has already been analyzed */
+    if (inputDesc.programSnapshot && !outputDesc.options.preprocessOnly && !outputDesc.options.scanDependenciesOnly)
+        return CompileProgramSnapshot(inputDesc, outputDesc, reflectionData);
+
     /* ----- Pre-processing ----- */
 
     timePoints_.preprocessor = Time::now();
 
-    std::unique_ptr<IncludeHandler> stdIncludeHandler;
+    ProcessedInput processedInput;
+
+    if (!PreProcessInput(inputDesc, outputDesc, reflectionData, processedInput))
+        return false;
+
+    if (outputDesc.options.scanDependenciesOnly)
+        return true;
+
+    if (outputDesc.options.preprocessOnly)
+    {
+        (*outputDesc.sourceCode) << processedInput.source->rdbuf();
+        return true;
+    }
+
+    /* Parse, analyze, and generate the pre-processed input */
+    SourceCodePtr processedSource;
+    if (processedInput.source)
+        processedSource = std::make_shared<SourceCode>(std::move(processedInput.source));
+
+    return CompileProcessedInput(inputDesc, outputDesc, reflectionData, processedSource, processedInput.tokens.get());
+}
+
+bool Compiler::PreProcessInput(
+    const ShaderInput&          inputDesc,
+    const ShaderOutput&         outputDesc,
+    Reflection::ReflectionData* reflectionData,
+    ProcessedInput&             processedInput)
+{
+    auto& stdIncludeHandler = processedInput.stdIncludeHandler;
     if (!inputDesc.includeHandler)
         stdIncludeHandler = std::unique_ptr<IncludeHandler>(new IncludeHandler());
 
     auto includeHandler = (inputDesc.includeHandler != nullptr ? inputDesc.includeHandler : stdIncludeHandler.get());
 
-    std::unique_ptr<PreProcessor> preProcessor;
+    auto& preProcessor = processedInput.preProcessor;
 
     if (IsLanguageHLSL(inputDesc.shaderVersion))
         preProcessor = MakeUnique<PreProcessor>(*includeHandler, log_);
@@ -160,70 +484,234 @@ bool Compiler::CompileShaderPrimary(
     const bool writeLineMarksInPP = (!outputDesc.options.preprocessOnly || outputDesc.formatting.lineMarks);
     const bool writeLineMarkFilenamesInPP = (!outputDesc.options.preprocessOnly || IsLanguageHLSL(inputDesc.shaderVersion));
 
-    auto processedInput = preProcessor->Process(
-        std::make_shared<SourceCode>(inputDesc.sourceCode),
-        inputDesc.filename,
-        writeLineMarksInPP,
-        writeLineMarkFilenamesInPP,
-        ((inputDesc.warnings & Warnings::PreProcessor) != 0)
-    );
+    /* Read input source code directly from the in-memory buffer (if specified) to avoid a copy */
+    SourceCodePtr inputSource;
 
-    if (reflectionData)
-        reflectionData->macros = preProcessor->ListDefinedMacroIdents();
+    if (inputDesc.sourceCodeBuffer)
+        inputSource = std::make_shared<SourceCode>(inputDesc.sourceCodeBuffer, inputDesc.sourceCodeBufferSize);
+    else
+        inputSource = std::make_shared<SourceCode>(inputDesc.sourceCode);
 
-    if (!processedInput)
-        return ReturnWithError(R_PreProcessingSourceFailed);
+    if (inputDesc.preProcessorSnapshot)
+        preProcessor->LoadState(GetPreProcessorState(*inputDesc.preProcessorSnapshot));
 
-    if (outputDesc.options.preprocessOnly)
+    preProcessor->DefineMacros(inputDesc.defines);
+    preProcessor->SetIncludeCache(inputDesc.includeCache);
+
+    /* Only resolve the include directives without any output for a dependency scan */
+    if (outputDesc.options.scanDependenciesOnly)
     {
-        (*outputDesc.sourceCode) << processedInput->rdbuf();
-        return true;
+        const bool result = preProcessor->ScanDependencies(
+            inputSource,
+            inputDesc.filename,
+            ((inputDesc.warnings & Warnings::PreProcessor) != 0)
+        );
+
+        if (reflectionData)
+        {
+            reflectionData->macros          = preProcessor->ListDefinedMacroIdents();
+            reflectionData->usedMacros      = preProcessor->ListUsedMacroIdents();
+            reflectionData->dependencies    = preProcessor->ListDependencies();
+        }
+
+        return (result ? true : ReturnWithError(R_PreProcessingSourceFailed));
     }
 
+    /* Either pass the token stream of the pre-processor directly to the parser, or write out the pre-processed source code */
+    if (outputDesc.options.passTokenStream && !outputDesc.options.preprocessOnly)
+    {
+        processedInput.tokens = preProcessor->ProcessTokens(
+            inputSource,
+            inputDesc.filename,
+            ((inputDesc.warnings & Warnings::PreProcessor) != 0)
+        );
+    }
+    else
+    {
+        processedInput.source = preProcessor->Process(
+            inputSource,
+            inputDesc.filename,
+            writeLineMarksInPP,
+            writeLineMarkFilenamesInPP,
+            ((inputDesc.warnings & Warnings::PreProcessor) != 0)
+        );
+    }
+
+    if (reflectionData)
+    {
+        reflectionData->macros          = preProcessor->ListDefinedMacroIdents();
+        reflectionData->usedMacros      = preProcessor->ListUsedMacroIdents();
+        reflectionData->dependencies    = preProcessor->ListDependencies();
+    }
+
+    if (!processedInput.source && !processedInput.tokens)
+        return ReturnWithError(R_PreProcessingSourceFailed);
+
+    return true;
+}
+
+bool Compiler::CompileProcessedInput(
+    const ShaderInput&          inputDesc,
+    const ShaderOutput&         outputDesc,
+    Reflection::ReflectionData* reflectionData,
+    const SourceCodePtr&        processedSource,
+    const TokenPtrString*       processedTokens)
+{
     /* ----- Parsing ----- */
 
     timePoints_.parser = Time::now();
 
-    std::unique_ptr<IntrinsicAdept> intrinsicAdpet;
-    ProgramPtr program;
+    /* Intern all identifiers of this compilation in one atom table, which must outlive the program */
+    AtomTable atomTable;
+    AtomTable::Scope atomTableScope(atomTable);
+
+    /* Share derived type denoters of equal types within this compilation */
+    TypeContext typeContext;
+    TypeContext::Scope typeContextScope(typeContext);
+
+    /* Memoize the overload resolutions of functions and intrinsics within this compilation */
+    ResolutionCache resolutionCache(resolutionStats_);
+    ResolutionCache::Scope resolutionCacheScope(resolutionCache);
+
+    auto intrinsicAdept = MakeIntrinsicAdept(inputDesc.shaderVersion);
+
+    auto program = ParseProcessedInput(inputDesc, outputDesc, processedSource, processedTokens);
+    if (!program)
+        return ReturnWithError(R_ParsingSourceFailed);
 
+    return CompileProgram(*program, inputDesc, outputDesc, reflectionData);
+}
+
+ProgramPtr Compiler::ParseProcessedInput(
+    const ShaderInput&          inputDesc,
+    const ShaderOutput&         outputDesc,
+    const SourceCodePtr&        processedSource,
+    const TokenPtrString*       processedTokens)
+{
     if (IsLanguageHLSL(inputDesc.shaderVersion))
     {
-        /* Establish intrinsic adept */
-        intrinsicAdpet = MakeUnique<HLSLIntrinsicAdept>();
-
         /* Parse HLSL input code */
         HLSLParser parser(log_);
-        program = parser.ParseSource(
-            std::make_shared<SourceCode>(std::move(processedInput)),
-            outputDesc.nameMangling,
-            inputDesc.shaderVersion,
-            outputDesc.options.rowMajorAlignment,
-            ((inputDesc.warnings & Warnings::Syntax) != 0)
-        );
+        if (processedTokens)
+        {
+            return parser.ParseTokenString(
+                *processedTokens,
+                outputDesc.nameMangling,
+                inputDesc.shaderVersion,
+                outputDesc.options.rowMajorAlignment,
+                ((inputDesc.warnings & Warnings::Syntax) != 0)
+            );
+        }
+        else
+        {
+            return parser.ParseSource(
+                processedSource,
+                outputDesc.nameMangling,
+                inputDesc.shaderVersion,
+                outputDesc.options.rowMajorAlignment,
+                ((inputDesc.warnings & Warnings::Syntax) != 0)
+            );
+        }
     }
     else if (IsLanguageGLSL(inputDesc.shaderVersion))
     {
-        /* Establish intrinsic adept */
-        #if 0
-        intrinsicAdpet = MakeUnique<GLSLIntrinsicAdept>();
-        #else //!!!
-        intrinsicAdpet = MakeUnique<HLSLIntrinsicAdept>();
-        #endif
-
         /* Parse GLSL input code */
         GLSLParser parser(log_);
-        program = parser.ParseSource(
-            std::make_shared<SourceCode>(std::move(processedInput)),
-            outputDesc.nameMangling,
-            inputDesc.shaderVersion,
-            ((inputDesc.warnings & Warnings::Syntax) != 0)
-        );
+        if (processedTokens)
+        {
+            return parser.ParseTokenString(
+                *processedTokens,
+                outputDesc.nameMangling,
+                inputDesc.shaderVersion,
+                ((inputDesc.warnings & Warnings::Syntax) != 0)
+            );
+        }
+        else
+        {
+            return parser.ParseSource(
+                processedSource,
+                outputDesc.nameMangling,
+                inputDesc.shaderVersion,
+                ((inputDesc.warnings & Warnings::Syntax) != 0)
+            );
+        }
     }
+    return nullptr;
+}
 
-    if (!program)
-        return ReturnWithError(R_ParsingSourceFailed);
+bool Compiler::CompileProgramSnapshot(
+    const ShaderInput&          inputDesc,
+    const ShaderOutput&         outputDesc,
+    Reflection::ReflectionData* reflectionData)
+{
+    const auto& programState = GetProgramState(*inputDesc.programSnapshot);
+
+    /* ----- Pre-processing (only the reflection of the pre-processor) ----- */
+
+    timePoints_.preprocessor = Time::now();
+
+    if (reflectionData)
+    {
+        reflectionData->macros          = programState.macros;
+        reflectionData->usedMacros      = programState.usedMacros;
+        reflectionData->dependencies    = programState.dependencies;
+    }
 
+    /* ----- Parsing (reading the analyzed program) ----- */
+
+    timePoints_.parser = Time::now();
+
+    AtomTable atomTable;
+    AtomTable::Scope atomTableScope(atomTable);
+
+    TypeContext typeContext;
+    TypeContext::Scope typeContextScope(typeContext);
+
+    ResolutionCache resolutionCache(resolutionStats_);
+    ResolutionCache::Scope resolutionCacheScope(resolutionCache);
+
+    auto intrinsicAdept = MakeIntrinsicAdept(inputDesc.shaderVersion);
+
+    ProgramPtr program;
+
+    try
+    {
+        SnapshotReader reader { programState.programBuffer };
+        program = ASTSerializer().ReadProgram(reader);
+    }
+    catch (const std::runtime_error&)
+    {
+        return ReturnWithError(R_InvalidProgramSnapshot);
+    }
+
+    timePoints_.analyzer = Time::now();
+
+    /* Print AST */
+    if (outputDesc.options.showAST)
+    {
+        ASTPrinter printer;
+        printer.PrintAST(program.get());
+    }
+
+    return GenerateProgram(*program, inputDesc, outputDesc, reflectionData);
+}
+
+bool Compiler::CompileProgram(
+    Program&                    program,
+    const ShaderInput&          inputDesc,
+    const ShaderOutput&         outputDesc,
+    Reflection::ReflectionData* reflectionData)
+{
+    if (!AnalyzeProgram(program, inputDesc, outputDesc))
+        return false;
+    return GenerateProgram(program, inputDesc, outputDesc, reflectionData);
+}
+
+bool Compiler::AnalyzeProgram(
+    Program&                    program,
+    const ShaderInput&          inputDesc,
+    const ShaderOutput&         outputDesc)
+{
     /* ----- Context analysis ----- */
 
     timePoints_.analyzer = Time::now();
@@ -234,26 +722,35 @@ bool Compiler::CompileShaderPrimary(
     {
         /* Analyse HLSL program */
         HLSLAnalyzer analyzer(log_);
-        analyzerResult = analyzer.DecorateAST(*program, inputDesc, outputDesc);
+        analyzerResult = analyzer.DecorateAST(program, inputDesc, outputDesc);
     }
 
     /* Print AST */
     if (outputDesc.options.showAST)
     {
         ASTPrinter printer;
-        printer.PrintAST(program.get());
+        printer.PrintAST(&program);
     }
 
     if (!analyzerResult)
         return ReturnWithError(R_AnalyzingSourceFailed);
 
+    return true;
+}
+
+bool Compiler::GenerateProgram(
+    Program&                    program,
+    const ShaderInput&          inputDesc,
+    const ShaderOutput&         outputDesc,
+    Reflection::ReflectionData* reflectionData)
+{
     /* Optimize AST */
     timePoints_.optimizer = Time::now();
 
     if (outputDesc.options.optimize)
     {
         Optimizer optimizer;
-        optimizer.Optimize(*program);
+        optimizer.Optimize(program);
     }
 
     /* ----- Code generation ----- */
@@ -266,7 +763,7 @@ bool Compiler::CompileShaderPrimary(
     {
         /* Generate GLSL output code */
         GLSLGenerator generator(log_);
-        generatorResult = generator.GenerateCode(*program, inputDesc, outputDesc, log_);
+        generatorResult = generator.GenerateCode(program, inputDesc, outputDesc, log_);
     }
 
     if (!generatorResult)
@@ -280,7 +777,7 @@ bool Compiler::CompileShaderPrimary(
     {
         ReflectionAnalyzer reflectAnalyzer(log_);
         reflectAnalyzer.Reflect(
-            *program, inputDesc.shaderTarget, *reflectionData,
+            program, inputDesc.shaderTarget, *reflectionData,
             ((inputDesc.warnings & Warnings::CodeReflection) != 0)
         );
     }
@@ -10,14 +10,23 @@
 
 
 #include <Xsc/Xsc.h>
+#include "ResolutionCache.h"
+#include "SourceCode.h"
+#include "TokenString.h"
+#include "ProgramState.h"
 #include <chrono>
 #include <array>
+#include <memory>
+#include <vector>
+#include <iostream>
 
 
 namespace Xsc
 {
 
 
+class PreProcessor;
+
 // Compiler driver class.
 class Compiler
 {
@@ -41,14 +50,40 @@ class Compiler
         Compiler(Log* log = nullptr);
 
         bool CompileShader(
-            const ShaderInput&          inputDesc,
-            const ShaderOutput&         outputDesc,
-            Reflection::ReflectionData* reflectionData  = nullptr,
-            StageTimePoints*            stageTimePoints = nullptr
+            const ShaderInput&              inputDesc,
+            const ShaderOutput&             outputDesc,
+            Reflection::ReflectionData*     reflectionData  = nullptr,
+            StageTimePoints*                stageTimePoints = nullptr,
+            ResolutionCache::Statistics*    resolutionStats = nullptr
+        );
+
+        // Compiles all entry points from the same input, which is pre-processed only once. The time points are stored for each entry point.
+        bool CompileShaders(
+            const ShaderInput&                      inputDesc,
+            const std::vector<ShaderEntryPoint>&    entryPoints,
+            std::vector<bool>*                      entryPointResults   = nullptr,
+            std::vector<StageTimePoints>*           stageTimePoints     = nullptr,
+            ResolutionCache::Statistics*            resolutionStats     = nullptr
+        );
+
+        // Pre-processes, parses, and analyzes the input, and stores the serialized program in the specified state (see ProgramSnapshot).
+        bool AnalyzeShader(
+            const ShaderInput&  inputDesc,
+            const ShaderOutput& outputDesc,
+            ProgramState&       programState
         );
 
     private:
 
+        // Pre-processed input, either as source code or as token stream. The pre-processor owns all tokens, so it must outlive the token stream.
+        struct ProcessedInput
+        {
+            std::unique_ptr<IncludeHandler>     stdIncludeHandler;
+            std::unique_ptr<PreProcessor>       preProcessor;
+            std::unique_ptr<std::iostream>      source;
+            std::unique_ptr<TokenPtrString>     tokens;
+        };
+
         /* === Functions === */
 
         bool ReturnWithError(const std::string& msg);
@@ -56,17 +91,76 @@ class Compiler
 
         void ValidateArguments(const ShaderInput& inputDesc, const ShaderOutput& outputDesc);
 
+        // Returns a copy of the output descriptor with all implicit options, and the dummy stream for output descriptors without output.
+        ShaderOutput PrepareOutputDesc(const ShaderInput& inputDesc, const ShaderOutput& outputDesc, std::ostream& dummyOutputStream);
+
         bool CompileShaderPrimary(
             const ShaderInput&          inputDesc,
             const ShaderOutput&         outputDesc,
             Reflection::ReflectionData* reflectionData
         );
 
+        // Pre-processes the input source code either into a source code stream or into a token stream (see Options::passTokenStream).
+        bool PreProcessInput(
+            const ShaderInput&          inputDesc,
+            const ShaderOutput&         outputDesc,
+            Reflection::ReflectionData* reflectionData,
+            ProcessedInput&             processedInput
+        );
+
+        // Parses, analyzes, and generates the output code of the pre-processed source code or token string.
+        bool CompileProcessedInput(
+            const ShaderInput&          inputDesc,
+            const ShaderOutput&         outputDesc,
+            Reflection::ReflectionData* reflectionData,
+            const SourceCodePtr&        processedSource,
+            const TokenPtrString*       processedTokens
+        );
+
+        // Parses the pre-processed source code or token string, or returns null if parsing failed.
+        ProgramPtr ParseProcessedInput(
+            const ShaderInput&          inputDesc,
+            const ShaderOutput&         outputDesc,
+            const SourceCodePtr&        processedSource,
+            const TokenPtrString*       processedTokens
+        );
+
+        // Optimizes and generates the output code of the analyzed program from the program snapshot of the input.
+        bool CompileProgramSnapshot(
+            const ShaderInput&          inputDesc,
+            const ShaderOutput&         outputDesc,
+            Reflection::ReflectionData* reflectionData
+        );
+
+        // Analyzes, optimizes, and generates the output code of the parsed program.
+        bool CompileProgram(
+            Program&                    program,
+            const ShaderInput&          inputDesc,
+            const ShaderOutput&         outputDesc,
+            Reflection::ReflectionData* reflectionData
+        );
+
+        // Analyzes the parsed program.
+        bool AnalyzeProgram(
+            Program&                    program,
+            const ShaderInput&          inputDesc,
+            const ShaderOutput&         outputDesc
+        );
+
+        // Optimizes, generates the output code, and reflects the analyzed program.
+        bool GenerateProgram(
+            Program&                    program,
+            const ShaderInput&          inputDesc,
+            const ShaderOutput&         outputDesc,
+            Reflection::ReflectionData* reflectionData
+        );
+
         /* === Members === */
 
-        Log*            log_        = nullptr;
+        Log*                        log_        = nullptr;
 
-        StageTimePoints timePoints_;
+        StageTimePoints             timePoints_;
+        ResolutionCache::Statistics resolutionStats_;
 
 };
 
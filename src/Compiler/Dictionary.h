@@ -9,7 +9,7 @@
 #define XSC_DICTIONARY_H
 
 
-#include <map>
+#include "PerfectHashMap.h"
 #include <string>
 #include <vector>
 #include <initializer_list>
@@ -20,7 +20,10 @@ namespace Xsc
 {
 
 
-// Bidirectional map template class, where Key = string, Value = T. 'T' must be an asceding enumerable type.
+/*
+Bidirectional map template class, where Key = string, Value = T. 'T' must be an asceding enumerable type.
+The string-to-enum direction uses a perfect hash map, so a lookup does not allocate memory and takes constant time.
+*/
 template <typename T>
 class Dictionary
 {
@@ -29,9 +32,10 @@ class Dictionary
 
         Dictionary() = default;
         Dictionary(const Dictionary&) = default;
+        Dictionary(Dictionary&&) = default;
 
         Dictionary(const std::initializer_list<std::pair<std::string, T>>& stringToEnumPairs) :
-            stringToEnum_ { stringToEnumPairs.begin(), stringToEnumPairs.end() }
+            stringToEnum_ { stringToEnumPairs }
         {
             /* Reserve container memory in advance */
             std::size_t maxIndex = 0;
@@ -39,37 +43,34 @@ class Dictionary
             for (const auto& pair : stringToEnumPairs)
                 maxIndex = std::max(maxIndex, static_cast<std::size_t>(pair.second));
 
-            enumToString_.resize(maxIndex + 1, nullptr);
+            enumToString_.resize(maxIndex + 1);
 
-            /* Insert references to strings in map */
+            /* Store first string for each enumeration entry */
             for (const auto& pair : stringToEnumPairs)
             {
                 const auto idx = static_cast<std::size_t>(pair.second);
-                if (enumToString_[idx] == nullptr)
-                {
-                    auto it = stringToEnum_.find(pair.first);
-                    if (it != stringToEnum_.end())
-                        enumToString_[idx] = &(it->first);
-                }
+                if (enumToString_[idx].empty())
+                    enumToString_[idx] = pair.first;
             }
         }
 
         // Returns a pointer to the enumeration entry which is associated to the specified string, or null on failure.
-        const T* StringToEnum(const std::string& s) const
+        inline const T* StringToEnum(const char* s, std::size_t len) const
         {
-            auto it = stringToEnum_.find(s);
-            if (it != stringToEnum_.end())
-                return &(it->second);
-            else
-                return nullptr;
+            return stringToEnum_.Find(s, len);
+        }
+
+        // Returns a pointer to the enumeration entry which is associated to the specified string, or null on failure.
+        inline const T* StringToEnum(const std::string& s) const
+        {
+            return stringToEnum_.Find(s);
         }
 
         // Returns the enumeration entry which is associated to the specified string, or the default value on failure.
         T StringToEnumOrDefault(const std::string& s, const T& defaultValue) const
         {
-            auto it = stringToEnum_.find(s);
-            if (it != stringToEnum_.end())
-                return it->second;
+            if (auto e = stringToEnum_.Find(s))
+                return *e;
             else
                 return defaultValue;
         }
@@ -78,8 +79,8 @@ class Dictionary
         const std::string* EnumToString(const T& e) const
         {
             const auto idx = static_cast<std::size_t>(e);
-            if (idx < enumToString_.size())
-                return enumToString_[idx];
+            if (idx < enumToString_.size() && !enumToString_[idx].empty())
+                return &(enumToString_[idx]);
             else
                 return nullptr;
         }
@@ -87,19 +88,16 @@ class Dictionary
         // Returns the first string which is associated to the specified enumeration entry, or the default string on failure.
         std::string EnumToStringOrDefault(const T& e, const std::string& defaultString) const
         {
-            const auto idx = static_cast<std::size_t>(e);
-            if (idx < enumToString_.size())
-            {
-                if (auto s = enumToString_[idx])
-                    return *s;
-            }
-            return defaultString;
+            if (auto s = EnumToString(e))
+                return *s;
+            else
+                return defaultString;
         }
 
     private:
 
-        std::map<std::string, T>        stringToEnum_;
-        std::vector<const std::string*> enumToString_;
+        PerfectHashMap<T>           stringToEnum_;
+        std::vector<std::string>    enumToString_;
 
 };
 
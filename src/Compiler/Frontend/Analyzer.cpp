@@ -132,13 +132,13 @@ void Analyzer::CloseScope()
     symTable_.CloseScope(std::bind(&Analyzer::OnReleaseSymbol, this, std::placeholders::_1));
 }
 
-void Analyzer::Register(const std::string& ident, AST* ast)
+void Analyzer::Register(const Identifier& ident, AST* ast)
 {
     try
     {
         /* Register symbol in global symbol table */
         symTable_.Register(
-            ident,
+            ident.FinalAtom(),
             std::make_shared<ASTSymbolOverload>(ident, ast),
             [&](ASTSymbolOverloadPtr& prevSymbol) -> bool
             {
@@ -170,7 +170,7 @@ AST* Analyzer::Fetch(const std::string& ident, const AST* ast)
             return symbol->Fetch();
 
         /* Report undefined identifier error */
-        ErrorUndeclaredIdent(ident, "", FetchSimilarIdent(ident, structDecl), ast);
+        ErrorUndeclaredIdentWithSimilar(ident, ast, structDecl);
     }
     catch (const std::exception& e)
     {
@@ -207,7 +207,7 @@ Decl* Analyzer::FetchType(const std::string& ident, const AST* ast)
         if (auto symbol = symTable_.Fetch(ident))
             return symbol->FetchType();
         else
-            ErrorUndeclaredIdent(ident, "", FetchSimilarIdent(ident), ast);
+            ErrorUndeclaredIdentWithSimilar(ident, ast);
     }
     catch (const std::exception& e)
     {
@@ -223,7 +223,7 @@ VarDecl* Analyzer::FetchVarDecl(const std::string& ident, const AST* ast)
         if (auto symbol = symTable_.Fetch(ident))
             return symbol->FetchVarDecl();
         else
-            ErrorUndeclaredIdent(ident, "", FetchSimilarIdent(ident), ast);
+            ErrorUndeclaredIdentWithSimilar(ident, ast);
     }
     catch (const std::exception& e)
     {
@@ -276,7 +276,7 @@ FunctionDecl* Analyzer::FetchFunctionDecl(const std::string& ident, const AST* a
         if (auto symbol = symTable_.Fetch(ident))
             return symbol->FetchFunctionDecl();
         else
-            ErrorUndeclaredIdent(ident, "", FetchSimilarIdent(ident), ast);
+            ErrorUndeclaredIdentWithSimilar(ident, ast);
     }
     catch (const std::exception& e)
     {
@@ -696,6 +696,15 @@ std::string Analyzer::FetchSimilarIdent(const std::string& ident, StructDecl* st
     return "";
 }
 
+void Analyzer::ErrorUndeclaredIdentWithSimilar(const std::string& ident, const AST* ast, StructDecl* structDecl)
+{
+    /* Don't search for similar identifiers if the error would be discarded anyways */
+    if (ast != nullptr && reportHandler_.HasErrorAt(ast->area))
+        return;
+
+    ErrorUndeclaredIdent(ident, "", FetchSimilarIdent(ident, structDecl), ast);
+}
+
 void Analyzer::OnReleaseSymbol(const ASTSymbolOverloadPtr& symbol)
 {
     /* Check if symbol is a local variable, that is declared but never used */
@@ -81,7 +81,7 @@ class Analyzer : protected VisitorTracker
         void CloseScope();
 
         // Registers the AST node in the current scope with the specified identifier.
-        void Register(const std::string& ident, AST* ast);
+        void Register(const Identifier& ident, AST* ast);
 
         // Tries to fetch an AST node with the specified identifier from the symbol table and reports an error on failure.
         AST* Fetch(const std::string& ident, const AST* ast = nullptr);
@@ -169,6 +169,9 @@ class Analyzer : protected VisitorTracker
         // Tries to find a similar identifier in the following order: symbol table, structure (if enabled).
         std::string FetchSimilarIdent(const std::string& ident, StructDecl* structDecl = nullptr) const;
 
+        // Reports an undeclared identifier, and only searches a similar identifier if the error is not discarded (see FetchSimilarIdent).
+        void ErrorUndeclaredIdentWithSimilar(const std::string& ident, const AST* ast, StructDecl* structDecl = nullptr);
+
         // Callback for the symbol table when a symbol is realsed from its scope.
         void OnReleaseSymbol(const ASTSymbolOverloadPtr& symbol);
 
@@ -25,14 +25,37 @@ GLSLParser::GLSLParser(Log* log) :
 
 ProgramPtr GLSLParser::ParseSource(
     const SourceCodePtr& source, const NameMangling& nameMangling, const InputShaderVersion versionIn, bool enableWarnings)
+{
+    return ParseSourceOrTokenString(source, nullptr, nameMangling, versionIn, enableWarnings);
+}
+
+ProgramPtr GLSLParser::ParseTokenString(
+    const TokenPtrString& tokenString, const NameMangling& nameMangling, const InputShaderVersion versionIn, bool enableWarnings)
+{
+    /* Tokens refer to the sources of the pre-processor, so an empty source code is only used as placeholder for the program */
+    auto source = std::make_shared<SourceCode>(std::string());
+    return ParseSourceOrTokenString(source, &tokenString, nameMangling, versionIn, enableWarnings);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+ProgramPtr GLSLParser::ParseSourceOrTokenString(
+    const SourceCodePtr& source, const TokenPtrString* tokenString, const NameMangling& nameMangling, const InputShaderVersion /*versionIn*/,
+    bool enableWarnings)
 {
     /* Copy parameters */
     EnableWarnings(enableWarnings);
 
     GetNameMangling() = nameMangling;
 
-    /* Start scanning source code */
-    PushScannerSource(source);
+    /* Start scanning source code or token string */
+    if (tokenString)
+        PushScannerTokenString(*tokenString, source);
+    else
+        PushScannerSource(source);
 
     try
     {
@@ -49,11 +72,6 @@ ProgramPtr GLSLParser::ParseSource(
     return nullptr;
 }
 
-
-/*
- * ======= Private: =======
- */
-
 ScannerPtr GLSLParser::MakeScanner()
 {
     return std::make_shared<GLSLScanner>(GetLog());
@@ -134,7 +152,7 @@ void GLSLParser::ProcessDirectiveLine()
         filename = GetScanner().Source()->Filename();
 
     /* Set new line number and filename */
-    auto currentLine = static_cast<int>(GetScanner().PreviousToken()->Pos().Row());
+    auto currentLine = static_cast<int>(GetScanner().PreviousToken()->Row());
     GetScanner().Source()->NextSourceOrigin(filename, (lineNo - currentLine - 1));
 }
 
@@ -856,6 +874,9 @@ StmntPtr GLSLParser::ParseStmntWithStructDecl()
 
         varDeclStmnt->typeSpecifier = ASTFactory::MakeTypeSpecifier(structDecl);
 
+        /* Structure is owned by the type specifier, so don't refer to the dropped declaration statement */
+        structDecl->declStmntRef = nullptr;
+
         /* Parse variable declarations */
         varDeclStmnt->varDecls = ParseVarDeclList(varDeclStmnt.get());
         Semi();
@@ -1154,7 +1175,7 @@ CallExprPtr GLSLParser::ParseCallExpr(const ObjectExprPtr& objectExpr, const Typ
     if (objectExpr)
     {
         /* Make new identifier token with source position from input */
-        auto identTkn = std::make_shared<Token>(objectExpr->area.Pos(), Tokens::Ident, objectExpr->ident);
+        auto identTkn = MakeToken(objectExpr->area.Pos(), Tokens::Ident, objectExpr->ident);
 
         /* Parse call expression and take prefix expression from input */
         return ParseCallExprWithPrefixOpt(objectExpr->prefixExpr, objectExpr->isStatic, identTkn);
@@ -75,10 +75,10 @@ bool GLSLPreProcessor::OnUndefineMacro(const Macro& macro)
 
 bool GLSLPreProcessor::OnSubstitueStdMacro(const Token& identTkn, TokenPtrString& tokenString)
 {
-    if (identTkn.Spell() == "__FILE__")
+    if (identTkn.EqualsSpell("__FILE__"))
     {
         /* Replace '__FILE__' identifier with index of current filename */
-        tokenString.PushBack(Make<Token>(Tokens::IntLiteral, "1"));
+        tokenString.PushBack(MakeToken(Tokens::IntLiteral, "1"));
         return true;
     }
     return PreProcessor::OnSubstitueStdMacro(identTkn, tokenString);
@@ -178,10 +178,10 @@ void GLSLPreProcessor::ParseDirectiveVersion()
     }
 
     /* Write out version */
-    Out() << "#version " << versionNo_;
-
-    if (!profile.empty())
-        Out() << ' ' << profile;
+    if (profile.empty())
+        WriteText("#version " + std::to_string(versionNo_));
+    else
+        WriteText("#version " + std::to_string(versionNo_) + ' ' + profile);
 
     /*
     Define standard macros: 'GL_core_profile', 'GL_es_profile', 'GL_compatibility_profile'
@@ -227,7 +227,7 @@ void GLSLPreProcessor::ParseDirectiveExtension()
         Error(R_InvalidGLSLExtensionBehavior(behavior), true, false);
 
     /* Write out extension */
-    Out() << "#extension " << extension << " : " << behavior;
+    WriteText("#extension " + extension + " : " + behavior);
 }
 
 bool GLSLPreProcessor::VerifyVersionNo(const int* validVersions) const
@@ -24,22 +24,21 @@ GLSLScanner::GLSLScanner(Log* log) :
  * ======= Private: =======
  */
 
-TokenPtr GLSLScanner::ScanIdentifierOrKeyword(std::string&& spell)
+TokenPtr GLSLScanner::ScanIdentifierOrKeyword()
 {
     /* Scan reserved words */
-    auto it = GLSLKeywords().find(spell);
-    if (it != GLSLKeywords().end())
+    if (auto type = GLSLKeywords().Find(ScannedData(), ScannedSize()))
     {
-        if (it->second == Token::Types::Reserved)
-            Error(R_KeywordReservedForFutureUse(spell));
-        else if (it->second == Token::Types::Unsupported)
-            Error(R_KeywordNotSupportedYet(spell));
+        if (*type == Token::Types::Reserved)
+            Error(R_KeywordReservedForFutureUse(ScannedSpell()));
+        else if (*type == Token::Types::Unsupported)
+            Error(R_KeywordNotSupportedYet(ScannedSpell()));
         else
-            return Make(it->second, spell);
+            return Make(*type);
     }
 
     /* Return as identifier */
-    return Make(Tokens::Ident, spell);
+    return Make(Tokens::Ident);
 }
 
 
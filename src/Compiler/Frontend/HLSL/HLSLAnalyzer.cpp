@@ -8,6 +8,7 @@
 #include "HLSLAnalyzer.h"
 #include "HLSLIntrinsics.h"
 #include "HLSLKeywords.h"
+#include "CallGraphAnalyzer.h"
 #include "Exception.h"
 #include "Helper.h"
 #include "ReportIdents.h"
@@ -59,6 +60,13 @@ void HLSLAnalyzer::DecorateASTPrimary(
     extensions_             = inputDesc.extensions;
     #endif // XSC_ENABLE_LANGUAGE_EXT
 
+    /* Skip all functions that are not reachable from the entry points */
+    if (outputDesc.options.analyzeReachableOnly)
+    {
+        CallGraphAnalyzer callGraphAnalyzer;
+        callGraphAnalyzer.DisableUnreachableFunctions(program, entryPoint_, secondaryEntryPoint_);
+    }
+
     /* Decorate program AST */
     program_ = &program;
 
@@ -878,11 +886,10 @@ void HLSLAnalyzer::AnalyzeCallExprPrimary(CallExpr* callExpr, const TypeDenoter*
         if (!callExpr->ident.empty())
         {
             /* Is this an intrinsic function call? */
-            auto intrIt = HLSLIntrinsicAdept::GetIntrinsicMap().find(callExpr->ident);
-            if (intrIt != HLSLIntrinsicAdept::GetIntrinsicMap().end())
+            if (auto intr = HLSLIntrinsicAdept::GetIntrinsicMap().Find(callExpr->ident))
             {
                 /* Analyze function call of intrinsic */
-                AnalyzeCallExprIntrinsic(callExpr, intrIt->second, callExpr->isStatic, prefixTypeDenoter);
+                AnalyzeCallExprIntrinsic(callExpr, *intr, callExpr->isStatic, prefixTypeDenoter);
             }
             else
             {
@@ -7,6 +7,9 @@
 
 #include "HLSLIntrinsics.h"
 #include "AST.h"
+#include "TypeContext.h"
+#include "ResolutionCache.h"
+#include "IntrinsicTable.h"
 #include "Helper.h"
 #include "Exception.h"
 #include "ReportIdents.h"
@@ -339,7 +342,7 @@ TypeDenoterPtr IntrinsicSignature::GetTypeDenoterWithArgs(const std::vector<Expr
         /* Return fixed base type denoter */
         const auto returnTypeFixed = IntrinsicReturnTypeToDataType(returnType);
         if (returnTypeFixed != DataType::Undefined)
-            return std::make_shared<BaseTypeDenoter>(returnTypeFixed);
+            return TypeContext::MakeBase(returnTypeFixed);
 
         /* Take type denoter from argument */
         const auto returnTypeByArgIndex = IntrinsicReturnTypeToArgIndex(returnType);
@@ -348,10 +351,10 @@ TypeDenoterPtr IntrinsicSignature::GetTypeDenoterWithArgs(const std::vector<Expr
     }
 
     /* Return default void type denoter */
-    return std::make_shared<VoidTypeDenoter>();
+    return TypeContext::MakeVoid();
 }
 
-static std::map<Intrinsic, IntrinsicSignature> GenerateIntrinsicSignatureMap()
+static IntrinsicTable<IntrinsicSignature> GenerateIntrinsicSignatureTable()
 {
     using T = Intrinsic;
     using Ret = IntrinsicReturnType;
@@ -601,7 +604,14 @@ static std::map<Intrinsic, IntrinsicSignature> GenerateIntrinsicSignatureMap()
     };
 }
 
-static const auto g_intrinsicSignatureMap = GenerateIntrinsicSignatureMap();
+static const auto g_intrinsicSignatureTable = GenerateIntrinsicSignatureTable();
+
+
+// Returns true if the return type of the specified intrinsic is derived from the type of its prefix expression (see GetIntrinsicReturnType).
+static bool IsReturnTypeDerivedFromPrefix(const Intrinsic intrinsic)
+{
+    return (IsTextureLoadIntrinsic(intrinsic) || IsTextureSampleIntrinsic(intrinsic) || IsTextureGatherIntrisic(intrinsic));
+}
 
 
 /* ----- HLSLIntrinsicAdept class ----- */
@@ -609,8 +619,12 @@ static const auto g_intrinsicSignatureMap = GenerateIntrinsicSignatureMap();
 HLSLIntrinsicAdept::HLSLIntrinsicAdept()
 {
     /* Initialize intrinsic identifiers */
-    for (const auto& it : HLSLIntrinsicAdept::GetIntrinsicMap())
-        SetIntrinsicIdent(it.second.intrinsic, it.first);
+    HLSLIntrinsicAdept::GetIntrinsicMap().ForEach(
+        [this](const std::string& ident, const HLSLIntrinsicEntry& entry)
+        {
+            SetIntrinsicIdent(entry.intrinsic, ident);
+        }
+    );
 
     /* Fill remaining identifiers (for overloaded intrinsics) */
     FillOverloadedIntrinsicIdents();
@@ -619,44 +633,21 @@ HLSLIntrinsicAdept::HLSLIntrinsicAdept()
 TypeDenoterPtr HLSLIntrinsicAdept::GetIntrinsicReturnType(
     const Intrinsic intrinsic, const std::vector<ExprPtr>& args, const TypeDenoterPtr& prefixTypeDenoter) const
 {
-    switch (intrinsic)
-    {
-        case Intrinsic::Mul:
-            return DeriveReturnTypeMul(args);
-
-        case Intrinsic::Transpose:
-            return DeriveReturnTypeTranspose(args);
-
-        case Intrinsic::Not:
-        case Intrinsic::Equal:
-        case Intrinsic::NotEqual:
-        case Intrinsic::LessThan:
-        case Intrinsic::LessThanEqual:
-        case Intrinsic::GreaterThan:
-        case Intrinsic::GreaterThanEqual:
-            return DeriveReturnTypeVectorCompare(args);
+    /* Texture intrinsics are derived from their prefix type, so only those that depend on the arguments alone are memoized */
+    auto cache = (IsReturnTypeDerivedFromPrefix(intrinsic) ? nullptr : ResolutionCache::Active());
 
-        default:
-            if (IsTextureLoadIntrinsic(intrinsic) || IsTextureSampleIntrinsic(intrinsic))
-            {
-                /* Texture SampleCmp/Sample intrinsics */
-                if (IsTextureCompareIntrinsic(intrinsic))
-                    return DeriveReturnTypeTextureSampleCmp(GetGenericTextureTypeFromPrefix(intrinsic, prefixTypeDenoter));
-                else
-                    return DeriveReturnTypeTextureSample(GetGenericTextureTypeFromPrefix(intrinsic, prefixTypeDenoter));
-            }
-            else if (IsTextureGatherIntrisic(intrinsic))
-            {
-                /* Texture GatherCmp/Gather intrinsics */
-                if (IsTextureCompareIntrinsic(intrinsic))
-                    return DeriveReturnTypeTextureGatherCmp(GetGenericTextureTypeFromPrefix(intrinsic, prefixTypeDenoter));
-                else
-                    return DeriveReturnTypeTextureGather(GetGenericTextureTypeFromPrefix(intrinsic, prefixTypeDenoter));
-            }
+    if (cache)
+    {
+        /* Find previous return type with the same argument types */
+        if (auto typeDen = cache->FindIntrinsicReturnType(intrinsic, args))
+            return typeDen;
 
-            /* Default return type derivation */
-            return DeriveReturnType(intrinsic, args);
+        auto typeDen = DeriveIntrinsicReturnType(intrinsic, args, prefixTypeDenoter);
+        cache->StoreIntrinsicReturnType(intrinsic, args, typeDen);
+        return typeDen;
     }
+
+    return DeriveIntrinsicReturnType(intrinsic, args, prefixTypeDenoter);
 }
 
 std::vector<TypeDenoterPtr> HLSLIntrinsicAdept::GetIntrinsicParameterTypes(const Intrinsic intrinsic, const std::vector<ExprPtr>& args) const
@@ -729,12 +720,54 @@ const HLSLIntrinsicsMap& HLSLIntrinsicAdept::GetIntrinsicMap()
  * ======= Private: =======
  */
 
+TypeDenoterPtr HLSLIntrinsicAdept::DeriveIntrinsicReturnType(
+    const Intrinsic intrinsic, const std::vector<ExprPtr>& args, const TypeDenoterPtr& prefixTypeDenoter) const
+{
+    switch (intrinsic)
+    {
+        case Intrinsic::Mul:
+            return DeriveReturnTypeMul(args);
+
+        case Intrinsic::Transpose:
+            return DeriveReturnTypeTranspose(args);
+
+        case Intrinsic::Not:
+        case Intrinsic::Equal:
+        case Intrinsic::NotEqual:
+        case Intrinsic::LessThan:
+        case Intrinsic::LessThanEqual:
+        case Intrinsic::GreaterThan:
+        case Intrinsic::GreaterThanEqual:
+            return DeriveReturnTypeVectorCompare(args);
+
+        default:
+            if (IsTextureLoadIntrinsic(intrinsic) || IsTextureSampleIntrinsic(intrinsic))
+            {
+                /* Texture SampleCmp/Sample intrinsics */
+                if (IsTextureCompareIntrinsic(intrinsic))
+                    return DeriveReturnTypeTextureSampleCmp(GetGenericTextureTypeFromPrefix(intrinsic, prefixTypeDenoter));
+                else
+                    return DeriveReturnTypeTextureSample(GetGenericTextureTypeFromPrefix(intrinsic, prefixTypeDenoter));
+            }
+            else if (IsTextureGatherIntrisic(intrinsic))
+            {
+                /* Texture GatherCmp/Gather intrinsics */
+                if (IsTextureCompareIntrinsic(intrinsic))
+                    return DeriveReturnTypeTextureGatherCmp(GetGenericTextureTypeFromPrefix(intrinsic, prefixTypeDenoter));
+                else
+                    return DeriveReturnTypeTextureGather(GetGenericTextureTypeFromPrefix(intrinsic, prefixTypeDenoter));
+            }
+
+            /* Default return type derivation */
+            return DeriveReturnType(intrinsic, args);
+    }
+}
+
 TypeDenoterPtr HLSLIntrinsicAdept::DeriveReturnType(const Intrinsic intrinsic, const std::vector<ExprPtr>& args) const
 {
-    /* Get type denoter from intrinsic signature map */
-    auto it = g_intrinsicSignatureMap.find(intrinsic);
-    if (it != g_intrinsicSignatureMap.end())
-        return it->second.GetTypeDenoterWithArgs(args);
+    /* Get type denoter from intrinsic signature table */
+    if (auto signature = g_intrinsicSignatureTable.Find(intrinsic))
+        return signature->GetTypeDenoterWithArgs(args);
     else
         RuntimeErr(R_FailedToDeriveIntrinsicType(GetIntrinsicIdent(intrinsic)));
 }
@@ -809,7 +842,7 @@ TypeDenoterPtr HLSLIntrinsicAdept::DeriveReturnTypeMulPrimary(const std::vector<
         if (type1->IsVector())
         {
             auto baseDataType0 = BaseDataType(static_cast<BaseTypeDenoter&>(*type0).dataType);
-            return std::make_shared<BaseTypeDenoter>(baseDataType0);
+            return TypeContext::MakeBase(baseDataType0);
         }
 
         /* Vector x Matrix = Vector */
@@ -818,7 +851,7 @@ TypeDenoterPtr HLSLIntrinsicAdept::DeriveReturnTypeMulPrimary(const std::vector<
             auto dataType1      = static_cast<BaseTypeDenoter&>(*type1).dataType;
             auto baseDataType1  = BaseDataType(dataType1);
             auto matrixTypeDim1 = MatrixTypeDim(dataType1);
-            return std::make_shared<BaseTypeDenoter>(VectorDataType(baseDataType1, matrixTypeDim1.second));
+            return TypeContext::MakeBase(VectorDataType(baseDataType1, matrixTypeDim1.second));
         }
     }
 
@@ -834,7 +867,7 @@ TypeDenoterPtr HLSLIntrinsicAdept::DeriveReturnTypeMulPrimary(const std::vector<
             auto dataType0      = static_cast<BaseTypeDenoter&>(*type0).dataType;
             auto baseDataType0  = BaseDataType(dataType0);
             auto matrixTypeDim0 = MatrixTypeDim(dataType0);
-            return std::make_shared<BaseTypeDenoter>(VectorDataType(baseDataType0, matrixTypeDim0.first));
+            return TypeContext::MakeBase(VectorDataType(baseDataType0, matrixTypeDim0.first));
         }
 
         /* Matrix x Matrix = Matrix */
@@ -850,7 +883,7 @@ TypeDenoterPtr HLSLIntrinsicAdept::DeriveReturnTypeMulPrimary(const std::vector<
             auto matrixTypeDim1 = MatrixTypeDim(dataType1);
 
             /* Return matrix type with dimension NxM */
-            return std::make_shared<BaseTypeDenoter>(MatrixDataType(baseDataType0, matrixTypeDim0.first, matrixTypeDim1.second));
+            return TypeContext::MakeBase(MatrixDataType(baseDataType0, matrixTypeDim0.first, matrixTypeDim1.second));
         }
     }
 
@@ -871,7 +904,7 @@ TypeDenoterPtr HLSLIntrinsicAdept::DeriveReturnTypeTranspose(const std::vector<E
         auto arg0DataType       = static_cast<const BaseTypeDenoter&>(arg0TypeDen).dataType;
         auto arg0BaseDataType   = BaseDataType(arg0DataType);
         auto arg0MatrixTypeDim  = MatrixTypeDim(arg0DataType);
-        return std::make_shared<BaseTypeDenoter>(MatrixDataType(arg0BaseDataType, arg0MatrixTypeDim.second, arg0MatrixTypeDim.first));
+        return TypeContext::MakeBase(MatrixDataType(arg0BaseDataType, arg0MatrixTypeDim.second, arg0MatrixTypeDim.first));
     }
 
     RuntimeErr(R_InvalidIntrinsicArgs("transpose"));
@@ -888,7 +921,7 @@ TypeDenoterPtr HLSLIntrinsicAdept::DeriveReturnTypeVectorCompare(const std::vect
     if (auto arg0BaseTypeDen = arg0TypeDen->As<BaseTypeDenoter>())
     {
         const auto vecTypeSize = VectorTypeDim(arg0BaseTypeDen->dataType);
-        return std::make_shared<BaseTypeDenoter>(VectorDataType(DataType::Bool, vecTypeSize));
+        return TypeContext::MakeBase(VectorDataType(DataType::Bool, vecTypeSize));
     }
 
     return arg0TypeDen;
@@ -905,21 +938,21 @@ TypeDenoterPtr HLSLIntrinsicAdept::DeriveReturnTypeTextureSample(const BaseTypeD
 TypeDenoterPtr HLSLIntrinsicAdept::DeriveReturnTypeTextureSampleCmp(const BaseTypeDenoterPtr& /*genericTypeDenoter*/) const
 {
     /* Always return single float type */
-    return std::make_shared<BaseTypeDenoter>(DataType::Float);
+    return TypeContext::MakeBase(DataType::Float);
 }
 
 // see https://msdn.microsoft.com/en-us/library/windows/desktop/bb944003(v=vs.85).aspx
 TypeDenoterPtr HLSLIntrinsicAdept::DeriveReturnTypeTextureGather(const BaseTypeDenoterPtr& genericTypeDenoter) const
 {
     /* Always return 4D-vector of generic data type */
-    return std::make_shared<BaseTypeDenoter>(VectorDataType(BaseDataType(genericTypeDenoter->dataType), 4));
+    return TypeContext::MakeBase(VectorDataType(BaseDataType(genericTypeDenoter->dataType), 4));
 }
 
 // see https://msdn.microsoft.com/en-us/library/windows/desktop/ff471530(v=vs.85).aspx
 TypeDenoterPtr HLSLIntrinsicAdept::DeriveReturnTypeTextureGatherCmp(const BaseTypeDenoterPtr& genericTypeDenoter) const
 {
     /* Always return 4D-vector of float type */
-    return std::make_shared<BaseTypeDenoter>(DataType::Float4);
+    return TypeContext::MakeBase(DataType::Float4);
 }
 
 /*
@@ -930,7 +963,7 @@ Currently all global intrinsics use a common type denoter for all parameters.
 void HLSLIntrinsicAdept::DeriveParameterTypes(
     std::vector<TypeDenoterPtr>& paramTypeDenoters, const Intrinsic intrinsic, const std::vector<ExprPtr>& args, bool useMinDimension) const
 {
-    /* Get type denoter from intrinsic signature map */
+    /* Get type denoter from intrinsic signature table */
     if (!args.empty() && IsGlobalIntrinsic(intrinsic))
     {
         /* Find common type denoter for all arguments */
@@ -13,7 +13,7 @@
 #include "ASTEnums.h"
 #include "ShaderVersion.h"
 #include "TypeDenoter.h"
-#include <map>
+#include "PerfectHashMap.h"
 
 
 namespace Xsc
@@ -22,17 +22,19 @@ namespace Xsc
 
 struct HLSLIntrinsicEntry
 {
+    HLSLIntrinsicEntry() = default;
+
     inline HLSLIntrinsicEntry(Intrinsic intrinsic, int major, int minor) :
         intrinsic      { intrinsic    },
         minShaderModel { major, minor }
     {
     }
 
-    Intrinsic       intrinsic;
+    Intrinsic       intrinsic       = Intrinsic::Undefined;
     ShaderVersion   minShaderModel;
 };
 
-using HLSLIntrinsicsMap = std::map<std::string, HLSLIntrinsicEntry>;
+using HLSLIntrinsicsMap = PerfectHashMap<HLSLIntrinsicEntry>;
 
 
 // IntrinsicAdept interface implementation for HLSL frontend.
@@ -58,6 +60,8 @@ class HLSLIntrinsicAdept : public IntrinsicAdept
 
     private:
 
+        TypeDenoterPtr DeriveIntrinsicReturnType(const Intrinsic intrinsic, const std::vector<ExprPtr>& args, const TypeDenoterPtr& prefixTypeDenoter) const;
+
         TypeDenoterPtr DeriveReturnType(const Intrinsic intrinsic, const std::vector<ExprPtr>& args) const;
         TypeDenoterPtr DeriveReturnTypeMul(const std::vector<ExprPtr>& args) const;
         TypeDenoterPtr DeriveReturnTypeMulPrimary(const std::vector<ExprPtr>& args, const TypeDenoterPtr& type0, const TypeDenoterPtr& type1) const;
@@ -10,7 +10,8 @@
 #include "Helper.h"
 #include "ReportIdents.h"
 #include "Exception.h"
-#include "CiString.h"
+#include "PerfectHashMap.h"
+#include <cstdlib>
 
 
 namespace Xsc
@@ -21,16 +22,6 @@ namespace Xsc
  * Internal functions
  */
 
-template <typename T>
-T MapKeywordToType(const std::map<std::string, T>& typeMap, const std::string& keyword, const std::string& typeName)
-{
-    auto it = typeMap.find(keyword);
-    if (it != typeMap.end())
-        return it->second;
-    else
-        RuntimeErr(R_FailedToMapFromHLSLKeyword(keyword, typeName));
-}
-
 template <typename T>
 T MapKeywordToType(const Dictionary<T>& typeDict, const std::string& keyword, const std::string& typeName)
 {
@@ -974,44 +965,45 @@ AttributeValue HLSLKeywordToAttributeValue(const std::string& keyword)
 
 struct HLSLSemanticDescriptor
 {
+    HLSLSemanticDescriptor() = default;
+
     inline HLSLSemanticDescriptor(const Semantic semantic, bool hasIndex = false) :
         semantic { semantic },
         hasIndex { hasIndex }
     {
     }
 
-    Semantic    semantic;
+    Semantic    semantic    = Semantic::Undefined;
     bool        hasIndex    = false;
 };
 
-using HLSLSemanticMap = std::vector<std::pair<CiString, HLSLSemanticDescriptor>>;
+using HLSLSemanticMap = CiPerfectHashMap<HLSLSemanticDescriptor>;
 
-static IndexedSemantic HLSLKeywordToSemanticWithMap(const CiString& ident, const HLSLSemanticMap& semanticMap)
+static IndexedSemantic HLSLKeywordToSemanticWithMap(const std::string& ident, const HLSLSemanticMap& semanticMap)
 {
-    for (const auto& s : semanticMap)
+    /* Split identifier into semantic name and optional index (e.g. "COLOR0" -> "COLOR" and 0) */
+    auto nameLen = ident.size();
+    while (nameLen > 0 && std::isdigit(static_cast<unsigned char>(ident[nameLen - 1])))
+        --nameLen;
+
+    /* Find semantic with index */
+    if (nameLen < ident.size())
     {
-        if (s.second.hasIndex)
+        if (auto s = semanticMap.Find(ident.data(), nameLen))
         {
-            /* Does the identifier equal the semantic name without the index? */
-            if (ident.size() >= s.first.size() && ident.compare(0, s.first.size(), s.first) == 0)
-            {
-                /* Is identifier longer than semantic name? */
-                if (ident.size() > s.first.size())
-                {
-                    /* Return semantic with index */
-                    auto index = std::stoi(ident.substr(s.first.size()).c_str());
-                    return { s.second.semantic, index };
-                }
-                return s.second.semantic;
-            }
+            if (s->hasIndex)
+                return { s->semantic, std::atoi(ident.c_str() + nameLen) };
         }
-        else if (ident == s.first)
-            return s.second.semantic;
     }
-    return IndexedSemantic(std::string(ident.begin(), ident.end()));
+
+    /* Find semantic without index */
+    if (auto s = semanticMap.Find(ident))
+        return s->semantic;
+
+    return IndexedSemantic(ident);
 }
 
-static IndexedSemantic HLSLKeywordToSemanticD3D9(const CiString& ident)
+static IndexedSemantic HLSLKeywordToSemanticD3D9(const std::string& ident)
 {
     using T = Semantic;
 
@@ -1031,10 +1023,10 @@ static IndexedSemantic HLSLKeywordToSemanticD3D9(const CiString& ident)
     if (ident.size() >= 4)
         return HLSLKeywordToSemanticWithMap(ident, semanticMap);
     else
-        return IndexedSemantic(std::string(ident.begin(), ident.end()));
+        return IndexedSemantic(ident);
 }
 
-static IndexedSemantic HLSLKeywordToSemanticD3D10(const CiString& ident)
+static IndexedSemantic HLSLKeywordToSemanticD3D10(const std::string& ident)
 {
     using T = Semantic;
 
@@ -1070,23 +1062,23 @@ static IndexedSemantic HLSLKeywordToSemanticD3D10(const CiString& ident)
     };
 
     /* Has identifier at the the length of the shortest semantic? */
-    if (ident.size() >= 4 && ident.compare(0, 3, "SV_") == 0)
+    if (ident.size() >= 4 && PerfectHashCaseInsensitive::Equals(ident.data(), "SV_", 3))
     {
         auto semantic = HLSLKeywordToSemanticWithMap(ident, semanticMap);
         if (semantic.IsUserDefined())
-            RuntimeErr(R_InvalidSystemValueSemantic(std::string(ident.begin(), ident.end())));
+            RuntimeErr(R_InvalidSystemValueSemantic(ident));
         return semantic;
     }
     else
-        return IndexedSemantic(std::string(ident.begin(), ident.end()));
+        return IndexedSemantic(ident);
 }
 
 IndexedSemantic HLSLKeywordToSemantic(const std::string& ident, bool useD3D10Semantics)
 {
     if (useD3D10Semantics)
-        return HLSLKeywordToSemanticD3D10(ToCiString(ident));
+        return HLSLKeywordToSemanticD3D10(ident);
     else
-        return HLSLKeywordToSemanticD3D9(ToCiString(ident));
+        return HLSLKeywordToSemanticD3D9(ident);
 }
 
 #ifdef XSC_ENABLE_LANGUAGE_EXT
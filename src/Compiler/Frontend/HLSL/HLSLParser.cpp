@@ -42,6 +42,26 @@ HLSLParser::HLSLParser(Log* log) :
 
 ProgramPtr HLSLParser::ParseSource(
     const SourceCodePtr& source, const NameMangling& nameMangling, const InputShaderVersion versionIn, bool rowMajorAlignment, bool enableWarnings)
+{
+    return ParseSourceOrTokenString(source, nullptr, nameMangling, versionIn, rowMajorAlignment, enableWarnings);
+}
+
+ProgramPtr HLSLParser::ParseTokenString(
+    const TokenPtrString& tokenString, const NameMangling& nameMangling, const InputShaderVersion versionIn, bool rowMajorAlignment, bool enableWarnings)
+{
+    /* Tokens refer to the sources of the pre-processor, so an empty source code is only used as placeholder for the program */
+    auto source = std::make_shared<SourceCode>(std::string());
+    return ParseSourceOrTokenString(source, &tokenString, nameMangling, versionIn, rowMajorAlignment, enableWarnings);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+ProgramPtr HLSLParser::ParseSourceOrTokenString(
+    const SourceCodePtr& source, const TokenPtrString* tokenString, const NameMangling& nameMangling, const InputShaderVersion versionIn,
+    bool rowMajorAlignment, bool enableWarnings)
 {
     /* Copy parameters */
     useD3D10Semantics_  = (versionIn >= InputShaderVersion::HLSL4);
@@ -52,8 +72,11 @@ ProgramPtr HLSLParser::ParseSource(
 
     GetNameMangling() = nameMangling;
 
-    /* Start scanning source code */
-    PushScannerSource(source);
+    /* Start scanning source code or token string */
+    if (tokenString)
+        PushScannerTokenString(*tokenString, source);
+    else
+        PushScannerSource(source);
 
     try
     {
@@ -70,11 +93,6 @@ ProgramPtr HLSLParser::ParseSource(
     return nullptr;
 }
 
-
-/*
- * ======= Private: =======
- */
-
 ScannerPtr HLSLParser::MakeScanner()
 {
     return std::make_shared<HLSLScanner>(enableCgKeywords_, GetLog());
@@ -175,14 +193,14 @@ void HLSLParser::ProcessDirectiveLine()
         filename = GetScanner().Source()->Filename();
 
     /* Set new line number and filename */
-    auto currentLine = static_cast<int>(GetScanner().PreviousToken()->Pos().Row());
+    auto currentLine = static_cast<int>(GetScanner().PreviousToken()->Row());
     GetScanner().Source()->NextSourceOrigin(filename, (lineNo - currentLine - 1));
 }
 
 void HLSLParser::ProcessDirectivePragma()
 {
     /* Parse 'pack_matrix' pragma */
-    if (Is(Tokens::Ident) && Tkn()->Spell() == "pack_matrix")
+    if (Is(Tokens::Ident) && Tkn()->EqualsSpell("pack_matrix"))
     {
         Parser::AcceptIt();
 
@@ -493,7 +511,7 @@ RegisterPtr HLSLParser::ParseRegister(bool parseColon)
     }
 
     /* Set area offset to register type character */
-    ast->area.Offset(GetScanner().PreviousToken()->Pos());
+    ast->area.Offset(*GetScanner().PreviousToken());
 
     /* Get register type and slot index from type identifier */
     ast->registerType = CharToRegisterType(typeIdent.front());
@@ -1125,6 +1143,9 @@ StmntPtr HLSLParser::ParseStmntWithStructDecl()
 
         varDeclStmnt->typeSpecifier = ASTFactory::MakeTypeSpecifier(structDecl);
 
+        /* Structure is owned by the type specifier, so don't refer to the dropped declaration statement */
+        structDecl->declStmntRef = nullptr;
+
         /* Parse variable declarations */
         varDeclStmnt->varDecls = ParseVarDeclList(varDeclStmnt.get());
         Semi();
@@ -1491,7 +1512,7 @@ CallExprPtr HLSLParser::ParseCallExpr(const ObjectExprPtr& objectExpr, const Typ
     if (objectExpr)
     {
         /* Make new identifier token with source position from input */
-        auto identTkn = std::make_shared<Token>(objectExpr->area.Pos(), Tokens::Ident, objectExpr->ident);
+        auto identTkn = MakeToken(objectExpr->area.Pos(), Tokens::Ident, objectExpr->ident);
 
         /* Parse call expression and take prefix expression from input */
         return ParseCallExprWithPrefixOpt(objectExpr->prefixExpr, objectExpr->isStatic, identTkn);
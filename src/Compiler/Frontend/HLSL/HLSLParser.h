@@ -35,10 +35,28 @@ class HLSLParser : public SLParser
             bool                        enableWarnings      = false
         );
 
+        // Parses the token string that has been handed over from the pre-processor (see PreProcessor::ProcessTokens).
+        ProgramPtr ParseTokenString(
+            const TokenPtrString&       tokenString,
+            const NameMangling&         nameMangling,
+            const InputShaderVersion    versionIn,
+            bool                        rowMajorAlignment   = false,
+            bool                        enableWarnings      = false
+        );
+
     private:
 
         /* === Functions === */
 
+        ProgramPtr ParseSourceOrTokenString(
+            const SourceCodePtr&        source,
+            const TokenPtrString*       tokenString,
+            const NameMangling&         nameMangling,
+            const InputShaderVersion    versionIn,
+            bool                        rowMajorAlignment,
+            bool                        enableWarnings
+        );
+
         ScannerPtr MakeScanner() override;
 
         // Returns true if the current token is a data type.
@@ -25,30 +25,28 @@ HLSLScanner::HLSLScanner(bool enableCgKeywords, Log* log) :
  * ======= Private: =======
  */
 
-TokenPtr HLSLScanner::ScanIdentifierOrKeyword(std::string&& spell)
+TokenPtr HLSLScanner::ScanIdentifierOrKeyword()
 {
     /* Scan reserved words */
-    auto it = HLSLKeywords().find(spell);
-    if (it != HLSLKeywords().end())
+    if (auto type = HLSLKeywords().Find(ScannedData(), ScannedSize()))
     {
-        if (it->second == Token::Types::Reserved)
-            Error(R_KeywordReservedForFutureUse(spell));
-        else if (it->second == Token::Types::Unsupported)
-            Error(R_KeywordNotSupportedYet(spell));
+        if (*type == Token::Types::Reserved)
+            Error(R_KeywordReservedForFutureUse(ScannedSpell()));
+        else if (*type == Token::Types::Unsupported)
+            Error(R_KeywordNotSupportedYet(ScannedSpell()));
         else
-            return Make(it->second, spell);
+            return Make(*type);
     }
 
     /* Scan reserved extended words (if Cg keywords are enabled) */
     if (enableCgKeywords_)
     {
-        auto it = HLSLKeywordsExtCg().find(spell);
-        if (it != HLSLKeywordsExtCg().end())
-            return Make(it->second, spell);
+        if (auto type = HLSLKeywordsExtCg().Find(ScannedData(), ScannedSize()))
+            return Make(*type);
     }
 
     /* Return as identifier */
-    return Make(Tokens::Ident, spell);
+    return Make(Tokens::Ident);
 }
 
 
@@ -26,7 +26,7 @@ class HLSLScanner : public SLScanner
 
     private:
 
-        TokenPtr ScanIdentifierOrKeyword(std::string&& spell) override;
+        TokenPtr ScanIdentifierOrKeyword() override;
 
         /* === Members === */
 
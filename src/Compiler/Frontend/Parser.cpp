@@ -131,7 +131,7 @@ void Parser::PushScannerSource(const SourceCodePtr& source, const std::string& f
     scannerStack_.push({ scanner, filename, nullptr });
 
     /* Start scanning */
-    if (!scanner->ScanSource(source))
+    if (!scanner->ScanSource(source, tokenArena_))
         RuntimeErr(R_FailedToScanSource);
 
     /* Set initial source origin for scanner */
@@ -141,6 +141,27 @@ void Parser::PushScannerSource(const SourceCodePtr& source, const std::string& f
     AcceptIt();
 }
 
+void Parser::PushScannerTokenString(const TokenPtrString& tokenString, const SourceCodePtr& source)
+{
+    /* Add current token to previous scanner */
+    if (!scannerStack_.empty())
+        scannerStack_.top().nextToken = tkn_;
+
+    /* Make a new token scanner */
+    auto scanner = MakeScanner();
+    if (!scanner)
+        RuntimeErr(R_FailedToCreateScanner);
+
+    scannerStack_.push({ scanner, "", nullptr });
+
+    /* Start scanning (the tokens already refer to their original source origins) */
+    if (!scanner->ScanTokenString(tokenString, source, tokenArena_))
+        RuntimeErr(R_FailedToScanSource);
+
+    /* Accept first token */
+    AcceptIt();
+}
+
 bool Parser::PopScannerSource()
 {
     /* Get previous scanner */
@@ -417,6 +438,16 @@ const std::string* Parser::FindNameManglingPrefix(const std::string& ident) cons
     return nullptr;
 }
 
+TokenPtr Parser::MakeToken(const Tokens type, const std::string& spell)
+{
+    return tokenArena_.MakeToken(GetScanner().Pos(), type, spell);
+}
+
+TokenPtr Parser::MakeToken(const SourcePosition& pos, const Tokens type, const std::string& spell)
+{
+    return tokenArena_.MakeToken(pos, type, spell);
+}
+
 
 /*
  * ======= Private: =======
@@ -481,7 +512,7 @@ void Parser::AssertTokenType(const Tokens type)
 void Parser::AssertTokenSpell(const std::string& spell)
 {
     /* Check if token spelling is unexpected */
-    while (tkn_->Spell() != spell)
+    while (!tkn_->EqualsSpell(spell))
     {
         /* Increment unexpected token counter */
         IncUnexpectedTokenCounter();
@@ -499,4 +530,4 @@ void Parser::AssertTokenSpell(const std::string& spell)
 
 
 
-// ================================================================================
+// ================================================================================
\ No newline at end of file
@@ -74,6 +74,9 @@ class Parser
         virtual void PushScannerSource(const SourceCodePtr& source, const std::string& filename = "");
         virtual bool PopScannerSource();
 
+        // Pushes a new scanner for the token string of the pre-processor (see Scanner::ScanTokenString).
+        void PushScannerTokenString(const TokenPtrString& tokenString, const SourceCodePtr& source);
+
         ParsingState ActiveParsingState() const;
 
         // Returns the current token scanner.
@@ -119,7 +122,7 @@ class Parser
         template <typename T>
         const T& UpdateSourceAreaOffset(const T& ast)
         {
-            ast->area.Offset(GetScanner().PreviousToken()->Pos());
+            ast->area.Offset(*GetScanner().PreviousToken());
             return ast;
         }
 
@@ -188,6 +191,18 @@ class Parser
             return std::make_shared<T>(GetScanner().Pos(), std::forward<Args>(args)...);
         }
 
+        // Makes a new token at the current scanner position, which is owned by the token arena of this parser.
+        TokenPtr MakeToken(const Tokens type, const std::string& spell);
+
+        // Makes a new token at the specified source position, which is owned by the token arena of this parser.
+        TokenPtr MakeToken(const SourcePosition& pos, const Tokens type, const std::string& spell);
+
+        // Returns the token arena of this parser.
+        inline TokenArena& GetTokenArena()
+        {
+            return tokenArena_;
+        }
+
         // Returns the current token.
         inline const TokenPtr& Tkn() const
         {
@@ -209,7 +224,7 @@ class Parser
         // Returns true if the next token is from the specified type and has the specified spelling.
         inline bool Is(const Tokens type, const std::string& spell) const
         {
-            return (TknType() == type && Tkn()->Spell() == spell);
+            return (TknType() == type && Tkn()->EqualsSpell(spell));
         }
 
     private:
@@ -239,6 +254,8 @@ class Parser
         NameMangling                    nameMangling_;
 
         Log*                            log_                    = nullptr;
+
+        TokenArena                      tokenArena_;            // Owns all tokens of this parser; must outlive all token references.
         TokenPtr                        tkn_;
 
         std::stack<ScannerStackEntry>   scannerStack_;
@@ -260,4 +277,4 @@ class Parser
 
 
 
-// ================================================================================
+// ================================================================================
\ No newline at end of file
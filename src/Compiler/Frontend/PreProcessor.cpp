@@ -13,6 +13,8 @@
 #include "ReportIdents.h"
 #include "Exception.h"
 #include <sstream>
+#include <typeinfo>
+#include <cctype>
 
 
 namespace Xsc
@@ -29,25 +31,129 @@ std::unique_ptr<std::iostream> PreProcessor::Process(
     const SourceCodePtr& input, const std::string& filename, bool writeLineMarks, bool writeLineMarkFilenames, bool enableWarnings)
 {
     output_                 = MakeUnique<std::stringstream>();
+    outputTokens_.reset();
     writeLineMarks_         = writeLineMarks;
     writeLineMarkFilenames_ = writeLineMarkFilenames;
+    scanDependenciesOnly_   = false;
 
-    EnableWarnings(enableWarnings);
+    if (ProcessInput(input, filename, enableWarnings))
+        return std::move(output_);
 
-    PushScannerSource(input, filename);
+    return nullptr;
+}
 
-    try
+std::unique_ptr<TokenPtrString> PreProcessor::ProcessTokens(
+    const SourceCodePtr& input, const std::string& filename, bool enableWarnings)
+{
+    output_.reset();
+    outputTokens_           = MakeUnique<TokenPtrString>();
+    writeLineMarks_         = false;
+    writeLineMarkFilenames_ = false;
+    scanDependenciesOnly_   = false;
+
+    if (ProcessInput(input, filename, enableWarnings))
+        return std::move(outputTokens_);
+
+    return nullptr;
+}
+
+bool PreProcessor::ScanDependencies(const SourceCodePtr& input, const std::string& filename, bool enableWarnings)
+{
+    output_.reset();
+    outputTokens_.reset();
+    writeLineMarks_         = false;
+    writeLineMarkFilenames_ = false;
+    scanDependenciesOnly_   = true;
+
+    return ProcessInput(input, filename, enableWarnings);
+}
+
+// Returns true if the specified string is a valid identifier for a macro or macro parameter.
+static bool IsValidMacroIdent(const std::string& ident)
+{
+    if (ident.empty() || std::isdigit(static_cast<unsigned char>(ident.front())))
+        return false;
+
+    for (auto chr : ident)
     {
-        ParseProgram();
-        return (GetReportHandler().HasErrors() ? nullptr : std::move(output_));
+        if (!std::isalnum(static_cast<unsigned char>(chr)) && chr != '_')
+            return false;
     }
-    catch (const Report& err)
+
+    return true;
+}
+
+void PreProcessor::DefineMacros(const std::vector<PredefinedMacro>& macros)
+{
+    for (const auto& predefinedMacro : macros)
     {
-        if (GetLog())
-            GetLog()->SubmitReport(err);
+        Macro macro;
+
+        /* Split identifier and optional parameter list, e.g. "MAX(a, b)" */
+        auto ident = predefinedMacro.ident;
+        auto paramListStart = ident.find('(');
+
+        if (paramListStart != std::string::npos)
+        {
+            if (ident.back() != ')')
+                throw std::invalid_argument(R_InvalidPredefinedMacro(predefinedMacro.ident));
+
+            const auto paramList = ident.substr(paramListStart + 1, ident.size() - paramListStart - 2);
+            ident = ident.substr(0, paramListStart);
+
+            /* Parse comma separated parameter identifiers or variadic argument specifier (i.e. IDENT or '...') */
+            if (paramList.find_first_not_of(" \t") != std::string::npos)
+            {
+                std::size_t start = 0;
+                while (start <= paramList.size())
+                {
+                    auto end = paramList.find(',', start);
+                    if (end == std::string::npos)
+                        end = paramList.size();
+
+                    const auto first = paramList.find_first_not_of(" \t", start);
+                    const auto last = paramList.find_last_not_of(" \t", end - 1);
+
+                    if (first >= end || macro.varArgs)
+                        throw std::invalid_argument(R_InvalidPredefinedMacro(predefinedMacro.ident));
+
+                    const auto paramIdent = paramList.substr(first, last - first + 1);
+
+                    if (paramIdent == "...")
+                        macro.varArgs = true;
+                    else if (IsValidMacroIdent(paramIdent))
+                        macro.parameters.push_back(paramIdent);
+                    else
+                        throw std::invalid_argument(R_InvalidPredefinedMacro(predefinedMacro.ident));
+
+                    start = end + 1;
+                }
+            }
+
+            if (macro.parameters.empty())
+                macro.emptyParamList = true;
+        }
+
+        if (!IsValidMacroIdent(ident))
+            throw std::invalid_argument(R_InvalidPredefinedMacro(predefinedMacro.ident));
+
+        /* Scan macro value and register symbol as new macro */
+        macro.identTkn      = MakeToken(SourcePosition::ignore, Tokens::Ident, ident);
+        macro.tokenString   = ScanMacroValue(predefinedMacro.value);
+
+        DefineMacro(macro);
     }
+}
 
-    return nullptr;
+void PreProcessor::SetIncludeCache(IncludeCache* includeCache)
+{
+    includeCache_ = (IsIncludeCacheCompatible(includeHandler_) ? includeCache : nullptr);
+}
+
+bool PreProcessor::IsIncludeCacheCompatible(const IncludeHandler& includeHandler)
+{
+    /* A derived include handler may override 'Include' to read files from anywhere else */
+    return (typeid(includeHandler) == typeid(IncludeHandler));
 }
 
 std::vector<std::string> PreProcessor::ListDefinedMacroIdents() const
@@ -61,6 +167,175 @@ std::vector<std::string> PreProcessor::ListDefinedMacroIdents() const
     return idents;
 }
 
+std::vector<std::string> PreProcessor::ListUsedMacroIdents() const
+{
+    return std::vector<std::string>(usedMacros_.begin(), usedMacros_.end());
+}
+
+std::vector<std::string> PreProcessor::ListDependencies() const
+{
+    std::vector<std::string> dependencies;
+    std::set<std::string> uniqueDependencies;
+
+    auto AppendDependencies = [&](const std::vector<IncludedFile>& files)
+    {
+        for (const auto& file : files)
+        {
+            /* Resolve path the same way the default include handler does, but keep the filename if it can not be found */
+            auto path = includeHandler_.FindFile(file.filename, file.useSearchPaths);
+            if (path.empty())
+                path = file.filename;
+
+            if (uniqueDependencies.insert(path).second)
+                dependencies.push_back(path);
+        }
+    };
+
+    AppendDependencies(loadedStateIncludes_);
+    AppendDependencies(includedFiles_);
+
+    return dependencies;
+}
+
+std::vector<PreProcessorState::IncludeDesc> PreProcessor::ListIncludes() const
+{
+    std::vector<PreProcessorState::IncludeDesc> includes;
+    includes.reserve(includedFiles_.size());
+
+    for (const auto& file : includedFiles_)
+    {
+        PreProcessorState::IncludeDesc includeDesc;
+        {
+            includeDesc.filename        = file.filename;
+            includeDesc.useSearchPaths  = file.useSearchPaths;
+            includeDesc.contentHash     = HashFNV1a64(file.source->Data(), file.source->Size());
+        }
+        includes.push_back(std::move(includeDesc));
+    }
+
+    return includes;
+}
+
+// Returns the description of the specified token, and appends its source origin to the list (if not already present).
+static PreProcessorState::TokenDesc MakeTokenDesc(
+    const Token& tkn, std::vector<PreProcessorState::Origin>& origins, std::map<const SourceOrigin*, std::uint32_t>& originIndices)
+{
+    PreProcessorState::TokenDesc desc;
+    {
+        desc.type   = tkn.Type();
+        desc.spell  = tkn.Spell();
+        desc.row    = tkn.Row();
+        desc.column = tkn.Column();
+
+        if (auto origin = tkn.Origin())
+        {
+            auto& index = originIndices[origin];
+            if (index == 0)
+            {
+                origins.push_back({ origin->filename, origin->lineOffset });
+                index = static_cast<std::uint32_t>(origins.size());
+            }
+            desc.origin = index;
+        }
+    }
+    return desc;
+}
+
+void PreProcessor::SaveState(PreProcessorState& state, const TokenPtrString* output) const
+{
+    std::map<const SourceOrigin*, std::uint32_t> originIndices;
+
+    /* Store macros with their token strings */
+    for (const auto& it : macros_)
+    {
+        const auto& macro = *it.second;
+
+        PreProcessorState::MacroDesc macroDesc;
+        {
+            macroDesc.identTkn = MakeTokenDesc(*macro.identTkn, state.origins, originIndices);
+
+            for (const auto& tkn : macro.tokenString.GetTokens())
+                macroDesc.tokenString.push_back(MakeTokenDesc(*tkn, state.origins, originIndices));
+
+            macroDesc.parameters        = macro.parameters;
+            macroDesc.varArgs           = macro.varArgs;
+            macroDesc.stdMacro          = macro.stdMacro;
+            macroDesc.emptyParamList    = macro.emptyParamList;
+        }
+        state.macros.push_back(std::move(macroDesc));
+    }
+
+    /* Store include states */
+    state.onceIncluded.assign(onceIncluded_.begin(), onceIncluded_.end());
+    state.includeGuards.assign(includeGuards_.begin(), includeGuards_.end());
+    state.includeCounter.assign(includeCounter_.begin(), includeCounter_.end());
+
+    state.includes = ListIncludes();
+
+    /* Store pre-processed output */
+    if (output)
+    {
+        for (const auto& tkn : output->GetTokens())
+            state.output.push_back(MakeTokenDesc(*tkn, state.origins, originIndices));
+    }
+}
+
+void PreProcessor::LoadState(const PreProcessorState& state)
+{
+    /* Create source origins for all tokens */
+    std::vector<SourceOriginPtr> origins;
+    origins.reserve(state.origins.size());
+
+    for (const auto& origin : state.origins)
+    {
+        auto sourceOrigin = std::make_shared<SourceOrigin>();
+        {
+            sourceOrigin->filename      = origin.filename;
+            sourceOrigin->lineOffset    = origin.lineOffset;
+        }
+        origins.push_back(sourceOrigin);
+    }
+
+    auto MakeTokenFromDesc = [&](const PreProcessorState::TokenDesc& desc) -> TokenPtr
+    {
+        const auto& origin = (desc.origin > 0 && desc.origin <= origins.size() ? origins[desc.origin - 1] : nullptr);
+        return GetTokenArena().MakeToken(SourcePosition(desc.row, desc.column, origin), desc.type, desc.spell);
+    };
+
+    /* Load macros (previous definitions are replaced without any redefinition checks) */
+    for (const auto& macroDesc : state.macros)
+    {
+        TokenPtrString tokenString;
+        for (const auto& tknDesc : macroDesc.tokenString)
+            tokenString.PushBack(MakeTokenFromDesc(tknDesc));
+
+        macros_[macroDesc.identTkn.spell] = std::make_shared<Macro>(
+            MakeTokenFromDesc(macroDesc.identTkn),
+            tokenString,
+            macroDesc.parameters,
+            macroDesc.varArgs,
+            macroDesc.stdMacro,
+            macroDesc.emptyParamList
+        );
+    }
+
+    /* Load include states */
+    onceIncluded_.insert(state.onceIncluded.begin(), state.onceIncluded.end());
+
+    for (const auto& includeGuard : state.includeGuards)
+        includeGuards_[includeGuard.first] = includeGuard.second;
+
+    for (const auto& counter : state.includeCounter)
+        includeCounter_[counter.first] = counter.second;
+
+    for (const auto& include : state.includes)
+        loadedStateIncludes_.push_back({ include.filename, include.useSearchPaths, nullptr });
+
+    /* Load pre-processed output */
+    for (const auto& tknDesc : state.output)
+        loadedStateOutput_.PushBack(MakeTokenFromDesc(tknDesc));
+}
+
 
 /*
  * ======= Protected: =======
@@ -105,9 +380,47 @@ void PreProcessor::ParseDirective(const std::string& directive, bool ignoreUnkno
 void PreProcessor::WriteLineDirective(unsigned int lineNo, const std::string& filename)
 {
     if (writeLineMarkFilenames_)
-        Out() << "#line " << lineNo << " \"" << filename << '\"' << std::endl;
+        WriteText("#line " + std::to_string(lineNo) + " \"" + filename + '\"');
     else
-        Out() << "#line " << lineNo << std::endl;
+        WriteText("#line " + std::to_string(lineNo));
+    WriteNewLine();
+}
+
+void PreProcessor::WriteText(const std::string& text)
+{
+    if (outputTokens_)
+        outputTokens_->PushBack(MakeToken(Tokens::Misc, text));
+    else if (output_)
+        *output_ << text;
+}
+
+void PreProcessor::WriteToken(const TokenPtr& tkn)
+{
+    if (outputTokens_)
+        outputTokens_->PushBack(tkn);
+    else if (output_)
+        output_->write(tkn->SpellData(), static_cast<std::streamsize>(tkn->SpellSize()));
+}
+
+void PreProcessor::WriteTokenString(const TokenPtrString& tokenString)
+{
+    if (outputTokens_)
+        outputTokens_->PushBack(tokenString);
+    else if (output_)
+    {
+        /* Write the token string at once, since a macro expansion might produce a large number of small tokens */
+        outputBuffer_.clear();
+        for (const auto& tkn : tokenString.GetTokens())
+            outputBuffer_.append(tkn->SpellData(), tkn->SpellSize());
+        output_->write(outputBuffer_.data(), static_cast<std::streamsize>(outputBuffer_.size()));
+    }
+}
+
+void PreProcessor::WriteNewLine()
+{
+    /* New-lines are only written to reproduce the line numbers, but tokens keep their source positions anyways */
+    if (output_)
+        *output_ << std::endl;
 }
 
 void PreProcessor::IgnoreDirective()
@@ -139,8 +452,8 @@ void PreProcessor::DefineMacro(const Macro& macro)
 
 void PreProcessor::DefineStandardMacro(const std::string& ident, int intValue)
 {
-    auto identTkn = std::make_shared<Token>(SourcePosition::ignore, Token::Types::Ident, ident);
-    auto valueTkn = std::make_shared<Token>(SourcePosition::ignore, Token::Types::IntLiteral, std::to_string(intValue));
+    auto identTkn = MakeToken(SourcePosition::ignore, Token::Types::Ident, ident);
+    auto valueTkn = MakeToken(SourcePosition::ignore, Token::Types::IntLiteral, std::to_string(intValue));
 
     TokenPtrString valueTokenString;
     valueTokenString.PushBack(valueTkn);
@@ -166,6 +479,12 @@ bool PreProcessor::IsDefined(const std::string& ident) const
     return (macros_.find(ident) != macros_.end());
 }
 
+bool PreProcessor::QueryMacro(const std::string& ident)
+{
+    usedMacros_.insert(ident);
+    return IsDefined(ident);
+}
+
 bool PreProcessor::OnDefineMacro(const Macro& macro)
 {
     /* Always allow to define any macros per default */
@@ -205,25 +524,23 @@ bool PreProcessor::OnUndefineMacro(const Macro& macro)
 
 bool PreProcessor::OnSubstitueStdMacro(const Token& identTkn, TokenPtrString& tokenString)
 {
-    const auto& ident = identTkn.Spell();
-
-    if (ident == "__FILE__")
+    if (identTkn.EqualsSpell("__FILE__"))
     {
         /* Replace '__FILE__' identifier with current filename */
-        tokenString.PushBack(Make<Token>(Tokens::StringLiteral, '\"' + GetCurrentFilename() + '\"'));
+        tokenString.PushBack(MakeToken(Tokens::StringLiteral, '\"' + GetCurrentFilename() + '\"'));
         return true;
     }
-    else if (ident == "__LINE__")
+    else if (identTkn.EqualsSpell("__LINE__"))
     {
         /* Replace '__LINE__' identifier with current line number */
-        tokenString.PushBack(Make<Token>(Tokens::IntLiteral, std::to_string(GetScanner().Pos().Row())));
+        tokenString.PushBack(MakeToken(Tokens::IntLiteral, std::to_string(GetScanner().Pos().Row())));
         return true;
     }
-    else if (ident == "__EVAL__")
+    else if (identTkn.EqualsSpell("__EVAL__"))
     {
         /* Parse and evaluate argument */
         auto argument = ParseAndEvaluateExpr(&identTkn);
-        tokenString.PushBack(Make<Token>(Tokens::IntLiteral, std::to_string(argument.ToInt())));
+        tokenString.PushBack(MakeToken(Tokens::IntLiteral, std::to_string(argument.ToInt())));
         return true;
     }
 
@@ -278,9 +595,9 @@ Variant PreProcessor::ParseAndEvaluateExpr(const Token* tkn)
     */
     TokenPtrString tokenString;
 
-    tokenString.PushBack(Make<Token>(Tokens::LBracket, "("));
+    tokenString.PushBack(MakeToken(Tokens::LBracket, "("));
     tokenString.PushBack(ParseDirectiveTokenString(true));
-    tokenString.PushBack(Make<Token>(Tokens::RBracket, ")"));
+    tokenString.PushBack(MakeToken(Tokens::RBracket, ")"));
 
     return EvaluateExpr(tokenString, tkn);
 }
@@ -295,6 +612,28 @@ Variant PreProcessor::ParseAndEvaluateArgumentExpr(const Token* tkn)
  * ======= Private: =======
  */
 
+bool PreProcessor::ProcessInput(const SourceCodePtr& input, const std::string& filename, bool enableWarnings)
+{
+    EnableWarnings(enableWarnings);
+
+    WriteLoadedStateOutput(filename);
+
+    PushScannerSource(input, filename);
+
+    try
+    {
+        ParseProgram();
+        return !GetReportHandler().HasErrors();
+    }
+    catch (const Report& err)
+    {
+        if (GetLog())
+            GetLog()->SubmitReport(err);
+    }
+
+    return false;
+}
+
 ScannerPtr PreProcessor::MakeScanner()
 {
     return std::make_shared<PreProcessorScanner>(GetLog());
@@ -315,177 +654,892 @@ void PreProcessor::PushScannerSource(const SourceCodePtr& source, const std::str
     Parser::PushScannerSource(source, filename);
     GetScanner().Source()->NextSourceOrigin(filename, 0);
 
+    includeGuardStack_.push({});
+
     /* Write new line directive for current position */
     WritePosToLineDirective();
 }
 
-bool PreProcessor::PopScannerSource()
+bool PreProcessor::PopScannerSource()
+{
+    /* Reduce include counter for current file */
+    const auto filename = GetCurrentFilename();
+    if (!filename.empty())
+    {
+        auto& counter = includeCounter_[filename];
+        if (counter > 0)
+            --counter;
+    }
+
+    /* Remember include-guard of current file, so it can be skipped on the next include without reading the file again */
+    if (!includeGuardStack_.empty())
+    {
+        const auto& includeGuard = includeGuardStack_.top();
+        if (!filename.empty() && includeGuard.state == IncludeGuard::States::End)
+            includeGuards_[filename] = includeGuard.ident;
+        includeGuardStack_.pop();
+    }
+
+    /* Pop scanner from stack */
+    if (Parser::PopScannerSource())
+    {
+        WritePosToLineDirective();
+        return true;
+    }
+
+    return false;
+}
+
+void PreProcessor::PushIfBlock(const TokenPtr& directiveToken, bool active, bool elseAllowed)
+{
+    IfBlock ifBlock;
+    {
+        ifBlock.directiveToken  = directiveToken;
+        ifBlock.directiveSource = GetScanner().GetSharedSource();
+        ifBlock.parentActive    = TopIfBlock().active;
+        ifBlock.elseAllowed     = elseAllowed;
+        ifBlock.SetActive(active);
+    }
+    ifBlockStack_.push(ifBlock);
+
+    WritePosToLineDirective();
+}
+
+void PreProcessor::SetIfBlock(const TokenPtr& directiveToken, bool active, bool elseAllowed)
+{
+    if (!ifBlockStack_.empty())
+    {
+        auto& ifBlock = ifBlockStack_.top();
+
+        ifBlock.directiveToken  = directiveToken;
+        ifBlock.elseAllowed     = elseAllowed;
+        ifBlock.SetActive(active);
+
+        WritePosToLineDirective();
+    }
+}
+
+void PreProcessor::PopIfBlock()
+{
+    if (ifBlockStack_.empty())
+        Error(R_MissingIfDirective, true);
+    else
+        ifBlockStack_.pop();
+
+    WritePosToLineDirective();
+}
+
+PreProcessor::IfBlock PreProcessor::TopIfBlock() const
+{
+    return (ifBlockStack_.empty() ? IfBlock() : ifBlockStack_.top());
+}
+
+void PreProcessor::ExpandMacros(std::size_t floor, bool readScanner, std::vector<HiddenToken>& output)
+{
+    while (expansionStack_.size() > floor)
+    {
+        if (!expansionStack_.back().IsExpandable())
+        {
+            /* Move all tokens that can not be expanded at once (e.g. a pre-expanded argument that is rescanned) */
+            auto top = expansionStack_.size() - 1;
+            while (top > floor && !expansionStack_[top - 1].IsExpandable())
+                --top;
+
+            output.insert(output.end(), expansionStack_.rbegin(), expansionStack_.rend() - top);
+            expansionStack_.resize(top);
+            continue;
+        }
+
+        auto tkn = expansionStack_.back();
+        expansionStack_.pop_back();
+
+        if (auto macro = FindMacroForExpansion(tkn))
+        {
+            if (ExpandMacroIdent(tkn, *macro, floor, readScanner, output))
+                continue;
+        }
+        else
+            tkn.painted = true;
+
+        output.push_back(tkn);
+    }
+}
+
+const PreProcessor::Macro* PreProcessor::FindMacroForExpansion(const HiddenToken& identTkn)
+{
+    /* Search for defined macro (the identifier buffer avoids a new string allocation for each look up) */
+    macroIdentBuffer_.assign(identTkn.tkn->SpellData(), identTkn.tkn->SpellSize());
+
+    auto it = macros_.find(macroIdentBuffer_);
+    if (it == macros_.end())
+        return nullptr;
+
+    /* Record each macro object only once as used macro, to avoid a look up in the set for each expansion */
+    const auto macro = it->second.get();
+    if (!macro->used)
+    {
+        macro->used = true;
+        macro->BuildParameterRefs();
+        usedMacros_.insert(it->first);
+    }
+
+    /* Never expand a macro again, if the identifier is the result of an expansion of the same macro */
+    if (HideSetContains(identTkn.hideSet, macro))
+        return nullptr;
+
+    return macro;
+}
+
+bool PreProcessor::ExpandMacroIdent(const HiddenToken& identTkn, const Macro& macro, std::size_t floor, bool readScanner, std::vector<HiddenToken>& output)
+{
+    std::size_t rescanBegin = 0;
+
+    if (macro.HasParameterList())
+    {
+        /*
+        The expanded arguments are stored in the buffer the output is not written to,
+        so the substitution can be written directly to the output (e.g. the expanded argument of an outer macro invocation)
+        */
+        auto& expandedArgTokens = (&output == &expandedArgTokens_[0] ? expandedArgTokens_[1] : expandedArgTokens_[0]);
+
+        const auto argBoundsBegin       = macroArgBounds_.size();
+        const auto argTokensBegin       = macroArgTokens_.size();
+        const auto argRangesBegin       = macroArgRanges_.size();
+        const auto expandedArgsBegin    = expandedArgTokens.size();
+
+        std::size_t numArgs = 0;
+
+        switch (CollectMacroArguments(macro, *identTkn.tkn, floor, readScanner, numArgs))
+        {
+            case MacroInvocation::NoArguments:
+            {
+                /* Interpret the macro usage only as plain identifier, if the macro has parameters, but the macro usage has no arguments */
+                return false;
+            }
+
+            case MacroInvocation::NoArgumentsWithBlank:
+            {
+                /* Also append single blank, due to previously ignored white spaces */
+                output.push_back(identTkn);
+                output.push_back({ GetBlankToken(), 0 });
+                return true;
+            }
+
+            default:
+            break;
+        }
+
+        /* Replace parameters by arguments with the hide-set of the identifier and the closing bracket (HS(IDENT) & HS(')')) | { MACRO } */
+        const auto rbracketHideSet  = expansionStack_[macroArgBounds_.back()].hideSet;
+        const auto hideSet          = HideSetAdd(HideSetIntersection(identTkn.hideSet, rbracketHideSet), &macro);
+
+        if (macro.argsInOrder && numArgs >= macro.parameters.size())
+            rescanBegin = SubstituteMacroInOrder(macro, hideSet, argBoundsBegin, numArgs, output);
+        else
+        {
+            PrepareMacroArguments(macro, argBoundsBegin, numArgs, expandedArgTokens);
+            rescanBegin = SubstituteMacro(macro, hideSet, argRangesBegin, numArgs, expandedArgTokens, output);
+        }
+
+        macroArgBounds_.resize(argBoundsBegin);
+        macroArgTokens_.resize(argTokensBegin);
+        macroArgRanges_.resize(argRangesBegin);
+        expandedArgTokens.resize(expandedArgsBegin);
+    }
+    else if (macro.tokenString.Empty())
+    {
+        /* Replace identifier with single blank to avoid parsing problems in next pass */
+        output.push_back({ GetBlankToken(), 0 });
+        return true;
+    }
+    else
+    {
+        /* Replace identifier with macro value with the hide-set HS(IDENT) | { MACRO } */
+        rescanBegin = SubstituteMacro(macro, HideSetAdd(identTkn.hideSet, &macro), 0, 0, expandedArgTokens_[0], output);
+    }
+
+    /*
+    Leading tokens of the substitution that can not be expanded anymore stay in the output (this is equivalent to rescanning them),
+    and the remaining tokens are moved onto the expansion stack in reverse order, so they are rescanned before the remaining tokens
+    */
+    expansionStack_.insert(expansionStack_.end(), output.rbegin(), output.rend() - rescanBegin);
+    output.resize(rescanBegin);
+
+    return true;
+}
+
+PreProcessor::MacroInvocation PreProcessor::CollectMacroArguments(
+    const Macro& macro, const Token& identTkn, std::size_t floor, bool readScanner, std::size_t& numArgs)
+{
+    /* Find opening bracket '(' on top of the expansion stack, or read it from the scanner */
+    auto top = expansionStack_.size();
+    while (top > floor && expansionStack_[top - 1].type == Tokens::WhiteSpace)
+        --top;
+
+    if (top > floor)
+    {
+        if (expansionStack_[top - 1].type != Tokens::LBracket)
+            return MacroInvocation::NoArguments;
+    }
+    else if (readScanner)
+    {
+        expansionStack_.resize(floor);
+
+        IgnoreWhiteSpaces();
+
+        if (!Is(Tokens::LBracket))
+            return MacroInvocation::NoArgumentsWithBlank;
+
+        expansionStack_.push_back({ AcceptIt(), 0 });
+        top = expansionStack_.size();
+    }
+    else
+        return MacroInvocation::NoArguments;
+
+    /*
+    Find the positions of the opening bracket '(', and of each comma ',' and the closing bracket ')' that separate the arguments.
+    The arguments are left on the expansion stack, so they are neither copied nor moved as long as they are not needed.
+    */
+    const auto argBoundsBegin = macroArgBounds_.size();
+    macroArgBounds_.push_back(top - 1);
+
+    int bracketLevel = 0;
+
+    for (auto pos = top - 1;;)
+    {
+        if (pos == floor)
+        {
+            if (!readScanner)
+            {
+                /* Interpret the macro usage only as plain identifier, if the argument list is incomplete */
+                macroArgBounds_.resize(argBoundsBegin);
+                return MacroInvocation::NoArguments;
+            }
+
+            /* Read the remaining argument list from the scanner, which moves all argument bounds up */
+            const auto numTokens = ReadMacroArgumentsFromScanner(floor, bracketLevel);
+
+            for (auto i = argBoundsBegin; i < macroArgBounds_.size(); ++i)
+                macroArgBounds_[i] += numTokens;
+
+            pos += numTokens;
+        }
+
+        const auto type = expansionStack_[--pos].type;
+
+        if (bracketLevel == 0 && (type == Tokens::RBracket || type == Tokens::Comma))
+        {
+            macroArgBounds_.push_back(pos);
+            if (type == Tokens::RBracket)
+                break;
+        }
+        else if (type == Tokens::LBracket)
+            ++bracketLevel;
+        else if (type == Tokens::RBracket)
+        {
+            /* Do not finish argument if a closing bracket ')' appears, which belongs to an inner opening bracket '(' */
+            --bracketLevel;
+        }
+    }
+
+    numArgs = macroArgBounds_.size() - argBoundsBegin - 1;
+
+    /* Interpret an empty argument list as no arguments, unless the macro has a single parameter (e.g. "Macro()") */
+    if (numArgs == 1 && macro.parameters.size() != 1)
+    {
+        const auto argFloor = macroArgBounds_[argBoundsBegin + 1] + 1;
+        const auto argTop   = macroArgBounds_[argBoundsBegin];
+
+        auto IsOfInterest = [](const HiddenToken& tkn)
+        {
+            return tkn.IsOfInterest();
+        };
+
+        if (std::none_of(expansionStack_.begin() + argFloor, expansionStack_.begin() + argTop, IsOfInterest))
+            numArgs = 0;
+    }
+
+    /* Check compatability of parameter count to macro */
+    if ( ( !macro.varArgs && numArgs != macro.parameters.size() ) ||
+         ( macro.varArgs && numArgs < macro.parameters.size() ) )
+    {
+        /* Report error of mismatch is number of parameters and arguments */
+        std::string errorMsg;
+
+        if (numArgs > macro.parameters.size())
+            errorMsg = R_TooManyArgsForMacro(identTkn.Spell(), macro.parameters.size(), numArgs);
+        if (numArgs < macro.parameters.size())
+            errorMsg = R_TooFewArgsForMacro(identTkn.Spell(), macro.parameters.size(), numArgs);
+
+        Error(errorMsg, &identTkn);
+    }
+
+    return MacroInvocation::Invoked;
+}
+
+std::size_t PreProcessor::ReadMacroArgumentsFromScanner(std::size_t floor, int bracketLevel)
+{
+    /* Read tokens until the closing bracket ')' appears (the argument buffer is only used temporarily) */
+    const auto tokensBegin = macroArgTokens_.size();
+
+    while (bracketLevel >= 0)
+    {
+        auto tkn = AcceptIt();
+
+        switch (tkn->Type())
+        {
+            case Tokens::LBracket:
+                ++bracketLevel;
+                break;
+            case Tokens::RBracket:
+                --bracketLevel;
+                break;
+            case Tokens::Ident:
+            {
+                /* Substitute standard macros immediately, since they depend on the scanner (e.g. '__LINE__' and '__EVAL__') */
+                TokenPtrString stdMacroTokenString;
+                if (OnSubstitueStdMacro(*tkn, stdMacroTokenString))
+                {
+                    for (const auto& stdMacroTkn : stdMacroTokenString.GetTokens())
+                        macroArgTokens_.push_back({ stdMacroTkn, 0 });
+                    continue;
+                }
+            }
+            break;
+            default:
+                break;
+        }
+
+        macroArgTokens_.push_back({ tkn, 0 });
+    }
+
+    /* Insert tokens in reverse order below all other tokens on the expansion stack, since they follow after them */
+    const auto numTokens = macroArgTokens_.size() - tokensBegin;
+
+    expansionStack_.insert(expansionStack_.begin() + floor, macroArgTokens_.rbegin(), macroArgTokens_.rend() - tokensBegin);
+    macroArgTokens_.resize(tokensBegin);
+
+    return numTokens;
+}
+
+// Returns true if the specified token of the macro definition is an operand of the '##' operator.
+static bool IsOperandOfConcatenation(const TokenPtrString::Container& tokens, std::size_t index)
+{
+    /* Check previous token of interest */
+    for (auto i = index; i > 0; --i)
+    {
+        if (DefaultTokenOfInterestFunctor::IsOfInterest(tokens[i - 1]))
+        {
+            if (tokens[i - 1]->Type() == Token::Types::DirectiveConcat)
+                return true;
+            break;
+        }
+    }
+
+    /* Check next token of interest */
+    for (auto i = index + 1; i < tokens.size(); ++i)
+    {
+        if (DefaultTokenOfInterestFunctor::IsOfInterest(tokens[i]))
+            return (tokens[i]->Type() == Token::Types::DirectiveConcat);
+    }
+
+    return false;
+}
+
+// Returns the index of the macro parameter with the same spelling as the specified token, or the number of parameters if there is no such parameter.
+static std::size_t FindMacroParameter(const std::vector<std::string>& parameters, const Token& tkn)
+{
+    auto paramIt = std::find_if(
+        parameters.begin(), parameters.end(),
+        [&tkn](const std::string& param) { return tkn.EqualsSpell(param); }
+    );
+    return static_cast<std::size_t>(paramIt - parameters.begin());
+}
+
+static const std::string g_vaArgsIdent = "__VA_ARGS__";
+
+void PreProcessor::PrepareMacroArguments(const Macro& macro, std::size_t argBoundsBegin, std::size_t numArgs, std::vector<HiddenToken>& expandedArgTokens)
+{
+    enum : unsigned char
+    {
+        ArgUsageRaw         = (1 << 0), // Argument is used as operand of the '#' or '##' operator
+        ArgUsageExpanded    = (1 << 1), // Argument is used as operand for all other parameters
+    };
+
+    /* Determine how each argument is used in the replacement list */
+    const auto usageBegin = macroArgUsage_.size();
+    macroArgUsage_.resize(usageBegin + numArgs, 0);
+
+    for (const auto& paramRef : macro.parameterRefs)
+    {
+        const auto usage = (paramRef.expanded ? ArgUsageExpanded : ArgUsageRaw);
+
+        if (paramRef.index == macro.parameters.size())
+        {
+            for (auto argIndex = macro.parameters.size(); argIndex < numArgs; ++argIndex)
+                macroArgUsage_[usageBegin + argIndex] |= usage;
+        }
+        else if (paramRef.index < numArgs)
+            macroArgUsage_[usageBegin + paramRef.index] |= usage;
+    }
+
+    /* Removes white spaces and comments from the front and back of the specified token range */
+    auto TrimRange = [](const std::vector<HiddenToken>& argTokens, std::size_t begin, std::size_t end) -> TokenRange
+    {
+        while (begin < end && !argTokens[begin].IsOfInterest())
+            ++begin;
+        while (end > begin && !argTokens[end - 1].IsOfInterest())
+            --end;
+        return { begin, end };
+    };
+
+    /* Remove opening bracket '(' and all white spaces in front of it */
+    expansionStack_.resize(macroArgBounds_[argBoundsBegin]);
+
+    for (std::size_t argIndex = 0; argIndex < numArgs; ++argIndex)
+    {
+        const auto argFloor = macroArgBounds_[argBoundsBegin + argIndex + 1] + 1;
+        const auto usage    = macroArgUsage_[usageBegin + argIndex];
+
+        TokenRange rawRange { 0, 0 }, expandedRange { 0, 0 };
+
+        if ((usage & ArgUsageRaw) != 0)
+        {
+            /* Copy unexpanded argument from the expansion stack */
+            const auto rawBegin = macroArgTokens_.size();
+            macroArgTokens_.insert(macroArgTokens_.end(), expansionStack_.rbegin(), expansionStack_.rend() - argFloor);
+            rawRange = TrimRange(macroArgTokens_, rawBegin, macroArgTokens_.size());
+        }
+
+        if ((usage & ArgUsageExpanded) != 0)
+        {
+            /* Expand argument in isolation right on top of the expansion stack, and only once per macro invocation */
+            const auto expandedBegin = expandedArgTokens.size();
+            ExpandMacros(argFloor, false, expandedArgTokens);
+            expandedRange = TrimRange(expandedArgTokens, expandedBegin, expandedArgTokens.size());
+        }
+
+        macroArgRanges_.push_back(rawRange);
+        macroArgRanges_.push_back(expandedRange);
+
+        /* Remove argument and its separator (',' or ')') from the expansion stack */
+        expansionStack_.resize(argFloor - 1);
+    }
+
+    /* Remove remaining tokens of an empty argument list */
+    expansionStack_.resize(macroArgBounds_.back());
+
+    macroArgUsage_.resize(usageBegin);
+}
+
+std::size_t PreProcessor::SubstituteMacro(
+    const Macro& macro, std::size_t hideSet, std::size_t argRangesBegin, std::size_t numArgs,
+    const std::vector<HiddenToken>& expandedArgTokens, std::vector<HiddenToken>& output)
+{
+    if (macro.parameters.size() > numArgs)
+        return output.size();
+
+    const auto substitutionBegin = output.size();
+    const auto& tokens = macro.tokenString.GetTokens();
+
+    /* Keep track of the first token that must be rescanned, so the substitution does not need to be searched for it afterwards */
+    std::size_t rescanBegin = ~0u;
+
+    for (std::size_t i = 0, n = tokens.size(); i < n; ++i)
+    {
+        const auto& tkn = tokens[i];
+
+        /* Check if current token is an identifier which matches one of the parameters of the macro */
+        const auto& paramRef = macro.parameterRefs[i];
+
+        switch (tkn->Type())
+        {
+            case Tokens::Ident:
+            {
+                /* Arguments are expanded before the substitution, unless they are an operand of the '##' operator */
+                const auto argTokens = (paramRef.expanded ? &expandedArgTokens : nullptr);
+
+                if (paramRef.index == macro.parameters.size())
+                {
+                    /* Replace '__VA_ARGS__' identifier with all variadic arguments (i.e. all after the number of parameters) */
+                    for (auto argIndex = macro.parameters.size(); argIndex < numArgs; ++argIndex)
+                    {
+                        SubstituteMacroArgument(argRangesBegin + argIndex * 2, hideSet, argTokens, output, rescanBegin);
+                        if (argIndex + 1 < numArgs)
+                            output.push_back({ GetCommaToken(), hideSet });
+                    }
+                    continue;
+                }
+
+                if (paramRef.index < macro.parameters.size())
+                {
+                    /* Replace identifier by argument token string */
+                    SubstituteMacroArgument(argRangesBegin + paramRef.index * 2, hideSet, argTokens, output, rescanBegin);
+                    continue;
+                }
+            }
+            break;
+
+            case Tokens::Directive:
+            {
+                if (paramRef.index < macro.parameters.size())
+                {
+                    /* Replace identifier by converting the unexpanded argument to a string literal */
+                    const auto& argRange = macroArgRanges_[argRangesBegin + paramRef.index * 2];
+
+                    std::string stringLiteral = "\"";
+                    for (auto tknIndex = argRange.begin; tknIndex < argRange.end; ++tknIndex)
+                    {
+                        const auto& argTkn = *macroArgTokens_[tknIndex].tkn;
+                        stringLiteral.append(argTkn.SpellData(), argTkn.SpellSize());
+                    }
+                    stringLiteral += '\"';
+
+                    output.push_back({ MakeToken(Tokens::StringLiteral, stringLiteral), hideSet });
+                    continue;
+                }
+            }
+            break;
+
+            case Tokens::DirectiveConcat:
+            {
+                /* Remove previous white spaces and comments */
+                while (output.size() > substitutionBegin && !output.back().IsOfInterest())
+                    output.pop_back();
+
+                /* Ignore concatenation token and following white spaces and comments */
+                while (i + 1 < n && !DefaultTokenOfInterestFunctor::IsOfInterest(tokens[i + 1]))
+                    ++i;
+                continue;
+            }
+            break;
+
+            default:
+            break;
+        }
+
+        /* Identifiers of the replacement list are not painted yet, so they must be rescanned */
+        if (tkn->Type() == Tokens::Ident)
+            rescanBegin = std::min(rescanBegin, output.size());
+
+        output.push_back({ tkn, hideSet });
+    }
+
+    return std::min(rescanBegin, output.size());
+}
+
+void PreProcessor::SubstituteMacroArgument(
+    std::size_t argRangeIndex, std::size_t hideSet, const std::vector<HiddenToken>* expandedArgTokens,
+    std::vector<HiddenToken>& output, std::size_t& rescanBegin)
+{
+    /* Select either the unexpanded or the expanded argument (see PrepareMacroArguments) */
+    const auto& argTokens   = (expandedArgTokens != nullptr ? *expandedArgTokens : macroArgTokens_);
+    const auto  argRange    = macroArgRanges_[expandedArgTokens != nullptr ? argRangeIndex + 1 : argRangeIndex];
+
+    /* Append argument tokens and replace their hide-sets by the union with the hide-set of the macro expansion */
+    const auto outputBegin = output.size();
+    output.insert(output.end(), argTokens.begin() + argRange.begin, argTokens.begin() + argRange.end);
+    UniteHideSets(output, outputBegin, hideSet, rescanBegin);
+}
+
+std::size_t PreProcessor::SubstituteMacroInOrder(
+    const Macro& macro, std::size_t hideSet, std::size_t argBoundsBegin, std::size_t numArgs, std::vector<HiddenToken>& output)
+{
+    /* Remove opening bracket '(' and all white spaces in front of it */
+    expansionStack_.resize(macroArgBounds_[argBoundsBegin]);
+
+    const auto& tokens = macro.tokenString.GetTokens();
+
+    std::size_t rescanBegin = ~0u, nextArgIndex = 0;
+
+    for (std::size_t i = 0, n = tokens.size(); i < n; ++i)
+    {
+        const auto argIndex = macro.parameterRefs[i].index;
+
+        if (argIndex < numArgs)
+        {
+            /* Remove unused arguments in front of this argument and their separators from the expansion stack */
+            for (; nextArgIndex < argIndex; ++nextArgIndex)
+                expansionStack_.resize(macroArgBounds_[argBoundsBegin + nextArgIndex + 1]);
+
+            /* Remove leading white spaces and comments, which are trimmed from the argument anyway */
+            const auto argFloor = macroArgBounds_[argBoundsBegin + argIndex + 1] + 1;
+
+            while (expansionStack_.size() > argFloor && !expansionStack_.back().IsOfInterest())
+                expansionStack_.pop_back();
+
+            /* Expand argument in isolation right on top of the expansion stack, and directly into the output */
+            const auto outputBegin = output.size();
+            ExpandMacros(argFloor, false, output);
+
+            /* Trim white spaces (e.g. from empty macros) and replace the hide-sets of the argument tokens */
+            while (output.size() > outputBegin && !output.back().IsOfInterest())
+                output.pop_back();
+
+            auto argBegin = outputBegin;
+            while (argBegin < output.size() && !output[argBegin].IsOfInterest())
+                ++argBegin;
+
+            output.erase(output.begin() + outputBegin, output.begin() + argBegin);
+            UniteHideSets(output, outputBegin, hideSet, rescanBegin);
+
+            /* Remove argument and its separator (',' or ')') from the expansion stack */
+            expansionStack_.resize(argFloor - 1);
+            nextArgIndex = argIndex + 1;
+        }
+        else
+        {
+            /* Identifiers of the replacement list are not painted yet, so they must be rescanned */
+            if (tokens[i]->Type() == Tokens::Ident)
+                rescanBegin = std::min(rescanBegin, output.size());
+
+            output.push_back({ tokens[i], hideSet });
+        }
+    }
+
+    /* Remove remaining arguments and the closing bracket ')' from the expansion stack */
+    expansionStack_.resize(macroArgBounds_.back());
+
+    return std::min(rescanBegin, output.size());
+}
+
+void PreProcessor::UniteHideSets(std::vector<HiddenToken>& output, std::size_t outputBegin, std::size_t hideSet, std::size_t& rescanBegin)
+{
+    std::size_t lastArgHideSet = 0, lastHideSet = hideSet;
+
+    for (auto i = outputBegin, n = output.size(); i < n; ++i)
+    {
+        auto& tkn = output[i];
+        if (tkn.HasHideSet())
+        {
+            /* Consecutive tokens mostly share the same hide-set, so only build a new union when it changes */
+            if (tkn.hideSet != lastArgHideSet)
+            {
+                lastArgHideSet  = tkn.hideSet;
+                lastHideSet     = HideSetUnion(lastArgHideSet, hideSet);
+            }
+            tkn.hideSet = lastHideSet;
+
+            if (i < rescanBegin && tkn.IsExpandable())
+                rescanBegin = i;
+        }
+    }
+}
+
+std::size_t PreProcessor::HideSetAdd(std::size_t hideSet, const Macro* macro)
 {
-    /* Reduce include counter for current file */
-    const auto filename = GetCurrentFilename();
-    if (!filename.empty())
-    {
-        auto& counter = includeCounter_[filename];
-        if (counter > 0)
-            --counter;
-    }
+    /* Reuse previous node for the same hide-set, so that the unions of equal hide-sets can be cached, too */
+    bool cached = false;
+    auto& entry = FetchHideSetCacheEntry(hideSetAddCache_, hideSet, reinterpret_cast<std::uintptr_t>(macro), cached);
 
-    /* Pop scanner from stack */
-    if (Parser::PopScannerSource())
+    if (!cached)
     {
-        WritePosToLineDirective();
-        return true;
+        /* Only walk through the hide-set if the result is not cached yet */
+        if (HideSetContains(hideSet, macro))
+            entry.result = hideSet;
+        else
+        {
+            hideSetNodes_.push_back({ macro, hideSet });
+            entry.result = hideSetNodes_.size() - 1;
+        }
     }
 
-    return false;
+    return entry.result;
 }
 
-void PreProcessor::PushIfBlock(const TokenPtr& directiveToken, bool active, bool elseAllowed)
+std::size_t PreProcessor::HideSetUnion(std::size_t lhs, std::size_t rhs)
 {
-    IfBlock ifBlock;
+    if (lhs == 0 || lhs == rhs)
+        return rhs;
+    if (rhs == 0)
+        return lhs;
+
+    /* Look up union in the cache, since the same hide-sets are combined over and over again for nested macro invocations */
+    bool cached = false;
+    auto& entry = FetchHideSetCacheEntry(hideSetUnionCache_, lhs, rhs, cached);
+
+    if (!cached)
     {
-        ifBlock.directiveToken  = directiveToken;
-        ifBlock.directiveSource = GetScanner().GetSharedSource();
-        ifBlock.parentActive    = TopIfBlock().active;
-        ifBlock.elseAllowed     = elseAllowed;
-        ifBlock.SetActive(active);
+        entry.result = rhs;
+        for (auto node = lhs; node != 0; node = hideSetNodes_[node].next)
+            entry.result = HideSetAdd(entry.result, hideSetNodes_[node].macro);
     }
-    ifBlockStack_.push(ifBlock);
 
-    WritePosToLineDirective();
+    return entry.result;
 }
 
-void PreProcessor::SetIfBlock(const TokenPtr& directiveToken, bool active, bool elseAllowed)
+std::size_t PreProcessor::HideSetIntersection(std::size_t lhs, std::size_t rhs)
 {
-    if (!ifBlockStack_.empty())
+    if (lhs == rhs)
+        return lhs;
+
+    std::size_t result = 0;
+
+    for (auto node = lhs; node != 0; node = hideSetNodes_[node].next)
     {
-        auto& ifBlock = ifBlockStack_.top();
+        if (HideSetContains(rhs, hideSetNodes_[node].macro))
+            result = HideSetAdd(result, hideSetNodes_[node].macro);
+    }
 
-        ifBlock.directiveToken  = directiveToken;
-        ifBlock.elseAllowed     = elseAllowed;
-        ifBlock.SetActive(active);
+    return result;
+}
 
-        WritePosToLineDirective();
+bool PreProcessor::HideSetContains(std::size_t hideSet, const Macro* macro) const
+{
+    for (auto node = hideSet; node != 0; node = hideSetNodes_[node].next)
+    {
+        if (hideSetNodes_[node].macro == macro)
+            return true;
     }
+    return false;
 }
 
-void PreProcessor::PopIfBlock()
+PreProcessor::HideSetCacheEntry& PreProcessor::FetchHideSetCacheEntry(
+    std::vector<HideSetCacheEntry>& cache, std::size_t lhs, std::uintptr_t rhs, bool& cached)
 {
-    if (ifBlockStack_.empty())
-        Error(R_MissingIfDirective, true);
-    else
-        ifBlockStack_.pop();
+    static const std::size_t cacheSize = 1024;
 
-    WritePosToLineDirective();
+    if (cache.empty())
+        cache.resize(cacheSize, HideSetCacheEntry { 0, 0, 0, 0 });
+
+    const auto hash = static_cast<std::size_t>(lhs * 2654435761u) ^ static_cast<std::size_t>(rhs ^ (rhs >> 4));
+    auto& entry = cache[hash & (cacheSize - 1)];
+
+    cached = (entry.generation == hideSetGeneration_ && entry.lhs == lhs && entry.rhs == rhs);
+
+    if (!cached)
+    {
+        entry.generation    = hideSetGeneration_;
+        entry.lhs           = lhs;
+        entry.rhs           = rhs;
+        entry.result        = 0;
+    }
+
+    return entry;
 }
 
-PreProcessor::IfBlock PreProcessor::TopIfBlock() const
+TokenPtr PreProcessor::GetBlankToken()
 {
-    return (ifBlockStack_.empty() ? IfBlock() : ifBlockStack_.top());
+    if (!blankTkn_)
+        blankTkn_ = MakeToken(Tokens::WhiteSpace, " ");
+    return blankTkn_;
 }
 
-TokenPtrString PreProcessor::ExpandMacro(const Macro& macro, const std::vector<TokenPtrString>& arguments)
+TokenPtr PreProcessor::GetCommaToken()
 {
-    TokenPtrString expandedString;
+    if (!commaTkn_)
+        commaTkn_ = MakeToken(Tokens::Comma, ",");
+    return commaTkn_;
+}
 
-    if (macro.parameters.size() > arguments.size())
-        return expandedString;
+TokenPtrString PreProcessor::ScanMacroValue(const std::string& value)
+{
+    TokenPtrString tokenString;
 
-    auto ExpandTokenString = [&](TokenPtrString::Container::const_iterator& tknIt, const TokenPtrString::Container::const_iterator& tknItEnd) -> bool
+    if (!value.empty())
     {
-        const auto& tkn = **tknIt;
+        /* Scan all tokens of the value with its own scanner (the token arena keeps the source alive) */
+        PreProcessorScanner scanner(GetLog());
 
-        /* Check if current token is an identifier which matches one of the parameters of the macro */
-        switch (tkn.Type())
+        if (scanner.ScanSource(std::make_shared<SourceCode>(std::string(value)), GetTokenArena()))
         {
-            case Tokens::Ident:
+            for (auto tkn = scanner.Next(); tkn->Type() != Tokens::EndOfStream; tkn = scanner.Next())
             {
-                auto ident = tkn.Spell();
-                if (ident == "__VA_ARGS__")
-                {
-                    /* Replace '__VA_ARGS__' identifier with all variadic arguments (i.e. all after the number of parameters) */
-                    for (std::size_t i = macro.parameters.size(); i < arguments.size(); ++i)
-                    {
-                        expandedString.PushBack(arguments[i]);
-                        if (i + 1 < arguments.size())
-                            expandedString.PushBack(Make<Token>(Tokens::Comma, ","));
-                    }
-                    return true;
-                }
-                else
-                {
-                    for (std::size_t i = 0; i < macro.parameters.size(); ++i)
-                    {
-                        if (ident == macro.parameters[i])
-                        {
-                            /* Expand identifier by argument token string */
-                            expandedString.PushBack(arguments[i]);
-                            return true;
-                        }
-                    }
-                }
+                if (tkn->Type() != Tokens::Comment)
+                    tokenString.PushBack(tkn);
             }
-            break;
+        }
 
-            case Tokens::Directive:
-            {
-                auto ident = tkn.Spell();
-                for (std::size_t i = 0; i < macro.parameters.size(); ++i)
-                {
-                    if (ident == macro.parameters[i])
-                    {
-                        /* Expand identifier by converting argument token string to string literal */
-                        std::stringstream stringLiteral;
-                        stringLiteral << '\"' << arguments[i] << '\"';
-                        expandedString.PushBack(Make<Token>(Tokens::StringLiteral, stringLiteral.str()));
-                        return true;
-                    }
-                }
-            }
-            break;
+        /* Remove leading and trailing white spaces */
+        auto& tokens = tokenString.GetTokens();
 
-            case Tokens::DirectiveConcat:
-            {
-                /* Rremove previous white spaces and comments */
-                expandedString.TrimBack();
+        while (!tokens.empty() && tokens.back()->Type() == Tokens::WhiteSpace)
+            tokens.pop_back();
 
-                /* Ignore concatenation token */
-                ++tknIt;
+        while (!tokens.empty() && tokens.front()->Type() == Tokens::WhiteSpace)
+            tokens.erase(tokens.begin());
+    }
 
-                /* Ignore following white spaces and comments */
-                while (tknIt != tknItEnd && !DefaultTokenOfInterestFunctor::IsOfInterest(*tknIt))
-                    ++tknIt;
+    return tokenString;
+}
 
-                /* Iterate one token back since it will be incremented in the outer for-loop */
-                --tknIt;
-                return true;
-            }
-            break;
+void PreProcessor::UpdateIncludeGuard(const Token& tkn)
+{
+    if (!includeGuardStack_.empty())
+    {
+        auto& includeGuard = includeGuardStack_.top();
 
-            default:
-            break;
-        }
+        /* Only white spaces and comments are allowed before and after the include-guard */
+        const auto type = tkn.Type();
+        if (type == Tokens::WhiteSpace || type == Tokens::NewLine || type == Tokens::Comment)
+            return;
 
-        /* Return false -> meaning this function has not added any tokens to the expanded string */
-        return false;
-    };
+        if (includeGuard.state == IncludeGuard::States::Start)
+        {
+            if (type != Tokens::Directive || !tkn.EqualsSpell("ifndef"))
+                includeGuard.state = IncludeGuard::States::Invalid;
+        }
+        else if (includeGuard.state == IncludeGuard::States::End)
+            includeGuard.state = IncludeGuard::States::Invalid;
+    }
+}
 
-    const auto& tokens = macro.tokenString.GetTokens();
-    for (auto it = tokens.begin(); it != tokens.end(); ++it)
+void PreProcessor::InvalidateIncludeGuardBranch()
+{
+    if (!includeGuardStack_.empty())
     {
-        if (!ExpandTokenString(it, tokens.end()))
-            expandedString.PushBack(*it);
+        auto& includeGuard = includeGuardStack_.top();
+        if (includeGuard.state == IncludeGuard::States::Inside && includeGuard.ifBlockDepth == ifBlockStack_.size())
+            includeGuard.state = IncludeGuard::States::Invalid;
     }
-
-    return expandedString;
 }
 
 void PreProcessor::WritePosToLineDirective()
 {
     if (writeLineMarks_)
     {
-        auto pos = GetScanner().ActiveToken()->Pos();
-        WriteLineDirective(pos.Row(), GetCurrentFilename());
+        WriteLineDirective(GetScanner().ActiveToken()->Row(), GetCurrentFilename());
+    }
+}
+
+void PreProcessor::WriteLoadedStateOutput(const std::string& filename)
+{
+    if (loadedStateOutput_.Empty() || scanDependenciesOnly_)
+        return;
+
+    if (outputTokens_)
+    {
+        /* Tokens keep their source positions, so the output can be written as is */
+        WriteTokenString(loadedStateOutput_);
+    }
+    else
+    {
+        /* Write '#line'-directive whenever the source origin changes */
+        const SourceOrigin* prevOrigin = nullptr;
+        bool newLine = true;
+
+        for (const auto& tkn : loadedStateOutput_.GetTokens())
+        {
+            const auto origin = tkn->Origin();
+            if (writeLineMarks_ && origin != nullptr && origin != prevOrigin)
+            {
+                prevOrigin = origin;
+                if (!newLine)
+                    WriteNewLine();
+                WriteLineDirective(static_cast<unsigned int>(static_cast<int>(tkn->Row()) + prevOrigin->lineOffset), prevOrigin->filename);
+            }
+
+            WriteToken(tkn);
+            newLine = (tkn->Type() == Tokens::NewLine);
+        }
+
+        /* Continue with the first line of the main file */
+        if (writeLineMarks_)
+        {
+            if (!newLine)
+                WriteNewLine();
+            WriteLineDirective(1, filename);
+        }
     }
 }
 
@@ -501,6 +1555,16 @@ void PreProcessor::ParseProgram()
             if (TopIfBlock().active)
             {
                 /* Parse active block */
+                UpdateIncludeGuard(*Tkn());
+
+                if (scanDependenciesOnly_ && TknType() != Tokens::Directive)
+                {
+                    /* Only directives can include other files, so skip all characters up to the next directive */
+                    GetScanner().SkipToNextDirective();
+                    AcceptIt();
+                    continue;
+                }
+
                 switch (TknType())
                 {
                     case Tokens::Directive:
@@ -519,11 +1583,14 @@ void PreProcessor::ParseProgram()
             }
             else
             {
-                /* On an inactive if-block: parse only '#if'-directives or skip to next line */
+                /* On an inactive if-block: parse only '#if'-directives or skip all characters up to the next directive */
                 if (TknType() == Tokens::Directive)
                     ParseAnyIfDirectiveAndSkipValidation();
                 else
+                {
+                    GetScanner().SkipToNextDirective();
                     AcceptIt();
+                }
             }
         }
     }
@@ -547,130 +1614,70 @@ void PreProcessor::ParseProgram()
 
 void PreProcessor::ParesComment()
 {
-    Out() << Accept(Tokens::Comment)->Spell();
+    WriteToken(Accept(Tokens::Comment));
 }
 
 void PreProcessor::ParseIdent()
 {
-    Out() << ParseIdentAsTokenString();
-}
-
-TokenPtrString PreProcessor::ParseIdentAsTokenString()
-{
-    TokenPtrString tokenString;
+    identTokenString_.GetTokens().clear();
 
-    /* Parse identifier */
-    auto identTkn = Accept(Tokens::Ident);
-
-    /* Check for pre-defined and dynamic macros */
-    if (!OnSubstitueStdMacro(*identTkn, tokenString))
+    if (outputTokens_)
     {
-        /* Search for defined macro */
-        auto it = macros_.find(identTkn->Spell());
-        if (it != macros_.end())
+        auto identTkn = Tkn();
+        ParseIdentAsTokenString(identTokenString_);
+
+        /* Move tokens from the macro expansion to the source position of the macro identifier */
+        for (const auto& tkn : identTokenString_.GetTokens())
         {
-            /* Perform macro expansion */
-            auto& macro = *it->second;
-            if (macro.HasParameterList())
-            {
-                /* Replace identifier to macro with arguments */
-                tokenString.PushBack(ParseIdentArgumentsForMacro(identTkn, macro));
-            }
-            else if (macro.tokenString.Empty())
-            {
-                /* Replace identifier with single blank to avoid parsing problems in next pass */
-                tokenString.PushBack(Make<Token>(Tokens::WhiteSpace, " "));
-            }
+            if (tkn == identTkn)
+                WriteToken(tkn);
             else
-            {
-                /* Replace identifier with macro value */
-                tokenString.PushBack(macro.tokenString);
-            }
+                WriteToken(GetTokenArena().MakeTokenView(*identTkn, tkn->Type(), tkn->SpellData(), tkn->SpellSize()));
         }
-        else
-            tokenString.PushBack(identTkn);
     }
-
-    return tokenString;
-}
-
-TokenPtrString PreProcessor::ParseIdentArgumentsForMacro(const TokenPtr& identToken, const Macro& macro)
-{
-    /* Parse argument list begin */
-    IgnoreWhiteSpaces();
-
-    if (!Is(Tokens::LBracket))
+    else
     {
-        /*
-        Interpret the macro usage only as plain identifier,
-        if the macro has parameters, but the macro usage has no arguments.
-        Also append single blank, due to previously ignored white spaces.
-        */
-        TokenPtrString tokenStr;
-        tokenStr.PushBack(identToken);
-        tokenStr.PushBack(Make<Token>(Tokens::WhiteSpace, " "));
-        return tokenStr;
+        ParseIdentAsTokenString(identTokenString_);
+        WriteTokenString(identTokenString_);
     }
+}
 
-    AcceptIt();
-    IgnoreWhiteSpaces();
+void PreProcessor::ParseIdentAsTokenString(TokenPtrString& tokenString)
+{
+    /* Parse identifier */
+    auto identTkn = Accept(Tokens::Ident);
 
-    /* Parse all arguments */
-    std::vector<TokenPtrString> arguments;
+    /* Check for pre-defined and dynamic macros */
+    if (OnSubstitueStdMacro(*identTkn, tokenString))
+        return;
 
-    while (!Is(Tokens::RBracket))
+    /* Reset hide-sets for each outermost macro expansion */
+    if (macroExpansionDepth_ == 0)
     {
-        auto arg = ParseArgumentTokenString();
-
-        /* Remove white spaces and comments from argument */
-        arg.TrimBack();
-        arg.TrimFront();
-
-        arguments.push_back(arg);
-
-        /* Parse comma separator */
-        if (Is(Tokens::Comma))
-        {
-            AcceptIt();
-
-            /* Check if the last argument was empty (e.g. "Macro(,)") */
-            if (Is(Tokens::RBracket))
-                arguments.push_back({});
-        }
+        hideSetNodes_.resize(1);
+        ++hideSetGeneration_;
     }
 
-    AcceptIt();
+    ++macroExpansionDepth_;
 
-    /* Check compatability of parameter count to macro */
-    if ( ( !macro.varArgs && arguments.size() != macro.parameters.size() ) ||
-         ( macro.varArgs && arguments.size() < macro.parameters.size() ) )
-    {
-        if (macro.parameters.size() == 1 && arguments.size() == 0)
-        {
-            /* Append empty argument for a single parameter */
-            arguments.push_back({});
-        }
-        else
-        {
-            /* Report error of mismatch is number of parameters and arguments */
-            std::string errorMsg;
+    /* Perform macro expansion on top of the expansion stack (which is not empty for a nested expansion, e.g. for '__EVAL__') */
+    const auto floor        = expansionStack_.size();
+    const auto outputBegin  = expansionOutput_.size();
 
-            if (arguments.size() > macro.parameters.size())
-                errorMsg = R_TooManyArgsForMacro(identToken->Spell(), macro.parameters.size(), arguments.size());
-            if (arguments.size() < macro.parameters.size())
-                errorMsg = R_TooFewArgsForMacro(identToken->Spell(), macro.parameters.size(), arguments.size());
+    expansionStack_.push_back({ identTkn, 0 });
+    ExpandMacros(floor, true, expansionOutput_);
 
-            Error(errorMsg, identToken.get());
-        }
-    }
+    for (auto i = outputBegin; i < expansionOutput_.size(); ++i)
+        tokenString.PushBack(expansionOutput_[i].tkn);
+
+    expansionOutput_.resize(outputBegin);
 
-    /* Perform macro expansion */
-    return ExpandMacro(macro, arguments);
+    --macroExpansionDepth_;
 }
 
 void PreProcessor::ParseMisc()
 {
-    Out() << AcceptIt()->Spell();
+    WriteToken(AcceptIt());
 }
 
 void PreProcessor::ParseDirective()
@@ -769,13 +1776,13 @@ void PreProcessor::ParseDirectiveDefine()
     IgnoreWhiteSpaces();
     if (!Is(Tokens::NewLine))
     {
-        macro.tokenString = ParseDirectiveTokenString(false, true);
+        macro.tokenString = ParseDirectiveTokenString(false, true, false);
 
         /* Append new-line characters from value (this is used to reproduce the correct line numbers) */
         for (const auto& tkn : macro.tokenString.GetTokens())
         {
             if (tkn->Type() == Tokens::NewLine)
-                Out() << std::endl;
+                WriteNewLine();
         }
     }
 
@@ -819,24 +1826,47 @@ void PreProcessor::ParseDirectiveInclude()
         filename = Accept(Tokens::StringLiteral)->SpellContent();
     }
 
+    /* Check if filename has already been included with a defined include-guard */
+    auto includeGuardIt = includeGuards_.find(filename);
+    if (includeGuardIt != includeGuards_.end() && QueryMacro(includeGuardIt->second))
+        return;
+
     /* Check if filename has already been marked as 'once included' */
     if (onceIncluded_.find(filename) == onceIncluded_.end())
     {
-        /* Open source code */
-        std::unique_ptr<std::istream> includeStream;
+        SourceCodePtr sourceCode;
 
-        try
+        /* Refer to the cached file content without a copy (the source code keeps the content alive) */
+        if (includeCache_)
         {
-            includeStream = includeHandler_.Include(filename, useSearchPaths);
+            const auto path = includeHandler_.FindFile(filename, useSearchPaths);
+            if (!path.empty())
+            {
+                if (auto content = includeCache_->Fetch(path))
+                    sourceCode = std::make_shared<SourceCode>(content->data(), content->size(), content);
+            }
         }
-        catch (const std::exception& e)
+
+        if (!sourceCode)
         {
-            Error(e.what());
+            /* Open source code */
+            std::unique_ptr<std::istream> includeStream;
+
+            try
+            {
+                includeStream = includeHandler_.Include(filename, useSearchPaths);
+            }
+            catch (const std::exception& e)
+            {
+                Error(e.what());
+            }
+
+            sourceCode = std::make_shared<SourceCode>(std::move(includeStream));
         }
 
         /* Push scanner soruce for include file */
-        auto sourceCode = std::make_shared<SourceCode>(std::move(includeStream));
         PushScannerSource(sourceCode, filename);
+        includedFiles_.push_back({ filename, useSearchPaths, sourceCode });
     }
 }
 
@@ -864,7 +1894,7 @@ void PreProcessor::ParseDirectiveIfdef(bool skipEvaluation)
         auto ident = Accept(Tokens::Ident)->Spell();
 
         /* Push new if-block activation (with 'defined' condExpr) */
-        PushIfBlock(tkn, IsDefined(ident));
+        PushIfBlock(tkn, QueryMacro(ident));
     }
 }
 
@@ -877,20 +1907,39 @@ void PreProcessor::ParseDirectiveIfndef(bool skipEvaluation)
     IgnoreWhiteSpaces();
     auto ident = Accept(Tokens::Ident)->Spell();
 
-    /* Push new if-block activation (with 'not defined' condExpr) */
-    PushIfBlock(tkn, !IsDefined(ident));
+    /* Push new if-block activation (with 'not defined' condExpr, which is only queried on an active block) */
+    if (skipEvaluation)
+        PushIfBlock(tkn);
+    else
+        PushIfBlock(tkn, !QueryMacro(ident));
+
+    /* Start include-guard detection, if this is the first directive in the current source file */
+    if (!skipEvaluation && !includeGuardStack_.empty())
+    {
+        auto& includeGuard = includeGuardStack_.top();
+        if (includeGuard.state == IncludeGuard::States::Start)
+        {
+            includeGuard.ident          = ident;
+            includeGuard.ifBlockDepth   = ifBlockStack_.size();
+            includeGuard.state          = IncludeGuard::States::Inside;
+        }
+    }
 }
 
 // '#' 'elif CONSTANT-EXPRESSION'
 void PreProcessor::ParseDirectiveElif(bool skipEvaluation)
 {
+    /* An '#elif'-branch of the include-guard invalidates its detection */
+    InvalidateIncludeGuardBranch();
+
     /* Check if '#else'-directive is allowed */
     if (!TopIfBlock().elseAllowed)
         Error(R_ExpectedEndIfDirective("#elif"), true);
 
-    /* Pop if-block and parse next if-block in the condExpr-parse function */
+    /* Pop if-block and parse next if-block in the condExpr-parse function (the condition is not evaluated, if a previous branch was active) */
     auto parentIfCondition = TopIfBlock().parentActive;
-    ParseDirectiveIfOrElifCondition(true, skipEvaluation && !parentIfCondition);
+    auto wasActive = TopIfBlock().wasActive;
+    ParseDirectiveIfOrElifCondition(true, (skipEvaluation && !parentIfCondition) || wasActive);
 }
 
 void PreProcessor::ParseDirectiveIfOrElifCondition(bool isElseBranch, bool skipEvaluation)
@@ -899,8 +1948,8 @@ void PreProcessor::ParseDirectiveIfOrElifCondition(bool isElseBranch, bool skipE
 
     if (skipEvaluation)
     {
-        /* Push new if-block activation (and skip evaluation, due to currently inactive block) */
-        ParseDirectiveTokenString(true);
+        /* Push new if-block activation (and skip evaluation and macro expansion, due to currently inactive block) */
+        ParseDirectiveTokenString(false, false, false);
         if (isElseBranch)
             SetIfBlock(tkn);
         else
@@ -924,6 +1973,9 @@ void PreProcessor::ParseDirectiveElse()
 {
     auto tkn = TopIfBlock().directiveToken;
 
+    /* An '#else'-branch of the include-guard invalidates its detection */
+    InvalidateIncludeGuardBranch();
+
     /* Check if '#else'-directive is allowed */
     if (!TopIfBlock().elseAllowed)
         Error(R_ExpectedEndIfDirective("#else"), true);
@@ -935,6 +1987,14 @@ void PreProcessor::ParseDirectiveElse()
 // '#' 'endif'
 void PreProcessor::ParseDirectiveEndif()
 {
+    /* Check if this is the end of the include-guard */
+    if (!includeGuardStack_.empty())
+    {
+        auto& includeGuard = includeGuardStack_.top();
+        if (includeGuard.state == IncludeGuard::States::Inside && includeGuard.ifBlockDepth == ifBlockStack_.size())
+            includeGuard.state = IncludeGuard::States::End;
+    }
+
     /* Only pop if-block from top of the stack */
     PopIfBlock();
 }
@@ -998,7 +2058,7 @@ void PreProcessor::ParseDirectivePragma()
                     /* Write pragma out */
                     auto alignment = alignmentTkn->Spell();
                     if (alignment == "row_major" || alignment == "column_major")
-                        Out() << "#pragma pack_matrix(" << alignment << ")";
+                        WriteText("#pragma pack_matrix(" + alignment + ")");
                     else
                         Warning(R_UnknownMatrixPackAlignment(alignment), alignmentTkn.get());
                 }
@@ -1034,18 +2094,36 @@ void PreProcessor::ParseDirectiveLine()
     IgnoreWhiteSpaces();
     auto lineNumber = Accept(Tokens::IntLiteral)->Spell();
 
-    Out() << "#line " << lineNumber;
-
     /* Parse optional filename */
     IgnoreWhiteSpaces();
 
+    std::string filename;
+    bool hasFilename = false;
+
     if (Is(Tokens::StringLiteral))
     {
-        auto filename = AcceptIt()->SpellContent();
-        Out() << " \"" << filename << '\"';
+        filename    = AcceptIt()->SpellContent();
+        hasFilename = true;
     }
 
-    Out() << std::endl;
+    if (outputTokens_)
+    {
+        /* Set new line number and filename for the current source, since the output tokens keep their source positions */
+        if (!hasFilename)
+            filename = GetScanner().Source()->Filename();
+
+        auto currentLine = static_cast<int>(GetScanner().PreviousToken()->Row());
+        GetScanner().Source()->NextSourceOrigin(filename, (std::stoi(lineNumber) - currentLine - 1));
+    }
+    else
+    {
+        /* Write '#line'-directive to output */
+        if (hasFilename)
+            WriteText("#line " + lineNumber + " \"" + filename + '\"');
+        else
+            WriteText("#line " + lineNumber);
+        WriteNewLine();
+    }
 }
 
 // '#' 'error' TOKEN-STRING
@@ -1076,15 +2154,17 @@ ExprPtr PreProcessor::ParsePrimaryExpr()
     {
         case Tokens::Ident:
         {
-            if (Tkn()->Spell() == "defined")
+            if (Tkn()->EqualsSpell("defined"))
             {
                 /* Generate new token for boolean literal (which is the replacement of the 'defined IDENT' directive) */
                 return ASTFactory::MakeLiteralExpr(DataType::Int, ParseDefinedMacro());
             }
             else
             {
-                /* Parse identifier without macro expansion (this already happend at this point) */
-                return ASTFactory::MakeObjectExpr(AcceptIt()->Spell());
+                /* Parse identifier without macro expansion (this already happend at this point), but it would have been expanded if it was defined */
+                auto ident = AcceptIt()->Spell();
+                usedMacros_.insert(ident);
+                return ASTFactory::MakeObjectExpr(ident);
             }
         }
         break;
@@ -1134,7 +2214,7 @@ ExprPtr PreProcessor::ParsePrimaryExpr()
     return nullptr;
 }
 
-TokenPtrString PreProcessor::ParseDirectiveTokenString(bool expandDefinedDirective, bool ignoreComments)
+TokenPtrString PreProcessor::ParseDirectiveTokenString(bool expandDefinedDirective, bool ignoreComments, bool expandMacros)
 {
     TokenPtrString tokenString;
 
@@ -1155,16 +2235,21 @@ TokenPtrString PreProcessor::ParseDirectiveTokenString(bool expandDefinedDirecti
 
             case Tokens::Ident:
             {
-                if (expandDefinedDirective && Tkn()->Spell() == "defined")
+                if (expandDefinedDirective && Tkn()->EqualsSpell("defined"))
                 {
                     /* Generate new token for boolean literal (which is the replacement of the 'defined IDENT' directive) */
                     auto definedMacro = ParseDefinedMacro();
-                    tokenString.PushBack(Make<Token>(Tokens::IntLiteral, definedMacro));
+                    tokenString.PushBack(MakeToken(Tokens::IntLiteral, definedMacro));
                 }
-                else
+                else if (expandMacros)
                 {
                     /* Append identifier with macro expansion */
-                    tokenString.PushBack(ParseIdentAsTokenString());
+                    ParseIdentAsTokenString(tokenString);
+                }
+                else
+                {
+                    /* Append identifier without macro expansion (e.g. for a macro definition, which is expanded when it is used) */
+                    tokenString.PushBack(AcceptIt());
                 }
             }
             break;
@@ -1208,7 +2293,7 @@ TokenPtrString PreProcessor::ParseArgumentTokenString()
 
         /* Add token to token string */
         if (Is(Tokens::Ident))
-            tokenString.PushBack(ParseIdentAsTokenString());
+            ParseIdentAsTokenString(tokenString);
         else
             tokenString.PushBack(AcceptIt());
     }
@@ -1236,7 +2321,7 @@ std::string PreProcessor::ParseDefinedMacro()
         macroIdent = Accept(Tokens::Ident)->Spell();
 
     /* Determine value of integer literal ('1' if macro is defined, '0' otherwise */
-    return (IsDefined(macroIdent) ? "1" : "0");
+    return (QueryMacro(macroIdent) ? "1" : "0");
 }
 
 
@@ -1277,6 +2362,92 @@ bool PreProcessor::Macro::HasParameterList() const
     return (!parameters.empty() || emptyParamList);
 }
 
+void PreProcessor::Macro::BuildParameterRefs()
+{
+    const auto& tokens = tokenString.GetTokens();
+
+    parameterRefs.clear();
+    parameterRefs.reserve(tokens.size());
+
+    argsInOrder = true;
+    std::size_t nextIndex = 0;
+
+    for (std::size_t i = 0, n = tokens.size(); i < n; ++i)
+    {
+        const auto& tkn = *tokens[i];
+
+        ParameterRef paramRef { Macro::noParameter, false };
+
+        if (tkn.Type() == Tokens::Ident)
+        {
+            /* Identifiers are replaced by the expanded argument, unless they are an operand of the '##' operator */
+            paramRef.expanded = !IsOperandOfConcatenation(tokens, i);
+
+            if (tkn.EqualsSpell(g_vaArgsIdent))
+                paramRef.index = parameters.size();
+            else
+            {
+                const auto index = FindMacroParameter(parameters, tkn);
+                if (index < parameters.size())
+                    paramRef.index = index;
+            }
+        }
+        else if (tkn.Type() == Tokens::Directive)
+        {
+            /* Directives (i.e. the '#' operator) are replaced by the unexpanded argument as string literal */
+            const auto index = FindMacroParameter(parameters, tkn);
+            if (index < parameters.size())
+                paramRef.index = index;
+        }
+        else if (tkn.Type() == Tokens::DirectiveConcat)
+            argsInOrder = false;
+
+        if (paramRef.index < parameters.size() && paramRef.expanded && paramRef.index >= nextIndex)
+            nextIndex = paramRef.index + 1;
+        else if (paramRef.index != Macro::noParameter)
+            argsInOrder = false;
+
+        parameterRefs.push_back(paramRef);
+    }
+}
+
+
+/*
+ * HiddenToken structure
+ */
+
+PreProcessor::HiddenToken::HiddenToken() :
+    hideSet { 0                         },
+    painted { 0                         },
+    type    { Token::Types::Undefined   }
+{
+    /* Hidden tokens are copied over and over again during macro expansion, so keep them as small as possible */
+    static_assert(sizeof(HiddenToken) <= sizeof(TokenPtr) + 8, "PreProcessor::HiddenToken must not be larger than a token reference and two 32-bit words");
+}
+
+PreProcessor::HiddenToken::HiddenToken(const TokenPtr& tkn, std::size_t hideSet) :
+    tkn     { tkn                                   },
+    hideSet { static_cast<std::uint32_t>(hideSet)   },
+    painted { 0                                     },
+    type    { tkn->Type()                           }
+{
+}
+
+bool PreProcessor::HiddenToken::IsOfInterest() const
+{
+    return (type != Tokens::Comment && type != Tokens::WhiteSpace && type != Tokens::NewLine);
+}
+
+bool PreProcessor::HiddenToken::IsExpandable() const
+{
+    return (type == Tokens::Ident && !painted);
+}
+
+bool PreProcessor::HiddenToken::HasHideSet() const
+{
+    return (IsExpandable() || type == Tokens::RBracket);
+}
+
 
 /*
  * IfBlock structure
@@ -1294,4 +2465,4 @@ void PreProcessor::IfBlock::SetActive(bool activate)
 
 
 
-// ================================================================================
+// ================================================================================
\ No newline at end of file
@@ -12,6 +12,7 @@
 #include <Xsc/Xsc.h>
 #include <Xsc/Log.h>
 #include "PreProcessorScanner.h"
+#include "PreProcessorState.h"
 #include "TokenString.h"
 #include "ASTEnums.h"
 #include "Parser.h"
@@ -50,9 +51,74 @@ class PreProcessor : public Parser
             bool                    enableWarnings = false
         );
 
+        /*
+        Pre-processes the input source code like "Process", but returns the output as token string instead of source code.
+        This token string can be passed directly to the parser, so the pre-processed source code doesn't need to be scanned a second time.
+        All tokens keep the source positions from their original source code, so no '#line'-directives are generated.
+        The token string refers to memory of this pre-processor, i.e. the pre-processor must outlive the token string.
+        */
+        std::unique_ptr<TokenPtrString> ProcessTokens(
+            const SourceCodePtr&    input,
+            const std::string&      filename = "",
+            bool                    enableWarnings = false
+        );
+
+        /*
+        Pre-processes the input source code only to resolve all '#include'-directives under the active macro set (see ListDependencies).
+        No output is written, and all lines of active blocks that are not directives are skipped like inactive blocks,
+        i.e. macros are only expanded within directives.
+        */
+        bool ScanDependencies(
+            const SourceCodePtr&    input,
+            const std::string&      filename = "",
+            bool                    enableWarnings = false
+        );
+
+        /*
+        Defines the specified macros before pre-processing (see ShaderInput::defines).
+        The macro values are scanned directly into token strings, so no '#define'-directives need to be parsed.
+        */
+        void DefineMacros(const std::vector<PredefinedMacro>& macros);
+
+        // Sets the optional include cache (see ShaderInput::includeCache), which is ignored if the include handler can not use it.
+        void SetIncludeCache(IncludeCache* includeCache);
+
+        /*
+        Returns true if the include cache can be used with the specified include handler.
+        This is only the case for the default implementation of 'IncludeHandler::Include', which reads the files found by 'IncludeHandler::FindFile'.
+        */
+        static bool IsIncludeCacheCompatible(const IncludeHandler& includeHandler);
+
         // Returns a list of all defined macro identifiers after pre-processing.
         std::vector<std::string> ListDefinedMacroIdents() const;
 
+        /*
+        Returns a list of all macro identifiers that were queried (e.g. by '#ifdef' or 'defined') or expanded during pre-processing,
+        whether they were defined or not. Identifiers in the source code that are not defined as macros are only listed, if they are part of a directive.
+        */
+        std::vector<std::string> ListUsedMacroIdents() const;
+
+        /*
+        Returns the paths of all files that have been included (including the files of a loaded state),
+        in the order they were included first. Each path is resolved by the include handler if possible (see IncludeHandler::FindFile).
+        */
+        std::vector<std::string> ListDependencies() const;
+
+        // Returns all files that have been included (excluding the files of a loaded state) with a hash of their content (see PreProcessorState::includes).
+        std::vector<PreProcessorState::IncludeDesc> ListIncludes() const;
+
+        /*
+        Stores the current state (i.e. macros, once-included files, include-guards, and include counters) and the
+        specified pre-processed output into the specified state object, so other pre-processors can be seeded with it (see LoadState).
+        */
+        void SaveState(PreProcessorState& state, const TokenPtrString* output = nullptr) const;
+
+        /*
+        Loads the specified state, which must be done before pre-processing (see SaveState).
+        The output of the state is written in front of the pre-processed output.
+        */
+        void LoadState(const PreProcessorState& state);
+
     protected:
 
         // Macro object structure.
@@ -76,12 +142,27 @@ class PreProcessor : public Parser
 
             bool HasParameterList() const;
 
+            // Builds the parameter references for the replacement list, so the parameters are not searched for each expansion.
+            void BuildParameterRefs();
+
+            // Reference from a token of the replacement list to the argument it is replaced by.
+            struct ParameterRef
+            {
+                std::size_t index;      // Index of the parameter, 'parameters.size()' for '__VA_ARGS__', or 'Macro::noParameter'.
+                bool        expanded;   // Argument is expanded before the substitution, i.e. it is no operand of the '#' or '##' operator.
+            };
+
+            static const std::size_t noParameter = ~0u;
+
             TokenPtr                    identTkn;                   // Macro identifier token
             TokenPtrString              tokenString;                // Macro definition value as token string
             std::vector<std::string>    parameters;                 // Parameter identifiers
             bool                        varArgs         = false;    // Specifies whether the macro supports variadic arguments
             bool                        stdMacro        = false;    // Specifies whether the macro is a standard macro (i.e. part of the language) or not
             bool                        emptyParamList  = false;    // Macro has an empty parameter list
+            bool                        used            = false;    // Macro has been expanded at least once (see ListUsedMacroIdents)
+            std::vector<ParameterRef>   parameterRefs;              // Parameter references for each token of the replacement list (built on the first expansion)
+            bool                        argsInOrder     = false;    // Each parameter is used at most once, in order, and only as expanded argument (see PreProcessor::SubstituteMacroInOrder)
         };
 
         // Parses the specified directive, that is not part of the standard pre-processor directive (e.g. "version" or "extension" for GLSL).
@@ -105,6 +186,9 @@ class PreProcessor : public Parser
         // Returns true if the specified macro identifier is defined.
         bool IsDefined(const std::string& ident) const;
 
+        // Returns true if the specified macro identifier is defined, and records the identifier as used macro (see ListUsedMacroIdents).
+        bool QueryMacro(const std::string& ident);
+
         // Callback function when a macro is about to be defined
         virtual bool OnDefineMacro(const Macro& macro);
 
@@ -126,11 +210,17 @@ class PreProcessor : public Parser
         // Parse a token string as argument and evaluate it as expression.
         Variant ParseAndEvaluateArgumentExpr(const Token* tkn = nullptr);
 
-        // Returns the output stream as reference.
-        inline std::stringstream& Out()
-        {
-            return *output_;
-        }
+        // Writes the specified text to the output (as source code or as a single token).
+        void WriteText(const std::string& text);
+
+        // Writes the specified token to the output.
+        void WriteToken(const TokenPtr& tkn);
+
+        // Writes the specified token string to the output.
+        void WriteTokenString(const TokenPtrString& tokenString);
+
+        // Writes a new-line character to the output (only if the output is source code).
+        void WriteNewLine();
 
     private:
 
@@ -148,12 +238,91 @@ class PreProcessor : public Parser
             bool            elseAllowed     = true;     // Is an else-block allowed?
         };
 
+        // Detection state of an include-guard (i.e. '#ifndef IDENT' ... '#endif' around the entire file).
+        struct IncludeGuard
+        {
+            enum class States
+            {
+                Start,      // No token has been parsed yet
+                Inside,     // Inside the '#ifndef'-block of the include-guard
+                End,        // After the '#endif'-directive of the include-guard
+                Invalid,    // Source file is not protected by an include-guard
+            };
+
+            std::string     ident;                      // Macro identifier of the include-guard
+            std::size_t     ifBlockDepth    = 0;        // Size of the if-block stack inside the include-guard
+            States          state           = States::Start;
+        };
+
+        // Source file that has been included.
+        struct IncludedFile
+        {
+            std::string     filename;
+            bool            useSearchPaths  = false;
+            SourceCodePtr   source;
+        };
+
+        // Token with the hide-set of all macros that must not be expanded again, when this token is rescanned after a macro expansion.
+        struct HiddenToken
+        {
+            HiddenToken();
+            HiddenToken(const TokenPtr& tkn, std::size_t hideSet = 0);
+
+            // Returns true if this token is neither a white space, new-line, nor comment (see DefaultTokenOfInterestFunctor).
+            bool IsOfInterest() const;
+
+            // Returns true if this token is an identifier that might be expanded, i.e. it has not been painted yet.
+            bool IsExpandable() const;
+
+            // Returns true if the hide-set of this token is used at all, i.e. for identifiers that might be expanded and for closing brackets.
+            bool HasHideSet() const;
+
+            TokenPtr        tkn;
+            std::uint32_t   hideSet : 31;   // Index of the first hide-set node (see hideSetNodes_), or 0 for the empty hide-set.
+            std::uint32_t   painted : 1;    // Identifier that can never be expanded again (no macro or in its hide-set), to avoid repeated look ups.
+            Token::Types    type;           // Type of the token, so the token itself is not accessed while tokens are moved around.
+        };
+
+        // Node of a hide-set, which is stored as a linked list of macros.
+        struct HideSetNode
+        {
+            const Macro*    macro;
+            std::size_t     next;
+        };
+
+        // Entry of a direct-mapped cache for hide-set operations (see HideSetAdd and HideSetUnion).
+        struct HideSetCacheEntry
+        {
+            std::size_t     generation;
+            std::size_t     lhs;
+            std::uintptr_t  rhs;
+            std::size_t     result;
+        };
+
+        // Token range [begin, end) within one of the macro expansion buffers.
+        struct TokenRange
+        {
+            std::size_t     begin;
+            std::size_t     end;
+        };
+
+        // Result of the attempt to collect the arguments for a macro invocation (see CollectMacroArguments).
+        enum class MacroInvocation
+        {
+            Invoked,                // Arguments have been collected.
+            NoArguments,            // Macro identifier is not followed by an argument list.
+            NoArgumentsWithBlank,   // Macro identifier is not followed by an argument list, and white spaces have been ignored in the scanner.
+        };
+
         using MacroPtr = std::shared_ptr<Macro>;
 
         /* === Functions === */
 
         ScannerPtr MakeScanner() override;
 
+        // Pre-processes the input source code and writes the result to the current output. Returns false on failure.
+        bool ProcessInput(const SourceCodePtr& input, const std::string& filename, bool enableWarnings);
+
         void PushScannerSource(const SourceCodePtr& source, const std::string& filename = "") override;
         bool PopScannerSource() override;
 
@@ -164,23 +333,105 @@ class PreProcessor : public Parser
         // Returns the if-block state from the top of the stack. If the stack is empty, the default state is returned.
         IfBlock TopIfBlock() const;
 
+        // Invalidates the include-guard detection of the current source file, if the specified token is outside of the include-guard.
+        void UpdateIncludeGuard(const Token& tkn);
+
+        // Invalidates the include-guard detection of the current source file, if an else-branch for the include-guard is parsed.
+        void InvalidateIncludeGuardBranch();
+
         /*
-        Replaces all identifiers (specified by 'macro.parameters') in the token string (specified by 'macro.tokenString')
-        by the respective replacement (specified by 'arguments'). The number of identifiers and the number of replacements must be equal.
+        Expands all macros on the expansion stack above the specified floor, and appends the result to the output.
+        The expanded tokens are rescanned, but a macro is never expanded again for a token whose hide-set contains that macro.
+        If 'readScanner' is true, arguments for a function-like macro can also be read from the scanner.
         */
-        TokenPtrString ExpandMacro(const Macro& macro, const std::vector<TokenPtrString>& arguments);
+        void ExpandMacros(std::size_t floor, bool readScanner, std::vector<HiddenToken>& output);
+
+        // Returns the macro the specified identifier refers to, or null if there is no such macro or it is in the hide-set of the identifier.
+        const Macro* FindMacroForExpansion(const HiddenToken& identTkn);
+
+        // Expands the specified macro invocation and pushes the replacement onto the expansion stack. Returns false if nothing was expanded.
+        bool ExpandMacroIdent(const HiddenToken& identTkn, const Macro& macro, std::size_t floor, bool readScanner, std::vector<HiddenToken>& output);
+
+        /*
+        Finds the argument list for the specified macro invocation on top of the expansion stack (or reads it from the scanner),
+        and stores the stack positions of the brackets and commas in the argument bounds.
+        */
+        MacroInvocation CollectMacroArguments(const Macro& macro, const Token& identTkn, std::size_t floor, bool readScanner, std::size_t& numArgs);
+
+        // Reads the rest of an argument list from the scanner and inserts it into the expansion stack at the specified floor. Returns the number of tokens.
+        std::size_t ReadMacroArgumentsFromScanner(std::size_t floor, int bracketLevel);
+
+        // Removes the argument list from the expansion stack, and stores the unexpanded and expanded arguments as they are used by the specified macro.
+        void PrepareMacroArguments(const Macro& macro, std::size_t argBoundsBegin, std::size_t numArgs, std::vector<HiddenToken>& expandedArgTokens);
+
+        /*
+        Appends the replacement list of the specified macro with the specified hide-set to the output,
+        where all parameters are replaced by the arguments that start at the specified index of the argument ranges.
+        Returns the position of the first token in the output that must be rescanned, or the size of the output if there is none.
+        */
+        std::size_t SubstituteMacro(
+            const Macro& macro, std::size_t hideSet, std::size_t argRangesBegin, std::size_t numArgs,
+            const std::vector<HiddenToken>& expandedArgTokens, std::vector<HiddenToken>& output
+        );
+
+        /*
+        Appends either the unexpanded argument, or the expanded argument (if 'expandedArgTokens' is non-null) to the output,
+        and lowers 'rescanBegin' to the position of the first appended token that must be rescanned.
+        */
+        void SubstituteMacroArgument(
+            std::size_t argRangeIndex, std::size_t hideSet, const std::vector<HiddenToken>* expandedArgTokens,
+            std::vector<HiddenToken>& output, std::size_t& rescanBegin
+        );
+
+        /*
+        Appends the replacement list of the specified macro like SubstituteMacro, but expands each argument right into the output,
+        when it is reached in the replacement list. This requires a macro that uses its arguments in order (see Macro::argsInOrder),
+        and saves to copy the arguments from one buffer into another, which is the common case for deeply nested macro invocations.
+        */
+        std::size_t SubstituteMacroInOrder(
+            const Macro& macro, std::size_t hideSet, std::size_t argBoundsBegin, std::size_t numArgs, std::vector<HiddenToken>& output
+        );
+
+        // Replaces the hide-sets of all tokens in the output from the specified position by their union with the specified hide-set.
+        void UniteHideSets(std::vector<HiddenToken>& output, std::size_t outputBegin, std::size_t hideSet, std::size_t& rescanBegin);
+
+        // Returns the hide-set with the specified macro added to it.
+        std::size_t HideSetAdd(std::size_t hideSet, const Macro* macro);
+
+        // Returns the union of both hide-sets.
+        std::size_t HideSetUnion(std::size_t lhs, std::size_t rhs);
+
+        // Returns the intersection of both hide-sets.
+        std::size_t HideSetIntersection(std::size_t lhs, std::size_t rhs);
+
+        // Returns true if the specified hide-set contains the specified macro.
+        bool HideSetContains(std::size_t hideSet, const Macro* macro) const;
+
+        // Returns the entry of the specified hide-set cache for the specified operands, and resets it if it belongs to other operands.
+        HideSetCacheEntry& FetchHideSetCacheEntry(std::vector<HideSetCacheEntry>& cache, std::size_t lhs, std::uintptr_t rhs, bool& cached);
+
+        // Returns the shared white space token for macro expansions.
+        TokenPtr GetBlankToken();
+
+        // Returns the shared comma token for macro expansions.
+        TokenPtr GetCommaToken();
+
+        // Scans the specified macro value into a token string (without leading and trailing white spaces).
+        TokenPtrString ScanMacroValue(const std::string& value);
 
         // Writes a '#line'-directive to the output with the current source position and filename.
         void WritePosToLineDirective();
 
+        // Writes the output of a previously loaded state (see LoadState) in front of the output of the specified main file.
+        void WriteLoadedStateOutput(const std::string& filename);
+
         /* ----- Parsing ----- */
 
         void            ParseProgram();
 
         void            ParesComment();
         void            ParseIdent();
-        TokenPtrString  ParseIdentAsTokenString();
-        TokenPtrString  ParseIdentArgumentsForMacro(const TokenPtr& identToken, const Macro& macro);
+        void            ParseIdentAsTokenString(TokenPtrString& tokenString);
         void            ParseMisc();
 
         void            ParseDirective();
@@ -202,7 +453,7 @@ class PreProcessor : public Parser
         ExprPtr         ParseExpr();
         ExprPtr         ParsePrimaryExpr() override;
 
-        TokenPtrString  ParseDirectiveTokenString(bool expandDefinedDirective = false, bool ignoreComments = false);
+        TokenPtrString  ParseDirectiveTokenString(bool expandDefinedDirective = false, bool ignoreComments = false, bool expandMacros = true);
         TokenPtrString  ParseArgumentTokenString();
 
         std::string     ParseDefinedMacro();
@@ -210,12 +461,43 @@ class PreProcessor : public Parser
         /* === Members === */
 
         IncludeHandler&                     includeHandler_;
+        IncludeCache*                       includeCache_           = nullptr;
 
         std::unique_ptr<std::stringstream>  output_;
+        std::unique_ptr<TokenPtrString>     outputTokens_;
 
         std::map<std::string, MacroPtr>     macros_;
+        std::set<std::string>               usedMacros_;    // Macros that were queried or expanded (see ListUsedMacroIdents)
         std::set<std::string>               onceIncluded_;
+        std::map<std::string, std::string>  includeGuards_;  // Include-guard macro identifier for each detected file
+        std::stack<IncludeGuard>            includeGuardStack_;
         std::map<std::string, std::size_t>  includeCounter_; // Counter for each included file
+        std::vector<IncludedFile>           includedFiles_;
+        std::vector<IncludedFile>           loadedStateIncludes_;   // Included files of a loaded state (without source code)
+
+        TokenPtrString                      loadedStateOutput_;
+
+        /*
+        Buffers for the macro expansion, which are reused for all expansions to avoid memory allocations.
+        Each macro invocation only appends to these buffers and truncates them to their previous size when it is done.
+        */
+        std::vector<HiddenToken>            expansionStack_;        // Tokens to be rescanned (the top is the next token)
+        std::vector<HiddenToken>            expansionOutput_;
+        std::vector<std::size_t>            macroArgBounds_;        // Positions of the brackets and commas of argument lists on the expansion stack
+        std::vector<unsigned char>          macroArgUsage_;
+        std::vector<HiddenToken>            macroArgTokens_;        // Tokens of unexpanded macro arguments
+        std::vector<TokenRange>             macroArgRanges_;        // Pairs of unexpanded and expanded ranges for each macro argument
+        std::vector<HiddenToken>            expandedArgTokens_[2];  // Expanded macro arguments (alternating per nesting level, so the substitution can be written into the other one)
+        std::vector<HideSetNode>            hideSetNodes_;
+        std::vector<HideSetCacheEntry>      hideSetAddCache_;       // Caches the nodes of all hide-sets, so that equal hide-sets mostly have the same index
+        std::vector<HideSetCacheEntry>      hideSetUnionCache_;
+        std::size_t                         hideSetGeneration_      = 0;    // Invalidates the caches for each outermost macro expansion
+        std::size_t                         macroExpansionDepth_    = 0;
+        std::string                         macroIdentBuffer_;
+        std::string                         outputBuffer_;          // Buffer to write a token string to the output at once (see WriteTokenString)
+        TokenPtrString                      identTokenString_;
+        TokenPtr                            commaTkn_;
+        TokenPtr                            blankTkn_;
 
         /*
         Stack to store the info which if-block in the hierarchy is active.
@@ -225,6 +507,7 @@ class PreProcessor : public Parser
 
         bool                                writeLineMarks_         = true;
         bool                                writeLineMarkFilenames_ = true;
+        bool                                scanDependenciesOnly_   = false;
 
 };
 
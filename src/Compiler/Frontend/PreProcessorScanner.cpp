@@ -30,8 +30,6 @@ TokenPtr PreProcessorScanner::Next()
 
 TokenPtr PreProcessorScanner::ScanToken()
 {
-    std::string spell;
-
     /* Scan directive (beginning with '#'), or directive concatenation ('##') */
     if (Is('#'))
         return ScanDirectiveOrDirectiveConcat();
@@ -57,54 +55,54 @@ TokenPtr PreProcessorScanner::ScanToken()
     /* Scan operators */
     if (Is('='))
     {
-        spell += TakeIt();
+        TakeIt();
         if (Is('='))
-            return Make(Tokens::BinaryOp, spell, true);
-        return Make(Tokens::Misc, spell);
+            return Make(Tokens::BinaryOp, true);
+        return Make(Tokens::Misc);
     }
 
     if (Is('!'))
     {
-        spell += TakeIt();
+        TakeIt();
         if (Is('='))
-            return Make(Tokens::BinaryOp, spell, true);
-        return Make(Tokens::UnaryOp, spell);
+            return Make(Tokens::BinaryOp, true);
+        return Make(Tokens::UnaryOp);
     }
 
     if (Is('<'))
     {
-        spell += TakeIt();
+        TakeIt();
         if (Is('<'))
-            spell += TakeIt();
+            TakeIt();
         else if (Is('='))
-            spell += TakeIt();
-        return Make(Tokens::BinaryOp, spell);
+            TakeIt();
+        return Make(Tokens::BinaryOp);
     }
 
     if (Is('>'))
     {
-        spell += TakeIt();
+        TakeIt();
         if (Is('>'))
-            spell += TakeIt();
+            TakeIt();
         else if (Is('='))
-            spell += TakeIt();
-        return Make(Tokens::BinaryOp, spell);
+            TakeIt();
+        return Make(Tokens::BinaryOp);
     }
 
     if (Is('&'))
     {
-        spell += TakeIt();
+        TakeIt();
         if (Is('&'))
-            spell += TakeIt();
-        return Make(Tokens::BinaryOp, spell);
+            TakeIt();
+        return Make(Tokens::BinaryOp);
     }
 
     if (Is('|'))
     {
-        spell += TakeIt();
+        TakeIt();
         if (Is('|'))
-            spell += TakeIt();
-        return Make(Tokens::BinaryOp, spell);
+            TakeIt();
+        return Make(Tokens::BinaryOp);
     }
 
     /* Scan punctuation, special characters and brackets */
@@ -131,8 +129,6 @@ TokenPtr PreProcessorScanner::ScanToken()
 
 TokenPtr PreProcessorScanner::ScanDirectiveOrDirectiveConcat()
 {
-    std::string spell;
-
     /* Take directive begin '#' */
     Take('#');
 
@@ -140,8 +136,7 @@ TokenPtr PreProcessorScanner::ScanDirectiveOrDirectiveConcat()
     if (Is('#'))
     {
         TakeIt();
-        spell = "##";
-        return Make(Token::Types::DirectiveConcat, spell);
+        return Make(Token::Types::DirectiveConcat);
     }
 
     /* Ignore white spaces (but not new-lines) */
@@ -151,23 +146,22 @@ TokenPtr PreProcessorScanner::ScanDirectiveOrDirectiveConcat()
     StoreStartPos();
 
     while (std::isalpha(UChr()))
-        spell += TakeIt();
+        TakeIt();
 
     /* Return as identifier */
-    return Make(Token::Types::Directive, spell);
+    return Make(Token::Types::Directive);
 }
 
 TokenPtr PreProcessorScanner::ScanIdentifier()
 {
     /* Scan identifier string */
-    std::string spell;
-    spell += TakeIt();
+    TakeIt();
 
     while (std::isalnum(UChr()) || Is('_'))
-        spell += TakeIt();
+        TakeIt();
 
     /* Return as identifier */
-    return Make(Token::Types::Ident, spell);
+    return Make(Token::Types::Ident);
 }
 
 
@@ -0,0 +1,98 @@
+/*
+ * PreProcessorState.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_PRE_PROCESSOR_STATE_H
+#define XSC_PRE_PROCESSOR_STATE_H
+
+
+#include <Xsc/Targets.h>
+#include "Token.h"
+#include "SourceCode.h"
+#include "Hash.h"
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+
+namespace Xsc
+{
+
+
+class PreProcessorSnapshot;
+struct ShaderInput;
+
+/*
+State of the pre-processor after a source (e.g. a prelude of common macros and headers) has been processed (see PreProcessorSnapshot).
+All tokens are stored independently of any token arena, so the state can be loaded into any other pre-processor.
+*/
+struct PreProcessorState
+{
+    // Source origin of a token (see SourceOrigin).
+    struct Origin
+    {
+        std::string                 filename;
+        int                         lineOffset      = 0;
+    };
+
+    // Token with its spelling and source position.
+    struct TokenDesc
+    {
+        Token::Types                type            = Token::Types::Undefined;
+        std::string                 spell;
+        unsigned int                row             = 0;
+        unsigned int                column          = 0;
+        std::uint32_t               origin          = 0;        // One-based index into the origin list (0 for no origin)
+    };
+
+    // Macro definition (see PreProcessor::Macro).
+    struct MacroDesc
+    {
+        TokenDesc                   identTkn;
+        std::vector<TokenDesc>      tokenString;
+        std::vector<std::string>    parameters;
+        bool                        varArgs         = false;
+        bool                        stdMacro        = false;
+        bool                        emptyParamList  = false;
+    };
+
+    // Include file the state depends on, with a hash of its content.
+    struct IncludeDesc
+    {
+        std::string                 filename;
+        bool                        useSearchPaths  = false;
+        std::uint64_t               contentHash     = 0;
+    };
+
+    InputShaderVersion                                  shaderVersion   = InputShaderVersion::HLSL5;
+    std::vector<Origin>                                 origins;
+    std::vector<MacroDesc>                              macros;
+    std::vector<std::string>                            onceIncluded;
+    std::vector<std::pair<std::string, std::string>>    includeGuards;  // Pairs of filename and include-guard macro identifier
+    std::vector<std::pair<std::string, std::size_t>>    includeCounter; // Pairs of filename and include counter
+    std::vector<IncludeDesc>                            includes;
+    std::vector<TokenDesc>                              output;         // Pre-processed output tokens
+};
+
+// Returns the internal state of the specified snapshot (see PreProcessorSnapshot).
+const PreProcessorState& GetPreProcessorState(const PreProcessorSnapshot& snapshot);
+
+// Returns true if all specified include files can still be read with the include handler of the specified input, and their content is unchanged.
+bool ValidateIncludes(const std::vector<PreProcessorState::IncludeDesc>& includes, const ShaderInput& inputDesc);
+
+// Creates the source code of the specified shader input, or throws an std::invalid_argument if the input has no source code.
+SourceCodePtr MakeInputSource(const ShaderInput& inputDesc);
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
\ No newline at end of file
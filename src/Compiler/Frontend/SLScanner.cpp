@@ -30,8 +30,6 @@ TokenPtr SLScanner::Next()
 
 TokenPtr SLScanner::ScanToken()
 {
-    std::string spell;
-
     /* Scan directive (beginning with '#') */
     if (Is('#'))
         return ScanDirective();
@@ -53,45 +51,45 @@ TokenPtr SLScanner::ScanToken()
     /* Scan operators */
     if (Is('='))
     {
-        spell += TakeIt();
+        TakeIt();
         if (Is('='))
-            return Make(Tokens::BinaryOp, spell, true);
-        return Make(Tokens::AssignOp, spell);
+            return Make(Tokens::BinaryOp, true);
+        return Make(Tokens::AssignOp);
     }
 
     if (Is('~'))
-        return Make(Tokens::UnaryOp, spell, true);
+        return Make(Tokens::UnaryOp, true);
 
     if (Is('!'))
     {
-        spell += TakeIt();
+        TakeIt();
         if (Is('='))
-            return Make(Tokens::BinaryOp, spell, true);
-        return Make(Tokens::UnaryOp, spell);
+            return Make(Tokens::BinaryOp, true);
+        return Make(Tokens::UnaryOp);
     }
 
     if (Is('%'))
     {
-        spell += TakeIt();
+        TakeIt();
         if (Is('='))
-            return Make(Tokens::AssignOp, spell, true);
-        return Make(Tokens::BinaryOp, spell);
+            return Make(Tokens::AssignOp, true);
+        return Make(Tokens::BinaryOp);
     }
 
     if (Is('*'))
     {
-        spell += TakeIt();
+        TakeIt();
         if (Is('='))
-            return Make(Tokens::AssignOp, spell, true);
-        return Make(Tokens::BinaryOp, spell);
+            return Make(Tokens::AssignOp, true);
+        return Make(Tokens::BinaryOp);
     }
 
     if (Is('^'))
     {
-        spell += TakeIt();
+        TakeIt();
         if (Is('='))
-            return Make(Tokens::AssignOp, spell, true);
-        return Make(Tokens::BinaryOp, spell);
+            return Make(Tokens::AssignOp, true);
+        return Make(Tokens::BinaryOp);
     }
 
     if (Is('+'))
@@ -104,30 +102,30 @@ TokenPtr SLScanner::ScanToken()
 
     if (Is('&'))
     {
-        spell += TakeIt();
+        TakeIt();
         if (Is('='))
-            return Make(Tokens::AssignOp, spell, true);
+            return Make(Tokens::AssignOp, true);
         if (Is('&'))
-            return Make(Tokens::BinaryOp, spell, true);
-        return Make(Tokens::BinaryOp, spell);
+            return Make(Tokens::BinaryOp, true);
+        return Make(Tokens::BinaryOp);
     }
 
     if (Is('|'))
     {
-        spell += TakeIt();
+        TakeIt();
         if (Is('='))
-            return Make(Tokens::AssignOp, spell, true);
+            return Make(Tokens::AssignOp, true);
         if (Is('|'))
-            return Make(Tokens::BinaryOp, spell, true);
-        return Make(Tokens::BinaryOp, spell);
+            return Make(Tokens::BinaryOp, true);
+        return Make(Tokens::BinaryOp);
     }
 
     if (Is(':'))
     {
-        spell += TakeIt();
+        TakeIt();
         if (Is(':'))
-            return Make(Tokens::DColon, spell, true);
-        return Make(Tokens::Colon, spell);
+            return Make(Tokens::DColon, true);
+        return Make(Tokens::Colon);
     }
 
     /* Scan punctuation, special characters and brackets */
@@ -151,8 +149,6 @@ TokenPtr SLScanner::ScanToken()
 
 TokenPtr SLScanner::ScanDirective()
 {
-    std::string spell;
-
     /* Take directive begin '#' */
     Take('#');
 
@@ -163,70 +159,66 @@ TokenPtr SLScanner::ScanDirective()
     StoreStartPos();
 
     while (std::isalpha(UChr()))
-        spell += TakeIt();
+        TakeIt();
 
     /* Return as identifier */
-    return Make(Token::Types::Directive, spell);
+    return Make(Token::Types::Directive);
 }
 
 TokenPtr SLScanner::ScanIdentifier()
 {
     /* Scan identifier string */
-    std::string spell;
-    spell += TakeIt();
+    TakeIt();
 
     while (std::isalnum(UChr()) || Is('_'))
-        spell += TakeIt();
+        TakeIt();
 
     /* Scan identifier or keyword */
-    return ScanIdentifierOrKeyword(std::move(spell));
+    return ScanIdentifierOrKeyword();
 }
 
 TokenPtr SLScanner::ScanAssignShiftRelationOp(const char chr)
 {
-    std::string spell;
-    spell += TakeIt();
+    TakeIt();
 
     if (Is(chr))
     {
-        spell += TakeIt();
+        TakeIt();
 
         if (Is('='))
-            return Make(Tokens::AssignOp, spell, true);
+            return Make(Tokens::AssignOp, true);
 
-        return Make(Tokens::BinaryOp, spell);
+        return Make(Tokens::BinaryOp);
     }
 
     if (Is('='))
-        spell += TakeIt();
+        TakeIt();
 
-    return Make(Tokens::BinaryOp, spell);
+    return Make(Tokens::BinaryOp);
 }
 
 TokenPtr SLScanner::ScanPlusOp()
 {
-    std::string spell;
-    spell += TakeIt();
+    TakeIt();
 
     if (Is('+'))
-        return Make(Tokens::UnaryOp, spell, true);
+        return Make(Tokens::UnaryOp, true);
     else if (Is('='))
-        return Make(Tokens::AssignOp, spell, true);
+        return Make(Tokens::AssignOp, true);
 
-    return Make(Tokens::BinaryOp, spell);
+    return Make(Tokens::BinaryOp);
 }
 
 TokenPtr SLScanner::ScanMinusOp()
 {
-    std::string spell;
-    spell += TakeIt();
+    TakeIt();
 
     if (Is('-'))
-        return Make(Tokens::UnaryOp, spell, true);
+        return Make(Tokens::UnaryOp, true);
     else if (Is('='))
-        return Make(Tokens::AssignOp, spell, true);
+        return Make(Tokens::AssignOp, true);
 
-    return Make(Tokens::BinaryOp, spell);
+    return Make(Tokens::BinaryOp);
 }
 
 
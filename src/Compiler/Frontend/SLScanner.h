@@ -29,7 +29,7 @@ class SLScanner : public Scanner
 
     protected:
 
-        virtual TokenPtr ScanIdentifierOrKeyword(std::string&& spell) = 0;
+        TokenPtr ScanIdentifierOrKeyword() override = 0;
 
     private:
 
@@ -8,6 +8,7 @@
 #include "Scanner.h"
 #include "Helper.h"
 #include "ReportIdents.h"
+#include <algorithm>
 #include <cctype>
 
 
@@ -20,18 +21,35 @@ Scanner::Scanner(Log* log) :
 {
 }
 
-bool Scanner::ScanSource(const SourceCodePtr& source)
+bool Scanner::ScanSource(const SourceCodePtr& source, TokenArena& tokenArena)
 {
     if (source && source->IsValid())
     {
         /* Store source stream and take first character */
-        source_ = source;
+        source_     = source;
+        tokenArena_ = &tokenArena;
+        tokenArena_->RetainSource(source);
         TakeIt();
         return true;
     }
     return false;
 }
 
+bool Scanner::ScanTokenString(const TokenPtrString& tokenString, const SourceCodePtr& source, TokenArena& tokenArena)
+{
+    if (source && source->IsValid())
+    {
+        /* Store token string and source stream (only used as report context), and start with an empty chunk */
+        source_         = source;
+        tokenArena_     = &tokenArena;
+        streamTokens_   = &(tokenString.GetTokens());
+        streamPos_      = 0;
+        SetChunk(nullptr, 0, false);
+        return true;
+    }
+    return false;
+}
+
 void Scanner::PushTokenString(const TokenPtrString& tokenString)
 {
     tokenStringItStack_.push_back(tokenString.Begin());
@@ -52,6 +70,63 @@ TokenPtrString::ConstIterator Scanner::TopTokenStringIterator() const
     return TokenPtrString::ConstIterator();
 }
 
+void Scanner::SkipToNextDirective()
+{
+    if (!tokenStringItStack_.empty() || streamTokens_ != nullptr)
+        return;
+
+    while (!Is(0) && !Is('#'))
+    {
+        const auto chr = TakeIt();
+
+        switch (chr)
+        {
+            case '/':
+            {
+                if (Is('/'))
+                {
+                    /* Ignore comment line (which can also be continued with '\') */
+                    while (!Is(0) && !Is('\n'))
+                    {
+                        if (TakeIt() == '\\' && (Is('\r') || Is('\n')))
+                        {
+                            if (Is('\r'))
+                                TakeIt();
+                            if (Is('\n'))
+                                TakeIt();
+                        }
+                    }
+                }
+                else if (Is('*'))
+                {
+                    /* Ignore comment block */
+                    TakeIt();
+                    while (!Is(0))
+                    {
+                        if (TakeIt() == '*' && Is('/'))
+                        {
+                            TakeIt();
+                            break;
+                        }
+                    }
+                }
+            }
+            break;
+
+            case '\"':
+            case '\'':
+            {
+                /* Ignore literal (comment delimiters inside of it must not be considered) */
+                SkipRawLiteral(chr);
+            }
+            break;
+
+            default:
+            break;
+        }
+    }
+}
+
 TokenPtr Scanner::ActiveToken() const
 {
     return activeToken_;
@@ -98,6 +173,11 @@ TokenPtr Scanner::NextToken(bool scanComments, bool scanWhiteSpaces)
     return tkn;
 }
 
+TokenPtr Scanner::ScanIdentifierOrKeyword()
+{
+    return Make(Tokens::Ident);
+}
+
 //private
 TokenPtr Scanner::NextTokenScan(bool scanComments, bool scanWhiteSpaces)
 {
@@ -108,85 +188,186 @@ TokenPtr Scanner::NextTokenScan(bool scanComments, bool scanWhiteSpaces)
             /* Ignore white spaces and comments */
             comment_.clear();
             commentFirstLine_ = true;
-            bool hasComments = true;
 
-            do
-            {
-                /* Scan or ignore white spaces */
-                if (scanWhiteSpaces && std::isspace(UChr()))
-                {
-                    StoreStartPos();
-                    return ScanWhiteSpaces(false);
-                }
-                else
-                    IgnoreWhiteSpaces();
+            if (streamTokens_ != nullptr)
+                return NextTokenFromTokenString();
+            else
+                return NextTokenScanComments(scanComments, scanWhiteSpaces);
+        }
+        catch (const Report& err)
+        {
+            /* Add to error and scan next token */
+            if (log_)
+                log_->SubmitReport(err);
+        }
+    }
 
-                /* Check for end-of-file */
-                if (Is(0))
-                {
-                    StoreStartPos();
-                    return Make(Tokens::EndOfStream);
-                }
+    return nullptr;
+}
 
-                /* Scan commentaries */
-                if (Is('/'))
-                {
-                    StoreStartPos();
-                    commentStartPos_ = nextStartPos_.Column();
+//private
+TokenPtr Scanner::NextTokenScanComments(bool scanComments, bool scanWhiteSpaces)
+{
+    bool hasComments = true;
 
-                    auto prevChr = TakeIt();
+    do
+    {
+        /* Scan or ignore white spaces */
+        if (scanWhiteSpaces && std::isspace(UChr()))
+        {
+            StoreStartPos();
+            return ScanWhiteSpaces(false);
+        }
+        else
+            IgnoreWhiteSpaces();
 
-                    if (Is('/'))
-                    {
-                        auto tkn = ScanCommentLine(scanComments);
-                        if (tkn)
-                            return tkn;
-                    }
-                    else if (Is('*'))
-                    {
-                        auto tkn = ScanCommentBlock(scanComments);
-                        if (tkn)
-                            return tkn;
-                    }
-                    else
-                    {
-                        std::string spell;
-                        spell += prevChr;
+        /* Check for end-of-file */
+        if (Is(0))
+        {
+            StoreStartPos();
+            return MakeEndOfStream();
+        }
 
-                        if (Is('='))
-                        {
-                            spell += TakeIt();
-                            return Make(Tokens::AssignOp, spell);
-                        }
+        /* Scan commentaries */
+        if (Is('/'))
+        {
+            StoreStartPos();
+            commentStartPos_ = nextStartPos_.Column();
 
-                        return Make(Tokens::BinaryOp, spell);
-                    }
-                }
-                else
-                    hasComments = false;
+            TakeIt();
+
+            if (Is('/'))
+            {
+                auto tkn = ScanCommentLine(scanComments);
+                if (tkn)
+                    return tkn;
+            }
+            else if (Is('*'))
+            {
+                auto tkn = ScanCommentBlock(scanComments);
+                if (tkn)
+                    return tkn;
+            }
+            else
+            {
+                if (Is('='))
+                    return Make(Tokens::AssignOp, true);
+                return Make(Tokens::BinaryOp);
             }
-            while (hasComments);
+        }
+        else
+            hasComments = false;
+    }
+    while (hasComments);
 
-            /* Scan next token */
-            StoreStartPos();
-            return ScanToken();
+    /* Scan next token */
+    StoreStartPos();
+    return ScanToken();
+}
+
+//private
+TokenPtr Scanner::NextTokenFromTokenString()
+{
+    const auto& tokens = *streamTokens_;
+
+    while (true)
+    {
+        /* Scan remaining characters of the current chunk */
+        IgnoreWhiteSpaces();
+
+        if (!Is(0))
+        {
+            if (auto tkn = NextTokenScanComments(false, false))
+            {
+                if (tkn->Type() != Tokens::EndOfStream)
+                    return tkn;
+            }
+            continue;
         }
-        catch (const Report& err)
+
+        /* Check for end of token string */
+        if (streamPos_ >= tokens.size())
+            return MakeEndOfStream();
+
+        const auto& tkn = tokens[streamPos_];
+
+        switch (tkn->Type())
         {
-            /* Add to error and scan next token */
-            if (log_)
-                log_->SubmitReport(err);
+            case Tokens::WhiteSpace:
+            case Tokens::NewLine:
+            {
+                /* Ignore white spaces */
+                ++streamPos_;
+            }
+            break;
+
+            case Tokens::Comment:
+            {
+                /* Append commentary from comment token */
+                AppendCommentToken(*tkn);
+                ++streamPos_;
+            }
+            break;
+
+            case Tokens::Ident:
+            case Tokens::IntLiteral:
+            case Tokens::FloatLiteral:
+            case Tokens::StringLiteral:
+            {
+                /* Take identifiers and literals without scanning them again (only identifiers are classified as keywords) */
+                SetChunkFromTokens(streamPos_, streamPos_ + 1);
+                chunkPos_ = chunkSize_ + 1;
+
+                nextStartPos_       = tkn->Pos();
+                nextStartOffset_    = 0;
+
+                ++streamPos_;
+
+                if (tkn->Type() == Tokens::Ident)
+                    return ScanIdentifierOrKeyword();
+                else
+                    return tokenArena_->MakeTokenView(*tkn, tkn->Type(), tkn->SpellData(), tkn->SpellSize());
+            }
+            break;
+
+            default:
+            {
+                /* Scan all adjacent tokens again (e.g. '+' and '=' must be merged to "+=") */
+                auto first = streamPos_;
+
+                for (++streamPos_; streamPos_ < tokens.size(); ++streamPos_)
+                {
+                    const auto type = tokens[streamPos_]->Type();
+                    if ( type == Tokens::WhiteSpace   || type == Tokens::NewLine      || type == Tokens::Comment       ||
+                         type == Tokens::Ident        || type == Tokens::IntLiteral   || type == Tokens::FloatLiteral  ||
+                         type == Tokens::StringLiteral )
+                    {
+                        break;
+                    }
+                }
+
+                SetChunkFromTokens(first, streamPos_);
+                TakeIt();
+            }
+            break;
         }
     }
-
-    return nullptr;
 }
 
 //private
 void Scanner::StoreStartPos()
 {
     /* Store current source position as start position for the next token */
-    nextStartPos_ = source_->Pos();
+    if (streamTokens_ != nullptr)
+    {
+        nextStartOffset_    = (chunkPos_ > 0 ? chunkPos_ - 1 : 0);
+        nextStartPos_       = ChunkPos(nextStartOffset_);
+    }
+    else
+    {
+        nextStartPos_       = source_->Pos();
+        nextStartOffset_    = source_->Offset();
+    }
 }
 
 char Scanner::Take(char chr)
@@ -200,33 +381,65 @@ char Scanner::TakeIt()
 {
     /* Get next character and return previous one */
     auto prevChr = chr_;
-    chr_ = source_->Next();
+    chr_ = (streamTokens_ != nullptr ? NextChunkChar() : source_->Next());
     return prevChr;
 }
 
 TokenPtr Scanner::Make(const Token::Types& type, bool takeChr)
 {
     if (takeChr)
+        TakeIt();
+
+    const auto offset = NextOffset();
+
+    if (offset <= nextStartOffset_)
+        return tokenArena_->MakeToken(Pos(), type);
+
+    if (streamTokens_ == nullptr)
     {
-        std::string spell;
-        spell += TakeIt();
-        return std::make_shared<Token>(Pos(), type, std::move(spell));
+        /* Refer to the source buffer, unless the spelling ends with the new-line character that follows the buffer */
+        if (offset <= source_->Size())
+            return tokenArena_->MakeTokenView(Pos(), type, source_->Data() + nextStartOffset_, offset - nextStartOffset_);
+        else
+            return tokenArena_->MakeToken(Pos(), type, ScannedSpell());
     }
-    return std::make_shared<Token>(Pos(), type);
+
+    /* Refer to the token spellings of the chunk, unless they have been concatenated into the temporary chunk buffer */
+    if (chunkStable_)
+        return tokenArena_->MakeTokenView(Pos(), type, chunkData_ + nextStartOffset_, offset - nextStartOffset_);
+    else
+        return tokenArena_->MakeToken(Pos(), type, chunkData_ + nextStartOffset_, offset - nextStartOffset_);
 }
 
-TokenPtr Scanner::Make(const Token::Types& type, std::string& spell, bool takeChr)
+TokenPtr Scanner::Make(const Token::Types& type, const std::string& spell)
 {
-    if (takeChr)
-        spell += TakeIt();
-    return std::make_shared<Token>(Pos(), type, std::move(spell));
+    return tokenArena_->MakeToken(Pos(), type, spell);
 }
 
-TokenPtr Scanner::Make(const Token::Types& type, std::string& spell, const SourcePosition& pos, bool takeChr)
+TokenPtr Scanner::MakeEndOfStream()
 {
-    if (takeChr)
-        spell += TakeIt();
-    return std::make_shared<Token>(pos, type, std::move(spell));
+    return tokenArena_->MakeToken(Pos(), Tokens::EndOfStream);
+}
+
+const char* Scanner::ScannedData() const
+{
+    return (streamTokens_ != nullptr ? chunkData_ : source_->Data()) + nextStartOffset_;
+}
+
+std::size_t Scanner::ScannedSize() const
+{
+    /* Clamp size to the buffer (the new-line character that follows the source buffer is not part of it) */
+    const auto size     = (streamTokens_ != nullptr ? chunkSize_ : source_->Size());
+    const auto offset   = std::min(NextOffset(), size);
+    return (offset > nextStartOffset_ ? offset - nextStartOffset_ : 0);
+}
+
+std::string Scanner::ScannedSpell() const
+{
+    std::string spell(ScannedData(), ScannedSize());
+    if (streamTokens_ == nullptr && NextOffset() > source_->Size())
+        spell += '\n';
+    return spell;
 }
 
 /* ----- Report Handling ----- */
@@ -278,66 +491,56 @@ TokenPtr Scanner::ScanWhiteSpaces(bool includeNewLines)
         return Make(Tokens::NewLine, true);
 
     /* Scan other white spaces */
-    std::string spell;
-
     while ( std::isspace(UChr()) && ( includeNewLines || !IsNewLine() ) )
-        spell += TakeIt();
+        TakeIt();
 
-    return Make(Tokens::WhiteSpace, spell);
+    return Make(Tokens::WhiteSpace);
 }
 
 TokenPtr Scanner::ScanCommentLine(bool scanComments)
 {
-    std::string spell;
-
     TakeIt(); // Ignore second '/' from commentary line beginning
 
     while (!IsNewLine())
-        spell += TakeIt();
+        TakeIt();
 
-    /* Store commentary string */
-    AppendComment(spell);
+    /* Store commentary string (without the leading "//") */
+    AppendComment(std::string(ScannedData() + 2, ScannedSize() - 2));
 
     if (scanComments)
-    {
-        spell = "//" + spell;
-        return Make(Tokens::Comment, spell);
-    }
+        return Make(Tokens::Comment);
 
     return nullptr;
 }
 
 TokenPtr Scanner::ScanCommentBlock(bool scanComments)
 {
-    std::string spell;
+    bool closed = false;
 
     TakeIt(); // Ignore first '*' from commentary block beginning
 
     while (!Is(0))
     {
         /* Scan comment block ending */
-        if (Is('*'))
+        if (TakeIt() == '*' && Is('/'))
         {
             TakeIt();
-            if (Is('/'))
-            {
-                TakeIt();
-                break;
-            }
-            else
-                spell += '*';
+            closed = true;
+            break;
         }
-        else
-            spell += TakeIt();
     }
 
-    /* Store commentary string */
-    AppendMultiLineComment(spell);
+    /* Store commentary string (without the enclosing comment delimiters) */
+    auto spell = ScannedSpell();
+    AppendMultiLineComment(spell.substr(2, spell.size() - (closed ? 4 : 2)));
 
     if (scanComments)
     {
-        spell = "/*" + spell + "*/";
-        return Make(Tokens::Comment, spell);
+        /* Close an unterminated comment block in the spelling */
+        if (closed)
+            return Make(Tokens::Comment);
+        else
+            return Make(Tokens::Comment, spell + "*/");
     }
 
     return nullptr;
@@ -345,70 +548,66 @@ TokenPtr Scanner::ScanCommentBlock(bool scanComments)
 
 TokenPtr Scanner::ScanStringLiteral()
 {
-    std::string spell;
-
-    spell += Take('\"');
+    Take('\"');
 
     while (!Is('\"'))
     {
         if (Is(0))
             ErrorUnexpectedEOS();
-        spell += TakeIt();
+        TakeIt();
     }
 
-    spell += Take('\"');
+    Take('\"');
 
-    return Make(Tokens::StringLiteral, spell);
+    return Make(Tokens::StringLiteral);
 }
 
 TokenPtr Scanner::ScanCharLiteral()
 {
-    std::string spell;
-
-    spell += Take('\'');
+    Take('\'');
 
     while (!Is('\''))
     {
         if (Is(0))
             ErrorUnexpectedEOS();
-        spell += TakeIt();
+        TakeIt();
     }
 
-    spell += Take('\'');
+    Take('\'');
 
-    return Make(Tokens::CharLiteral, spell);
+    return Make(Tokens::CharLiteral);
 }
 
 // see https://msdn.microsoft.com/de-de/library/windows/desktop/bb509567(v=vs.85).aspx
 TokenPtr Scanner::ScanNumber(bool startWithPeriod)
 {
-    std::string spell;
-
     /* Parse integer or floating-point number */
-    auto type       = Tokens::IntLiteral;
-    auto preDigits  = false;
-    auto postDigits = false;
+    auto type           = Tokens::IntLiteral;
+    auto preDigits      = false;
+    auto postDigits     = false;
+    auto periodOffset   = std::string::npos;
 
     if (!startWithPeriod)
-        preDigits = ScanDigitSequence(spell);
+        preDigits = ScanDigitSequence();
 
-    /* Check for exponent part (without fractional part) */
+    /* Check for exponent part (without fractional part), which is spelled with an inserted period */
     if ( !startWithPeriod && ( Is('e') || Is('E') ) )
+    {
         startWithPeriod = true;
+        periodOffset    = ScannedSize();
+    }
 
     /* Check for fractional part */
     if (startWithPeriod || Is('.'))
     {
         type = Tokens::FloatLiteral;
 
-        /* Scan period for floating-points */
-        if (startWithPeriod)
-            spell += '.';
-        else
-            spell += TakeIt();
+        /* Scan period for floating-points (a leading period has already been taken) */
+        if (!startWithPeriod)
+            TakeIt();
 
         /* Scan (optional) right hand side digit-sequence */
-        postDigits = ScanDigitSequence(spell);
+        postDigits = ScanDigitSequence();
 
         if (!preDigits && !postDigits)
             Error(R_MissingDecimalPartInFloat);
@@ -416,67 +615,72 @@ TokenPtr Scanner::ScanNumber(bool startWithPeriod)
         /* Check for exponent-part */
         if (Is('e') || Is('E'))
         {
-            spell += TakeIt();
+            TakeIt();
 
             /* Check for sign */
             if (Is('-') || Is('+'))
-                spell += TakeIt();
+                TakeIt();
 
             /* Scan exponent digit sequence */
-            if (!ScanDigitSequence(spell))
+            if (!ScanDigitSequence())
                 Error(R_MissingDigitSequenceAfterExpr);
         }
 
         /* Check for floating-suffix */
         if (Is('f') || Is('F') || Is('h') || Is('H') || Is('l') || Is('L'))
-            spell += TakeIt();
+            TakeIt();
     }
     else
     {
         /* Check for hex numbers */
-        if (spell == "0" && Is('x'))
+        if (ScannedSize() == 1 && *ScannedData() == '0' && Is('x'))
         {
-            spell += TakeIt();
+            TakeIt();
             while ( std::isdigit(UChr()) || ( Chr() >= 'a' && Chr() <= 'f' ) || ( Chr() >= 'A' && Chr() <= 'F' ) )
-                spell += TakeIt();
+                TakeIt();
         }
 
         /* Check for integer-suffix */
         if (Is('u') || Is('U') || Is('l') || Is('L'))
-            spell += TakeIt();
+            TakeIt();
+    }
+
+    /* Create number token (only with a modified spelling if a period has been inserted) */
+    if (periodOffset != std::string::npos)
+    {
+        auto spell = ScannedSpell();
+        spell.insert(periodOffset, 1, '.');
+        return Make(type, spell);
     }
 
-    /* Create number token */
-    return Make(type, spell);
+    return Make(type);
 }
 
 TokenPtr Scanner::ScanNumberOrDot()
 {
-    std::string spell;
-
-    spell += Take('.');
+    Take('.');
 
     if (Is('.'))
-        return ScanVarArg(spell);
+        return ScanVarArg();
     if (std::isdigit(UChr()))
         return ScanNumber(true);
 
-    return Make(Tokens::Dot, spell);
+    return Make(Tokens::Dot);
 }
 
-TokenPtr Scanner::ScanVarArg(std::string& spell)
+TokenPtr Scanner::ScanVarArg()
 {
-    spell += Take('.');
-    spell += Take('.');
-    return Make(Tokens::VarArg, spell);
+    Take('.');
+    Take('.');
+    return Make(Tokens::VarArg);
 }
 
-bool Scanner::ScanDigitSequence(std::string& spell)
+bool Scanner::ScanDigitSequence()
 {
     bool result = (std::isdigit(UChr()) != 0);
 
     while (std::isdigit(UChr()))
-        spell += TakeIt();
+        TakeIt();
 
     return result;
 }
@@ -524,9 +728,110 @@ void Scanner::AppendMultiLineComment(const std::string& s)
     }
 }
 
+std::size_t Scanner::NextOffset() const
+{
+    if (streamTokens_ != nullptr)
+        return (chunkPos_ > 0 ? chunkPos_ - 1 : 0);
+
+    /* At the end of the source, the last character (or the new-line character that follows the buffer) has already been taken */
+    if (Is(0) && source_->Offset() + 1 >= source_->Size())
+        return source_->Offset() + 1;
+
+    return source_->Offset();
+}
+
+void Scanner::SetChunk(const char* data, std::size_t size, bool stable)
+{
+    chunkData_      = data;
+    chunkSize_      = size;
+    chunkPos_       = 0;
+    chunkStable_    = stable;
+    chr_            = 0;
+}
+
+void Scanner::SetChunkFromTokens(std::size_t first, std::size_t last)
+{
+    const auto& tokens = *streamTokens_;
+
+    chunkPieces_.clear();
+
+    if (last == first + 1)
+    {
+        /* Refer directly to the spelling of a single token */
+        const auto& tkn = tokens[first];
+        chunkPieces_.push_back({ 0, tkn.get() });
+        SetChunk(tkn->SpellData(), tkn->SpellSize(), true);
+    }
+    else
+    {
+        /* Concatenate spellings of adjacent tokens */
+        chunkBuffer_.clear();
+
+        for (auto i = first; i < last; ++i)
+        {
+            const auto& tkn = tokens[i];
+            chunkPieces_.push_back({ chunkBuffer_.size(), tkn.get() });
+            chunkBuffer_.append(tkn->SpellData(), tkn->SpellSize());
+        }
+
+        SetChunk(chunkBuffer_.data(), chunkBuffer_.size(), false);
+    }
+}
+
+char Scanner::NextChunkChar()
+{
+    if (chunkPos_ < chunkSize_)
+        return chunkData_[chunkPos_++];
+    if (chunkPos_ == chunkSize_ && chunkData_ != nullptr)
+    {
+        ++chunkPos_;
+        return '\n';
+    }
+    return 0;
+}
+
+SourcePosition Scanner::ChunkPos(std::size_t offset) const
+{
+    /* Find token that contains the chunk offset */
+    for (auto it = chunkPieces_.rbegin(); it != chunkPieces_.rend(); ++it)
+    {
+        if (it->first <= offset)
+        {
+            const auto tkn = it->second;
+            return SourcePosition(tkn->Row(), tkn->Column() + static_cast<unsigned int>(offset - it->first), tkn->SharedOrigin());
+        }
+    }
+    return nextStartPos_;
+}
+
+void Scanner::SkipRawLiteral(char quote)
+{
+    while (!Is(0) && !Is(quote) && !Is('\n'))
+    {
+        if (TakeIt() == '\\' && !Is(0))
+            TakeIt();
+    }
+
+    if (Is(quote))
+        TakeIt();
+}
+
+void Scanner::AppendCommentToken(const Token& tkn)
+{
+    const auto data = tkn.SpellData();
+    const auto size = tkn.SpellSize();
+
+    commentStartPos_ = tkn.Column();
+
+    if (size >= 2 && data[0] == '/' && data[1] == '*')
+        AppendMultiLineComment(std::string(data + 2, size >= 4 ? size - 4 : 0));
+    else if (size >= 2)
+        AppendComment(std::string(data + 2, size - 2));
+}
+
 
 } // /namespace Xsc
 
 
 
-// ================================================================================
+// ================================================================================
\ No newline at end of file
@@ -14,6 +14,7 @@
 #include "SourceCode.h"
 #include "SourceArea.h"
 #include "Token.h"
+#include "TokenArena.h"
 #include "TokenString.h"
 
 #include <string>
@@ -33,8 +34,15 @@ class Scanner
         Scanner(Log* log = nullptr);
         virtual ~Scanner() = default;
 
-        // Starts scanning the specified source code.
-        bool ScanSource(const SourceCodePtr& source);
+        // Starts scanning the specified source code. All tokens are allocated in the specified token arena.
+        bool ScanSource(const SourceCodePtr& source, TokenArena& tokenArena);
+
+        /*
+        Starts scanning the specified token string that has been handed over from the pre-processor (see PreProcessor::ProcessTokens).
+        Identifiers and literals are taken as they are, only adjacent operator tokens are scanned again from their spellings (e.g. '+' and '=' to "+=").
+        The source code is only used as report context. The token string must outlive this scanner.
+        */
+        bool ScanTokenString(const TokenPtrString& tokenString, const SourceCodePtr& source, TokenArena& tokenArena);
 
         // Pushes the specified token string onto the stack where further tokens will be parsed from the top of the stack.
         void PushTokenString(const TokenPtrString& tokenString);
@@ -46,6 +54,13 @@ class Scanner
         // Scanes the source code for the next token
         virtual TokenPtr Next() = 0;
 
+        /*
+        Skips all characters of the source code up to the next '#' character (i.e. a pre-processor directive), without scanning any tokens.
+        Like the "Next" function, this finds a directive anywhere outside of commentaries and string literals (e.g. after a commentary in the same line).
+        This is used to skip inactive '#if'-blocks quickly. The next call to "Next" returns the directive token.
+        */
+        void SkipToNextDirective();
+
         // Returns the token previously returned by the "Next" function.
         TokenPtr ActiveToken() const;
 
@@ -88,12 +103,32 @@ class Scanner
 
         virtual TokenPtr ScanToken() = 0;
 
+        // Makes an identifier or keyword token from the scanned characters (see ScannedData). By default, an identifier token is returned.
+        virtual TokenPtr ScanIdentifierOrKeyword();
+
         char Take(char chr);
         char TakeIt();
 
+        /*
+        Makes a new token whose spelling is the range of characters that have been scanned since the start position (see StoreStartPos).
+        The spelling refers to the source buffer (or the token spellings of the pre-processor) and is only copied if these characters are not persistent.
+        */
         TokenPtr Make(const Token::Types& type, bool takeChr = false);
-        TokenPtr Make(const Token::Types& type, std::string& spell, bool takeChr = false);
-        TokenPtr Make(const Token::Types& type, std::string& spell, const SourcePosition& pos, bool takeChr = false);
+
+        // Makes a new token with a copy of the specified spelling, which differs from the scanned characters.
+        TokenPtr Make(const Token::Types& type, const std::string& spell);
+
+        // Makes a new end-of-stream token with an empty spelling.
+        TokenPtr MakeEndOfStream();
+
+        // Returns the characters that have been scanned since the start position (which are not null-terminated).
+        const char* ScannedData() const;
+
+        // Returns the number of characters that have been scanned since the start position.
+        std::size_t ScannedSize() const;
+
+        // Returns a copy of the characters that have been scanned since the start position (e.g. for reports).
+        std::string ScannedSpell() const;
 
         /* ----- Report Handling ----- */
 
@@ -126,9 +161,9 @@ class Scanner
         TokenPtr    ScanCharLiteral();
         TokenPtr    ScanNumber(bool startWithPeriod = false);
         TokenPtr    ScanNumberOrDot();
-        TokenPtr    ScanVarArg(std::string& spell);
+        TokenPtr    ScanVarArg();
 
-        bool        ScanDigitSequence(std::string& spell);
+        bool        ScanDigitSequence();
 
         /* ----- Helper functions ----- */
 
@@ -161,6 +196,27 @@ class Scanner
         /* === Functions === */
 
         TokenPtr NextTokenScan(bool scanComments, bool scanWhiteSpaces);
+        TokenPtr NextTokenScanComments(bool scanComments, bool scanWhiteSpaces);
+        TokenPtr NextTokenFromTokenString();
+
+        // Sets the characters that are scanned next, when tokens are scanned from a token string.
+        void SetChunk(const char* data, std::size_t size, bool stable);
+        void SetChunkFromTokens(std::size_t first, std::size_t last);
+
+        // Returns the next character of the current chunk, followed by a single new-line character at the end.
+        char NextChunkChar();
+
+        // Returns the source position of the specified offset within the current chunk.
+        SourcePosition ChunkPos(std::size_t offset) const;
+
+        // Appends the commentary of the specified comment token, that has been handed over from the pre-processor.
+        void AppendCommentToken(const Token& tkn);
+
+        // Skips the remaining characters of a string or character literal (until the specified quotation mark or end of line).
+        void SkipRawLiteral(char quote);
+
+        // Returns the offset of the next character within the source buffer, or within the current chunk.
+        std::size_t NextOffset() const;
 
         void AppendComment(const std::string& s);
         void AppendMultiLineComment(const std::string& s);
@@ -170,14 +226,28 @@ class Scanner
         SourceCodePtr                               source_;
         char                                        chr_                = 0;
 
+        TokenArena*                                 tokenArena_         = nullptr;
+
         Log*                                        log_                = nullptr;
 
         SourcePosition                              nextStartPos_;
+        std::size_t                                 nextStartOffset_    = 0;
         TokenPtr                                    activeToken_;
         TokenPtr                                    prevToken_;
 
         std::vector<TokenPtrString::ConstIterator>  tokenStringItStack_;
 
+        // Token string from the pre-processor and the character chunk which is currently scanned from it.
+        const std::vector<TokenPtr>*                streamTokens_       = nullptr;
+        std::size_t                                 streamPos_          = 0;
+
+        const char*                                 chunkData_          = nullptr;
+        std::size_t                                 chunkSize_          = 0;
+        std::size_t                                 chunkPos_           = 0;
+        bool                                        chunkStable_        = false;    // Chunk refers to persistent token spellings
+        std::string                                 chunkBuffer_;
+        std::vector<std::pair<std::size_t, Token*>> chunkPieces_;                   // Chunk offsets of the original tokens
+
         // Active commentary string (in front of the next token).
         std::string                                 comment_;
         unsigned int                                commentStartPos_    = 0;
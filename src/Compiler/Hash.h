@@ -0,0 +1,63 @@
+/*
+ * Hash.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_HASH_H
+#define XSC_HASH_H
+
+
+#include <cstdint>
+#include <cstddef>
+
+
+namespace Xsc
+{
+
+
+// Returns the 32-bit FNV-1a hash of the specified character, continued from the specified hash.
+inline std::uint32_t HashFNV1a32(unsigned char c, std::uint32_t hash)
+{
+    return ((hash ^ c) * 16777619u);
+}
+
+// Returns the 32-bit FNV-1a hash of the specified string, continued from the specified hash.
+inline std::uint32_t HashFNV1a32(const char* s, std::size_t len, std::uint32_t hash = 2166136261u)
+{
+    for (std::size_t i = 0; i < len; ++i)
+        hash = HashFNV1a32(static_cast<unsigned char>(s[i]), hash);
+    return hash;
+}
+
+// Returns the 64-bit FNV-1a hash of the specified data, continued from the specified hash.
+inline std::uint64_t HashFNV1a64(const void* data, std::size_t size, std::uint64_t hash = 14695981039346656037ull)
+{
+    auto bytes = reinterpret_cast<const unsigned char*>(data);
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+
+    return hash;
+}
+
+// Returns the hash of the specified pointer (Fibonacci hashing), whose lower bits are well distributed for hash tables with a power of two size.
+inline std::size_t HashPointer(const void* ptr)
+{
+    const auto h = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(ptr)) * 0x9E3779B97F4A7C15ull;
+    return static_cast<std::size_t>(h >> 32);
+}
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
\ No newline at end of file
@@ -0,0 +1,162 @@
+/*
+ * IncludeCache.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <Xsc/IncludeCache.h>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <map>
+
+#ifdef _WIN32
+#   include <Windows.h>
+#else
+#   include <sys/types.h>
+#   include <sys/stat.h>
+#endif
+
+
+namespace Xsc
+{
+
+
+struct IncludeCacheEntry
+{
+    long long                           modificationTime    = 0;
+    long long                           size                = 0;
+    std::shared_ptr<const std::string>  content;
+};
+
+struct IncludeCache::OpaqueData
+{
+    mutable std::mutex                          mutex;
+    std::map<std::string, IncludeCacheEntry>    entries;
+    std::size_t                                 numHits     = 0;
+    std::size_t                                 numMisses   = 0;
+};
+
+IncludeCache::IncludeCache() :
+    data_ { new OpaqueData() }
+{
+}
+
+IncludeCache::~IncludeCache()
+{
+    delete data_;
+}
+
+/*
+Returns the modification time and size of the specified file, or false if the file does not exist.
+The modification time has the finest resolution of the platform (whole seconds would miss a file that is rewritten with the same size within one second).
+*/
+static bool QueryFileStatus(const std::string& filename, long long& modificationTime, long long& size)
+{
+    #ifdef _WIN32
+
+    WIN32_FILE_ATTRIBUTE_DATA fileAttribs;
+    if (GetFileAttributesExA(filename.c_str(), GetFileExInfoStandard, &fileAttribs))
+    {
+        /* Modification time in units of 100 nanoseconds */
+        modificationTime    = static_cast<long long>((static_cast<unsigned long long>(fileAttribs.ftLastWriteTime.dwHighDateTime) << 32) | fileAttribs.ftLastWriteTime.dwLowDateTime);
+        size                = static_cast<long long>((static_cast<unsigned long long>(fileAttribs.nFileSizeHigh) << 32) | fileAttribs.nFileSizeLow);
+        return true;
+    }
+
+    #else
+
+    struct stat fileStatus;
+    if (stat(filename.c_str(), &fileStatus) == 0)
+    {
+        /* Modification time in nanoseconds */
+        #ifdef __APPLE__
+        const auto& modificationTimeSpec = fileStatus.st_mtimespec;
+        #else
+        const auto& modificationTimeSpec = fileStatus.st_mtim;
+        #endif
+        modificationTime    = static_cast<long long>(modificationTimeSpec.tv_sec) * 1000000000ll + static_cast<long long>(modificationTimeSpec.tv_nsec);
+        size                = static_cast<long long>(fileStatus.st_size);
+        return true;
+    }
+
+    #endif
+
+    return false;
+}
+
+static std::shared_ptr<const std::string> ReadFileContent(const std::string& filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    if (file.good())
+        return std::make_shared<const std::string>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return nullptr;
+}
+
+std::shared_ptr<const std::string> IncludeCache::Fetch(const std::string& filename)
+{
+    IncludeCacheEntry entry;
+    if (!QueryFileStatus(filename, entry.modificationTime, entry.size))
+        return nullptr;
+
+    /* Check if the file is already cached and has not been modified */
+    {
+        std::lock_guard<std::mutex> guard { data_->mutex };
+
+        auto it = data_->entries.find(filename);
+        if (it != data_->entries.end() && it->second.modificationTime == entry.modificationTime && it->second.size == entry.size)
+        {
+            ++data_->numHits;
+            return it->second.content;
+        }
+
+        ++data_->numMisses;
+    }
+
+    /* Read file content without blocking other compilations */
+    entry.content = ReadFileContent(filename);
+    if (!entry.content)
+        return nullptr;
+
+    /* Store new file content (this replaces an outdated entry, which is still valid for compilations that use it) */
+    {
+        std::lock_guard<std::mutex> guard { data_->mutex };
+        data_->entries[filename] = entry;
+    }
+
+    return entry.content;
+}
+
+void IncludeCache::Clear()
+{
+    std::lock_guard<std::mutex> guard { data_->mutex };
+    data_->entries.clear();
+    data_->numHits      = 0;
+    data_->numMisses    = 0;
+}
+
+std::size_t IncludeCache::GetNumEntries() const
+{
+    std::lock_guard<std::mutex> guard { data_->mutex };
+    return data_->entries.size();
+}
+
+std::size_t IncludeCache::GetNumHits() const
+{
+    std::lock_guard<std::mutex> guard { data_->mutex };
+    return data_->numHits;
+}
+
+std::size_t IncludeCache::GetNumMisses() const
+{
+    std::lock_guard<std::mutex> guard { data_->mutex };
+    return data_->numMisses;
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
\ No newline at end of file
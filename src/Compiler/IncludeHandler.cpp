@@ -9,6 +9,8 @@
 #include "ReportIdents.h"
 #include "Exception.h"
 #include <fstream>
+#include <sys/types.h>
+#include <sys/stat.h>
 
 
 namespace Xsc
@@ -36,15 +38,35 @@ static std::unique_ptr<std::istream> ReadFile(const std::string& filename)
     return (stream->good() ? std::move(stream) : nullptr);
 }
 
+static bool FileExists(const std::string& filename)
+{
+    struct stat fileStatus;
+    return (stat(filename.c_str(), &fileStatus) == 0 && (fileStatus.st_mode & S_IFMT) == S_IFREG);
+}
+
 std::unique_ptr<std::istream> IncludeHandler::Include(const std::string& filename, bool useSearchPathsFirst)
 {
-    if (!useSearchPathsFirst)
+    /* Read file from the first path where it has been found */
+    const auto path = FindFile(filename, useSearchPathsFirst);
+
+    if (!path.empty())
     {
-        /* Read file from relative path */
-        if (auto file = ReadFile(filename))
+        if (auto file = ReadFile(path))
             return file;
     }
 
+    RuntimeErr(R_FailedToIncludeFile(filename));
+}
+
+std::string IncludeHandler::FindFile(const std::string& filename, bool useSearchPathsFirst) const
+{
+    if (!useSearchPathsFirst)
+    {
+        /* Find file in relative path */
+        if (FileExists(filename))
+            return filename;
+    }
+
     /* Search file in search paths */
     for (const auto& path : data_->searchPaths)
     {
@@ -56,20 +78,20 @@ std::unique_ptr<std::istream> IncludeHandler::Include(const std::string& filenam
                 s += '/';
             s += filename;
 
-            /* Read file from current path */
-            if (auto file = ReadFile(s))
-                return file;
+            /* Find file in current path */
+            if (FileExists(s))
+                return s;
         }
     }
 
     if (useSearchPathsFirst)
     {
-        /* Read file from relative path */
-        if (auto file = ReadFile(filename))
-            return file;
+        /* Find file in relative path */
+        if (FileExists(filename))
+            return filename;
     }
 
-    RuntimeErr(R_FailedToIncludeFile(filename));
+    return "";
 }
 
 std::vector<std::string>& IncludeHandler::GetSearchPaths()
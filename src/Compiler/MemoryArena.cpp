@@ -0,0 +1,81 @@
+/*
+ * MemoryArena.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "MemoryArena.h"
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+
+namespace Xsc
+{
+
+
+// Returns the specified pointer aligned to the next multiple of the specified alignment.
+static char* AlignPointer(char* ptr, std::size_t alignment)
+{
+    auto addr = reinterpret_cast<std::uintptr_t>(ptr);
+    addr = (addr + (alignment - 1)) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+    return reinterpret_cast<char*>(addr);
+}
+
+MemoryArena::MemoryArena(std::size_t blockSize) :
+    blockSize_ { blockSize }
+{
+}
+
+void* MemoryArena::Allocate(std::size_t size, std::size_t alignment)
+{
+    /* Allocate new block if the current block is exhausted */
+    auto ptr = AlignPointer(current_, alignment);
+
+    if (current_ == nullptr || ptr + size > end_)
+    {
+        AllocateBlock(size, alignment);
+        ptr = AlignPointer(current_, alignment);
+    }
+
+    /* Move pointer to the end of the new chunk */
+    current_ = ptr + size;
+
+    return ptr;
+}
+
+const char* MemoryArena::CopyString(const char* s, std::size_t len)
+{
+    if (len == 0)
+        return "";
+
+    auto ptr = static_cast<char*>(Allocate(len, 1));
+    std::memcpy(ptr, s, len);
+
+    return ptr;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void MemoryArena::AllocateBlock(std::size_t size, std::size_t alignment)
+{
+    /* Make sure the block is large enough for over-sized allocations */
+    auto blockSize = std::max(blockSize_, size + alignment);
+
+    blocks_.emplace_back(new char[blockSize]);
+    capacity_ += blockSize;
+
+    current_    = blocks_.back().get();
+    end_        = current_ + blockSize;
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
\ No newline at end of file
@@ -0,0 +1,80 @@
+/*
+ * MemoryArena.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_MEMORY_ARENA_H
+#define XSC_MEMORY_ARENA_H
+
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <type_traits>
+#include <utility>
+#include <new>
+
+
+namespace Xsc
+{
+
+
+/*
+Monotonic memory arena (also referred to as "bump allocator").
+Memory is allocated from large blocks and all allocations are released at once when the arena is destroyed.
+Only trivially destructible objects can be created with this arena, because no destructors are called.
+*/
+class MemoryArena
+{
+
+    public:
+
+        MemoryArena(std::size_t blockSize = 16384);
+
+        MemoryArena(const MemoryArena&) = delete;
+        MemoryArena& operator = (const MemoryArena&) = delete;
+
+        // Allocates a memory chunk with the specified size and alignment.
+        void* Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+        // Copies the specified character string into this arena and returns the pointer to the copy (which is not null-terminated).
+        const char* CopyString(const char* s, std::size_t len);
+
+        // Creates a new object of the specified type in this arena.
+        template <typename T, typename... Args>
+        T* New(Args&&... args)
+        {
+            static_assert(std::is_trivially_destructible<T>::value, "MemoryArena::New requires a trivially destructible type");
+            return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        }
+
+        // Returns the number of bytes that have been allocated from the system.
+        inline std::size_t GetCapacity() const
+        {
+            return capacity_;
+        }
+
+    private:
+
+        // Allocates a new memory block which is large enough for the specified size and alignment.
+        void AllocateBlock(std::size_t size, std::size_t alignment);
+
+        std::vector<std::unique_ptr<char[]>>    blocks_;
+        std::size_t                             blockSize_  = 0;
+        std::size_t                             capacity_   = 0;
+        char*                                   current_    = nullptr;
+        char*                                   end_        = nullptr;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
\ No newline at end of file
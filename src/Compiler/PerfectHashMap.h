@@ -0,0 +1,278 @@
+/*
+ * PerfectHashMap.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_PERFECT_HASH_MAP_H
+#define XSC_PERFECT_HASH_MAP_H
+
+
+#include "Hash.h"
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <initializer_list>
+#include <cstdint>
+#include <cstring>
+#include <cctype>
+
+
+namespace Xsc
+{
+
+
+// Character traits for the perfect hash map with case sensitive string comparison.
+struct PerfectHashCaseSensitive
+{
+    static inline unsigned char Fold(char c)
+    {
+        return static_cast<unsigned char>(c);
+    }
+
+    static inline bool Equals(const char* lhs, const char* rhs, std::size_t len)
+    {
+        return (std::memcmp(lhs, rhs, len) == 0);
+    }
+};
+
+// Character traits for the perfect hash map with case insensitive string comparison (see CiString).
+struct PerfectHashCaseInsensitive
+{
+    static inline unsigned char Fold(char c)
+    {
+        return static_cast<unsigned char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+
+    static inline bool Equals(const char* lhs, const char* rhs, std::size_t len)
+    {
+        for (std::size_t i = 0; i < len; ++i)
+        {
+            if (Fold(lhs[i]) != Fold(rhs[i]))
+                return false;
+        }
+        return true;
+    }
+};
+
+/*
+Read-only string map with a minimal-collision perfect hash function (hash-and-displace scheme).
+The table is generated once from a fixed list of strings (e.g. the keywords of a shading language),
+and each lookup then takes exactly two hash computations and one string comparison, without any memory allocation.
+If the same string occurs multiple times in the initializer list, only the first entry is used (like 'std::map::insert').
+*/
+template <typename T, typename Traits = PerfectHashCaseSensitive>
+class PerfectHashMap
+{
+
+    public:
+
+        PerfectHashMap() = default;
+        PerfectHashMap(const PerfectHashMap&) = default;
+        PerfectHashMap(PerfectHashMap&&) = default;
+
+        PerfectHashMap(const std::initializer_list<std::pair<std::string, T>>& entries)
+        {
+            Generate(entries.begin(), entries.end());
+        }
+
+        // Returns a pointer to the value which is associated to the specified string, or null if there is no such entry.
+        const T* Find(const char* s, std::size_t len) const
+        {
+            if (!slots_.empty())
+            {
+                const auto seed = seeds_[Hash(s, len, 0) & (seeds_.size() - 1)];
+                const auto& slot = slots_[Hash(s, len, seed) & (slots_.size() - 1)];
+                if (slot.used && slot.key.size() == len && Traits::Equals(slot.key.data(), s, len))
+                    return &(slot.value);
+            }
+            return nullptr;
+        }
+
+        // Returns a pointer to the value which is associated to the specified string, or null if there is no such entry.
+        inline const T* Find(const std::string& s) const
+        {
+            return Find(s.data(), s.size());
+        }
+
+        // Returns the number of entries in this map.
+        inline std::size_t Size() const
+        {
+            return size_;
+        }
+
+        // Calls the specified function for each entry (in an unspecified order) with its string and value.
+        template <typename Func>
+        void ForEach(Func func) const
+        {
+            for (const auto& slot : slots_)
+            {
+                if (slot.used)
+                    func(slot.key, slot.value);
+            }
+        }
+
+    private:
+
+        struct Slot
+        {
+            std::string key;
+            T           value   = T();
+            bool        used    = false;
+        };
+
+        // Returns the hash of the specified string with the specified seed (FNV-1a with a final avalanche step).
+        static std::uint32_t Hash(const char* s, std::size_t len, std::uint32_t seed)
+        {
+            std::uint32_t h = 2166136261u ^ (seed * 0x9E3779B9u);
+
+            for (std::size_t i = 0; i < len; ++i)
+                h = HashFNV1a32(Traits::Fold(s[i]), h);
+
+            h ^= (h >> 16);
+            h *= 0x85EBCA6Bu;
+            h ^= (h >> 13);
+            h *= 0xC2B2AE35u;
+            h ^= (h >> 16);
+
+            return h;
+        }
+
+        static std::size_t NextPowerOfTwo(std::size_t n)
+        {
+            std::size_t p = 1;
+            while (p < n)
+                p <<= 1;
+            return p;
+        }
+
+        template <typename Iter>
+        void Generate(Iter first, Iter last)
+        {
+            /* Gather unique entries (the first occurrence of a key wins) */
+            std::vector<std::pair<std::string, T>> entries;
+
+            for (auto it = first; it != last; ++it)
+            {
+                const auto& key = it->first;
+                auto duplicate = std::find_if(
+                    entries.begin(), entries.end(),
+                    [&key](const std::pair<std::string, T>& entry)
+                    {
+                        return (entry.first.size() == key.size() && Traits::Equals(entry.first.data(), key.data(), key.size()));
+                    }
+                );
+                if (duplicate == entries.end())
+                    entries.push_back(*it);
+            }
+
+            size_ = entries.size();
+
+            if (entries.empty())
+                return;
+
+            /* Try to find a perfect hash function, and increase the table size on failure */
+            for (auto numSlots = NextPowerOfTwo(entries.size()); !TryGenerate(entries, numSlots); numSlots <<= 1);
+        }
+
+        bool TryGenerate(const std::vector<std::pair<std::string, T>>& entries, std::size_t numSlots)
+        {
+            const std::uint32_t maxSeed = 0xFFFF;
+
+            /* Distribute entries into buckets */
+            const auto numBuckets = NextPowerOfTwo(std::max<std::size_t>(1, entries.size() / 2));
+
+            std::vector<std::vector<std::size_t>> buckets(numBuckets);
+
+            for (std::size_t i = 0; i < entries.size(); ++i)
+            {
+                const auto& key = entries[i].first;
+                buckets[Hash(key.data(), key.size(), 0) & (numBuckets - 1)].push_back(i);
+            }
+
+            /* Place the largest buckets first */
+            std::vector<std::size_t> bucketOrder(numBuckets);
+
+            for (std::size_t i = 0; i < numBuckets; ++i)
+                bucketOrder[i] = i;
+
+            std::stable_sort(
+                bucketOrder.begin(), bucketOrder.end(),
+                [&buckets](std::size_t lhs, std::size_t rhs)
+                {
+                    return (buckets[lhs].size() > buckets[rhs].size());
+                }
+            );
+
+            /* Find a seed for each bucket, so that all of its entries are placed into free slots */
+            seeds_.assign(numBuckets, 0);
+            slots_.assign(numSlots, Slot());
+
+            std::vector<std::size_t> bucketSlots;
+
+            for (auto bucketIdx : bucketOrder)
+            {
+                const auto& bucket = buckets[bucketIdx];
+                if (bucket.empty())
+                    break;
+
+                std::uint32_t seed = 1;
+
+                for (; seed <= maxSeed; ++seed)
+                {
+                    bucketSlots.clear();
+
+                    for (auto entryIdx : bucket)
+                    {
+                        const auto& key = entries[entryIdx].first;
+                        const auto slotIdx = Hash(key.data(), key.size(), seed) & (numSlots - 1);
+
+                        if (slots_[slotIdx].used || std::find(bucketSlots.begin(), bucketSlots.end(), slotIdx) != bucketSlots.end())
+                            break;
+
+                        bucketSlots.push_back(slotIdx);
+                    }
+
+                    if (bucketSlots.size() == bucket.size())
+                        break;
+                }
+
+                if (seed > maxSeed)
+                    return false;
+
+                /* Store entries in their slots */
+                seeds_[bucketIdx] = seed;
+
+                for (std::size_t i = 0; i < bucket.size(); ++i)
+                {
+                    auto& slot = slots_[bucketSlots[i]];
+                    slot.key    = entries[bucket[i]].first;
+                    slot.value  = entries[bucket[i]].second;
+                    slot.used   = true;
+                }
+            }
+
+            return true;
+        }
+
+        std::vector<std::uint32_t>  seeds_;
+        std::vector<Slot>           slots_;
+        std::size_t                 size_   = 0;
+
+};
+
+// Case insensitive perfect hash map (see CiString).
+template <typename T>
+using CiPerfectHashMap = PerfectHashMap<T, PerfectHashCaseInsensitive>;
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
\ No newline at end of file
@@ -0,0 +1,428 @@
+/*
+ * PreProcessorSnapshot.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <Xsc/PreProcessorSnapshot.h>
+#include <Xsc/Xsc.h>
+#include "PreProcessorState.h"
+#include "PreProcessor.h"
+#include "GLSLPreProcessor.h"
+#include "SourceCode.h"
+#include "Helper.h"
+#include "ReportIdents.h"
+#include "SnapshotStream.h"
+#include <iterator>
+#include <stdexcept>
+
+
+namespace Xsc
+{
+
+
+// Magic number and format version of the binary snapshot ("XSPP" in little endian).
+static const std::uint32_t g_snapshotMagic          = 0x50505358u;
+static const std::uint32_t g_snapshotFormatVersion  = 1u;
+
+struct PreProcessorSnapshot::OpaqueData
+{
+    PreProcessorState   state;
+    std::uint64_t       hash    = 0;
+    bool                valid   = false;
+};
+
+PreProcessorSnapshot::PreProcessorSnapshot() :
+    data_ { new OpaqueData() }
+{
+}
+
+PreProcessorSnapshot::~PreProcessorSnapshot()
+{
+    delete data_;
+}
+
+SourceCodePtr MakeInputSource(const ShaderInput& inputDesc)
+{
+    if (inputDesc.sourceCodeBuffer)
+        return std::make_shared<SourceCode>(inputDesc.sourceCodeBuffer, inputDesc.sourceCodeBufferSize);
+    if (inputDesc.sourceCode)
+        return std::make_shared<SourceCode>(inputDesc.sourceCode);
+    throw std::invalid_argument(R_InputStreamCantBeNull);
+}
+
+// Returns the validation hash of the prelude with the specified source code and the include files of the specified state.
+static std::uint64_t ComputeSnapshotHash(const ShaderInput& preludeDesc, const SourceCode& source, const PreProcessorState& state)
+{
+    auto HashString = [](const std::string& s, std::uint64_t hash)
+    {
+        /* Include the null terminator to separate consecutive strings */
+        return HashFNV1a64(s.c_str(), s.size() + 1, hash);
+    };
+
+    auto hash = HashFNV1a64(&g_snapshotFormatVersion, sizeof(g_snapshotFormatVersion));
+
+    const std::uint8_t language = (IsLanguageGLSL(preludeDesc.shaderVersion) ? 1 : 0);
+    hash = HashFNV1a64(&language, sizeof(language), hash);
+
+    hash = HashFNV1a64(source.Data(), source.Size(), hash);
+
+    for (const auto& macro : preludeDesc.defines)
+    {
+        hash = HashString(macro.ident, hash);
+        hash = HashString(macro.value, hash);
+    }
+
+    for (const auto& include : state.includes)
+    {
+        const std::uint8_t useSearchPaths = (include.useSearchPaths ? 1 : 0);
+        hash = HashString(include.filename, hash);
+        hash = HashFNV1a64(&useSearchPaths, sizeof(useSearchPaths), hash);
+        hash = HashFNV1a64(&include.contentHash, sizeof(include.contentHash), hash);
+    }
+
+    return hash;
+}
+
+bool PreProcessorSnapshot::Create(const ShaderInput& preludeDesc, Log* log)
+{
+    Clear();
+
+    /* Create pre-processor for the prelude (see Compiler::CompileShaderPrimary) */
+    std::unique_ptr<IncludeHandler> stdIncludeHandler;
+    if (!preludeDesc.includeHandler)
+        stdIncludeHandler = MakeUnique<IncludeHandler>();
+
+    auto includeHandler = (preludeDesc.includeHandler != nullptr ? preludeDesc.includeHandler : stdIncludeHandler.get());
+
+    std::unique_ptr<PreProcessor> preProcessor;
+
+    if (IsLanguageGLSL(preludeDesc.shaderVersion))
+        preProcessor = MakeUnique<GLSLPreProcessor>(*includeHandler, log);
+    else
+        preProcessor = MakeUnique<PreProcessor>(*includeHandler, log);
+
+    auto inputSource = MakeInputSource(preludeDesc);
+
+    preProcessor->DefineMacros(preludeDesc.defines);
+    preProcessor->SetIncludeCache(preludeDesc.includeCache);
+
+    /* Pre-process prelude into a token string, which keeps the source positions of the output */
+    auto output = preProcessor->ProcessTokens(
+        inputSource,
+        preludeDesc.filename,
+        ((preludeDesc.warnings & Warnings::PreProcessor) != 0)
+    );
+
+    if (!output)
+        return false;
+
+    /* Store pre-processor state and validation hash */
+    preProcessor->SaveState(data_->state, output.get());
+
+    data_->state.shaderVersion  = preludeDesc.shaderVersion;
+    data_->hash                 = ComputeSnapshotHash(preludeDesc, *inputSource, data_->state);
+    data_->valid                = true;
+
+    return true;
+}
+
+
+/*
+ * Binary serialization
+ */
+
+static void WriteTokenDesc(SnapshotWriter& writer, const PreProcessorState::TokenDesc& desc)
+{
+    writer.WriteUInt32(static_cast<std::uint32_t>(desc.type));
+    writer.WriteString(desc.spell);
+    writer.WriteUInt32(desc.row);
+    writer.WriteUInt32(desc.column);
+    writer.WriteUInt32(desc.origin);
+}
+
+static PreProcessorState::TokenDesc ReadTokenDesc(SnapshotReader& reader, std::size_t numOrigins)
+{
+    PreProcessorState::TokenDesc desc;
+    {
+        const auto type = reader.ReadUInt32();
+        if (type > static_cast<std::uint32_t>(Token::Types::EndOfStream))
+            throw std::runtime_error("invalid token type in pre-processor snapshot");
+
+        desc.type   = static_cast<Token::Types>(type);
+        desc.spell  = reader.ReadString();
+        desc.row    = reader.ReadUInt32();
+        desc.column = reader.ReadUInt32();
+        desc.origin = reader.ReadUInt32();
+
+        if (desc.origin > numOrigins)
+            throw std::runtime_error("invalid source origin in pre-processor snapshot");
+    }
+    return desc;
+}
+
+static void WriteTokenDescList(SnapshotWriter& writer, const std::vector<PreProcessorState::TokenDesc>& descList)
+{
+    writer.WriteUInt32(static_cast<std::uint32_t>(descList.size()));
+    for (const auto& desc : descList)
+        WriteTokenDesc(writer, desc);
+}
+
+static void ReadTokenDescList(SnapshotReader& reader, std::vector<PreProcessorState::TokenDesc>& descList, std::size_t numOrigins)
+{
+    descList.resize(reader.ReadCount());
+    for (auto& desc : descList)
+        desc = ReadTokenDesc(reader, numOrigins);
+}
+
+static void WriteState(SnapshotWriter& writer, const PreProcessorState& state)
+{
+    writer.WriteUInt32(static_cast<std::uint32_t>(state.shaderVersion));
+
+    writer.WriteUInt32(static_cast<std::uint32_t>(state.origins.size()));
+    for (const auto& origin : state.origins)
+    {
+        writer.WriteString(origin.filename);
+        writer.WriteUInt32(static_cast<std::uint32_t>(origin.lineOffset));
+    }
+
+    writer.WriteUInt32(static_cast<std::uint32_t>(state.macros.size()));
+    for (const auto& macro : state.macros)
+    {
+        WriteTokenDesc(writer, macro.identTkn);
+        WriteTokenDescList(writer, macro.tokenString);
+
+        writer.WriteUInt32(static_cast<std::uint32_t>(macro.parameters.size()));
+        for (const auto& param : macro.parameters)
+            writer.WriteString(param);
+
+        writer.WriteUInt8(macro.varArgs ? 1 : 0);
+        writer.WriteUInt8(macro.stdMacro ? 1 : 0);
+        writer.WriteUInt8(macro.emptyParamList ? 1 : 0);
+    }
+
+    writer.WriteUInt32(static_cast<std::uint32_t>(state.onceIncluded.size()));
+    for (const auto& filename : state.onceIncluded)
+        writer.WriteString(filename);
+
+    writer.WriteUInt32(static_cast<std::uint32_t>(state.includeGuards.size()));
+    for (const auto& includeGuard : state.includeGuards)
+    {
+        writer.WriteString(includeGuard.first);
+        writer.WriteString(includeGuard.second);
+    }
+
+    writer.WriteUInt32(static_cast<std::uint32_t>(state.includeCounter.size()));
+    for (const auto& counter : state.includeCounter)
+    {
+        writer.WriteString(counter.first);
+        writer.WriteUInt64(counter.second);
+    }
+
+    writer.WriteUInt32(static_cast<std::uint32_t>(state.includes.size()));
+    for (const auto& include : state.includes)
+    {
+        writer.WriteString(include.filename);
+        writer.WriteUInt8(include.useSearchPaths ? 1 : 0);
+        writer.WriteUInt64(include.contentHash);
+    }
+
+    WriteTokenDescList(writer, state.output);
+}
+
+static void ReadState(SnapshotReader& reader, PreProcessorState& state)
+{
+    state.shaderVersion = static_cast<InputShaderVersion>(reader.ReadUInt32());
+
+    state.origins.resize(reader.ReadCount());
+    for (auto& origin : state.origins)
+    {
+        origin.filename     = reader.ReadString();
+        origin.lineOffset   = static_cast<int>(reader.ReadUInt32());
+    }
+
+    const auto numOrigins = state.origins.size();
+
+    state.macros.resize(reader.ReadCount());
+    for (auto& macro : state.macros)
+    {
+        macro.identTkn = ReadTokenDesc(reader, numOrigins);
+        ReadTokenDescList(reader, macro.tokenString, numOrigins);
+
+        macro.parameters.resize(reader.ReadCount());
+        for (auto& param : macro.parameters)
+            param = reader.ReadString();
+
+        macro.varArgs           = (reader.ReadUInt8() != 0);
+        macro.stdMacro          = (reader.ReadUInt8() != 0);
+        macro.emptyParamList    = (reader.ReadUInt8() != 0);
+    }
+
+    state.onceIncluded.resize(reader.ReadCount());
+    for (auto& filename : state.onceIncluded)
+        filename = reader.ReadString();
+
+    state.includeGuards.resize(reader.ReadCount());
+    for (auto& includeGuard : state.includeGuards)
+    {
+        includeGuard.first  = reader.ReadString();
+        includeGuard.second = reader.ReadString();
+    }
+
+    state.includeCounter.resize(reader.ReadCount());
+    for (auto& counter : state.includeCounter)
+    {
+        counter.first   = reader.ReadString();
+        counter.second  = static_cast<std::size_t>(reader.ReadUInt64());
+    }
+
+    state.includes.resize(reader.ReadCount());
+    for (auto& include : state.includes)
+    {
+        include.filename        = reader.ReadString();
+        include.useSearchPaths  = (reader.ReadUInt8() != 0);
+        include.contentHash     = reader.ReadUInt64();
+    }
+
+    ReadTokenDescList(reader, state.output, numOrigins);
+}
+
+bool PreProcessorSnapshot::Save(std::ostream& stream) const
+{
+    if (!data_->valid)
+        return false;
+
+    /* Serialize state into payload */
+    SnapshotWriter writer;
+    WriteState(writer, data_->state);
+
+    return WriteSnapshot(stream, g_snapshotMagic, g_snapshotFormatVersion, data_->hash, writer.GetBuffer());
+}
+
+// Reads the content of the specified include file in the same way as the pre-processor does (see PreProcessor::ParseDirectiveInclude).
+static bool ReadIncludeFileHash(
+    IncludeHandler& includeHandler, IncludeCache* includeCache, const PreProcessorState::IncludeDesc& include, std::uint64_t& hash)
+{
+    if (includeCache && PreProcessor::IsIncludeCacheCompatible(includeHandler))
+    {
+        const auto path = includeHandler.FindFile(include.filename, include.useSearchPaths);
+        if (!path.empty())
+        {
+            if (auto content = includeCache->Fetch(path))
+            {
+                hash = HashFNV1a64(content->data(), content->size());
+                return true;
+            }
+        }
+    }
+
+    try
+    {
+        if (auto includeStream = includeHandler.Include(include.filename, include.useSearchPaths))
+        {
+            const std::string content { std::istreambuf_iterator<char>(*includeStream), std::istreambuf_iterator<char>() };
+            hash = HashFNV1a64(content.data(), content.size());
+            return true;
+        }
+    }
+    catch (const std::exception&)
+    {
+        /* Include file is missing, so the snapshot is stale */
+    }
+
+    return false;
+}
+
+bool ValidateIncludes(const std::vector<PreProcessorState::IncludeDesc>& includes, const ShaderInput& inputDesc)
+{
+    std::unique_ptr<IncludeHandler> stdIncludeHandler;
+    if (!inputDesc.includeHandler)
+        stdIncludeHandler = MakeUnique<IncludeHandler>();
+
+    auto includeHandler = (inputDesc.includeHandler != nullptr ? inputDesc.includeHandler : stdIncludeHandler.get());
+
+    for (const auto& include : includes)
+    {
+        std::uint64_t contentHash = 0;
+        if (!ReadIncludeFileHash(*includeHandler, inputDesc.includeCache, include, contentHash) || contentHash != include.contentHash)
+            return false;
+    }
+
+    return true;
+}
+
+bool PreProcessorSnapshot::Load(std::istream& stream, const ShaderInput& preludeDesc)
+{
+    Clear();
+
+    try
+    {
+        /* Read header and payload */
+        std::uint64_t hash = 0;
+        std::string payload;
+
+        if (!ReadSnapshot(stream, g_snapshotMagic, g_snapshotFormatVersion, hash, payload))
+            return false;
+
+        /* Deserialize state from payload */
+        PreProcessorState state;
+        SnapshotReader reader { payload };
+
+        ReadState(reader, state);
+
+        if (!reader.IsEnd() || state.shaderVersion != preludeDesc.shaderVersion)
+            return false;
+
+        /* Read all include files again, and validate the hash against the current prelude */
+        if (!ValidateIncludes(state.includes, preludeDesc))
+            return false;
+
+        auto inputSource = MakeInputSource(preludeDesc);
+
+        if (ComputeSnapshotHash(preludeDesc, *inputSource, state) != hash)
+            return false;
+
+        /* Accept snapshot */
+        data_->state    = std::move(state);
+        data_->hash     = hash;
+        data_->valid    = true;
+
+        return true;
+    }
+    catch (const std::runtime_error&)
+    {
+        /* Snapshot is corrupted */
+    }
+
+    return false;
+}
+
+void PreProcessorSnapshot::Clear()
+{
+    data_->state    = PreProcessorState();
+    data_->hash     = 0;
+    data_->valid    = false;
+}
+
+bool PreProcessorSnapshot::IsValid() const
+{
+    return data_->valid;
+}
+
+std::uint64_t PreProcessorSnapshot::GetHash() const
+{
+    return data_->hash;
+}
+
+const PreProcessorState& GetPreProcessorState(const PreProcessorSnapshot& snapshot)
+{
+    return snapshot.data_->state;
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
\ No newline at end of file
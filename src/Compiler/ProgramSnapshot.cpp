@@ -0,0 +1,286 @@
+/*
+ * ProgramSnapshot.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <Xsc/ProgramSnapshot.h>
+#include <Xsc/Xsc.h>
+#include "ProgramState.h"
+#include "Compiler.h"
+#include "SnapshotStream.h"
+#include <stdexcept>
+
+
+namespace Xsc
+{
+
+
+// Magic number and format version of the binary snapshot ("XSPG" in little endian).
+static const std::uint32_t g_snapshotMagic          = 0x47505358u;
+static const std::uint32_t g_snapshotFormatVersion  = 1u;
+
+struct ProgramSnapshot::OpaqueData
+{
+    ProgramState    state;
+    std::uint64_t   hash    = 0;
+    bool            valid   = false;
+};
+
+ProgramSnapshot::ProgramSnapshot() :
+    data_ { new OpaqueData() }
+{
+}
+
+ProgramSnapshot::~ProgramSnapshot()
+{
+    delete data_;
+}
+
+static std::uint64_t HashString(const std::string& s, std::uint64_t hash)
+{
+    /* Include the null terminator to separate consecutive strings */
+    return HashFNV1a64(s.c_str(), s.size() + 1, hash);
+}
+
+template <typename T>
+static std::uint64_t HashValue(const T& value, std::uint64_t hash)
+{
+    return HashFNV1a64(&value, sizeof(value), hash);
+}
+
+std::uint64_t ComputeProgramOptionsHash(const ShaderInput& inputDesc, const ShaderOutput& outputDesc)
+{
+    auto hash = HashFNV1a64(&g_snapshotFormatVersion, sizeof(g_snapshotFormatVersion));
+
+    /* The serialized program depends on the language extensions of the compiler build */
+    #ifdef XSC_ENABLE_LANGUAGE_EXT
+    const std::uint8_t languageExt = 1;
+    #else
+    const std::uint8_t languageExt = 0;
+    #endif
+
+    hash = HashValue(languageExt, hash);
+
+    /* Hash options of pre-processor, parser, and analyzer */
+    hash = HashString(inputDesc.filename, hash);
+    hash = HashValue(inputDesc.shaderVersion, hash);
+    hash = HashValue(inputDesc.shaderTarget, hash);
+    hash = HashString(inputDesc.entryPoint, hash);
+    hash = HashString(inputDesc.secondaryEntryPoint, hash);
+    hash = HashValue(inputDesc.extensions, hash);
+
+    for (const auto& macro : inputDesc.defines)
+    {
+        hash = HashString(macro.ident, hash);
+        hash = HashString(macro.value, hash);
+    }
+
+    const std::uint64_t preProcessorHash = (inputDesc.preProcessorSnapshot != nullptr ? inputDesc.preProcessorSnapshot->GetHash() : 0);
+    hash = HashValue(preProcessorHash, hash);
+
+    const std::uint8_t options[] =
+    {
+        static_cast<std::uint8_t>(outputDesc.options.rowMajorAlignment      ? 1 : 0),
+        static_cast<std::uint8_t>(outputDesc.options.preferWrappers         ? 1 : 0),
+        static_cast<std::uint8_t>(outputDesc.options.analyzeReachableOnly   ? 1 : 0),
+    };
+
+    hash = HashFNV1a64(options, sizeof(options), hash);
+
+    hash = HashString(outputDesc.nameMangling.inputPrefix, hash);
+    hash = HashString(outputDesc.nameMangling.outputPrefix, hash);
+    hash = HashString(outputDesc.nameMangling.reservedWordPrefix, hash);
+    hash = HashString(outputDesc.nameMangling.temporaryPrefix, hash);
+
+    return hash;
+}
+
+// Returns the validation hash of the program with the specified source code and the include files of the specified state.
+static std::uint64_t ComputeSnapshotHash(const SourceCode& source, const ProgramState& state)
+{
+    auto hash = HashValue(state.optionsHash, HashFNV1a64(source.Data(), source.Size()));
+
+    for (const auto& include : state.includes)
+    {
+        const std::uint8_t useSearchPaths = (include.useSearchPaths ? 1 : 0);
+        hash = HashString(include.filename, hash);
+        hash = HashValue(useSearchPaths, hash);
+        hash = HashValue(include.contentHash, hash);
+    }
+
+    return hash;
+}
+
+bool ProgramSnapshot::Create(const ShaderInput& inputDesc, const ShaderOutput& outputDesc, Log* log)
+{
+    Clear();
+
+    /* Read source code only once, for the compiler and for the validation hash */
+    auto inputSource = MakeInputSource(inputDesc);
+
+    auto inputDescCopy = inputDesc;
+    {
+        inputDescCopy.sourceCode            = nullptr;
+        inputDescCopy.sourceCodeBuffer      = inputSource->Data();
+        inputDescCopy.sourceCodeBufferSize  = inputSource->Size();
+        inputDescCopy.programSnapshot       = nullptr;
+    }
+
+    /* Pre-process, parse, and analyze input, and store serialized program */
+    Compiler compiler(log);
+
+    if (!compiler.AnalyzeShader(inputDescCopy, outputDesc, data_->state))
+        return false;
+
+    data_->state.optionsHash    = ComputeProgramOptionsHash(inputDesc, outputDesc);
+    data_->hash                 = ComputeSnapshotHash(*inputSource, data_->state);
+    data_->valid                = true;
+
+    return true;
+}
+
+
+/*
+ * Binary serialization
+ */
+
+static void WriteStringList(SnapshotWriter& writer, const std::vector<std::string>& strings)
+{
+    writer.WriteUInt32(static_cast<std::uint32_t>(strings.size()));
+    for (const auto& s : strings)
+        writer.WriteString(s);
+}
+
+static void ReadStringList(SnapshotReader& reader, std::vector<std::string>& strings)
+{
+    strings.resize(reader.ReadCount());
+    for (auto& s : strings)
+        s = reader.ReadString();
+}
+
+static void WriteState(SnapshotWriter& writer, const ProgramState& state)
+{
+    writer.WriteUInt64(state.optionsHash);
+
+    WriteStringList(writer, state.macros);
+    WriteStringList(writer, state.usedMacros);
+    WriteStringList(writer, state.dependencies);
+
+    writer.WriteUInt32(static_cast<std::uint32_t>(state.includes.size()));
+    for (const auto& include : state.includes)
+    {
+        writer.WriteString(include.filename);
+        writer.WriteUInt8(include.useSearchPaths ? 1 : 0);
+        writer.WriteUInt64(include.contentHash);
+    }
+
+    writer.WriteString(state.programBuffer);
+}
+
+static void ReadState(SnapshotReader& reader, ProgramState& state)
+{
+    state.optionsHash = reader.ReadUInt64();
+
+    ReadStringList(reader, state.macros);
+    ReadStringList(reader, state.usedMacros);
+    ReadStringList(reader, state.dependencies);
+
+    state.includes.resize(reader.ReadCount());
+    for (auto& include : state.includes)
+    {
+        include.filename        = reader.ReadString();
+        include.useSearchPaths  = (reader.ReadUInt8() != 0);
+        include.contentHash     = reader.ReadUInt64();
+    }
+
+    state.programBuffer = reader.ReadString();
+}
+
+bool ProgramSnapshot::Save(std::ostream& stream) const
+{
+    if (!data_->valid)
+        return false;
+
+    /* Serialize state into payload */
+    SnapshotWriter writer;
+    WriteState(writer, data_->state);
+
+    return WriteSnapshot(stream, g_snapshotMagic, g_snapshotFormatVersion, data_->hash, writer.GetBuffer());
+}
+
+bool ProgramSnapshot::Load(std::istream& stream, const ShaderInput& inputDesc, const ShaderOutput& outputDesc)
+{
+    Clear();
+
+    try
+    {
+        /* Read header and payload */
+        std::uint64_t hash = 0;
+        std::string payload;
+
+        if (!ReadSnapshot(stream, g_snapshotMagic, g_snapshotFormatVersion, hash, payload))
+            return false;
+
+        /* Deserialize state from payload */
+        ProgramState state;
+        SnapshotReader reader { payload };
+
+        ReadState(reader, state);
+
+        if (!reader.IsEnd() || state.optionsHash != ComputeProgramOptionsHash(inputDesc, outputDesc))
+            return false;
+
+        /* Read all include files again, and validate the hash against the current input */
+        if (!ValidateIncludes(state.includes, inputDesc))
+            return false;
+
+        auto inputSource = MakeInputSource(inputDesc);
+
+        if (ComputeSnapshotHash(*inputSource, state) != hash)
+            return false;
+
+        /* Accept snapshot */
+        data_->state    = std::move(state);
+        data_->hash     = hash;
+        data_->valid    = true;
+
+        return true;
+    }
+    catch (const std::runtime_error&)
+    {
+        /* Snapshot is corrupted */
+    }
+
+    return false;
+}
+
+void ProgramSnapshot::Clear()
+{
+    data_->state    = ProgramState();
+    data_->hash     = 0;
+    data_->valid    = false;
+}
+
+bool ProgramSnapshot::IsValid() const
+{
+    return data_->valid;
+}
+
+std::uint64_t ProgramSnapshot::GetHash() const
+{
+    return data_->hash;
+}
+
+const ProgramState& GetProgramState(const ProgramSnapshot& snapshot)
+{
+    return snapshot.data_->state;
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
\ No newline at end of file
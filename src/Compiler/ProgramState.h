@@ -0,0 +1,53 @@
+/*
+ * ProgramState.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_PROGRAM_STATE_H
+#define XSC_PROGRAM_STATE_H
+
+
+#include "PreProcessorState.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+
+namespace Xsc
+{
+
+
+class ProgramSnapshot;
+struct ShaderOutput;
+
+/*
+Analyzed program with the results of the pre-processor (see ProgramSnapshot).
+The program is stored as binary buffer (see ASTSerializer), so it can be read into the contexts of any compilation.
+*/
+struct ProgramState
+{
+    std::string                                 programBuffer;      // Serialized program
+    std::vector<std::string>                    macros;             // See Reflection::ReflectionData::macros
+    std::vector<std::string>                    usedMacros;         // See Reflection::ReflectionData::usedMacros
+    std::vector<std::string>                    dependencies;       // See Reflection::ReflectionData::dependencies
+    std::vector<PreProcessorState::IncludeDesc> includes;
+    std::uint64_t                               optionsHash = 0;    // Hash of the front-end options (see ComputeProgramOptionsHash)
+};
+
+// Returns the internal state of the specified snapshot (see ProgramSnapshot).
+const ProgramState& GetProgramState(const ProgramSnapshot& snapshot);
+
+// Returns the hash of all options that affect the front-end (i.e. pre-processor, parser, and analyzer), but not of the source code.
+std::uint64_t ComputeProgramOptionsHash(const ShaderInput& inputDesc, const ShaderOutput& outputDesc);
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
\ No newline at end of file
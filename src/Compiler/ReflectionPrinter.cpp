@@ -25,6 +25,8 @@ void ReflectionPrinter::PrintReflection(const Reflection::ReflectionData& reflec
     indentHandler_.IncIndent();
     {
         PrintReflectionObjects  ( reflectionData.macros,                "Macros"                               );
+        PrintReflectionObjects  ( reflectionData.usedMacros,            "Used Macros"                          );
+        PrintReflectionObjects  ( reflectionData.dependencies,          "Dependencies"                         );
         PrintReflectionObjects  ( reflectionData.records,               "Structures",           referencedOnly );
         PrintReflectionObjects  ( reflectionData.inputAttributes,       "Input Attributes",     referencedOnly );
         PrintReflectionObjects  ( reflectionData.outputAttributes,      "Output Attributes",    referencedOnly );
@@ -102,6 +102,11 @@ void ReportHandler::SubmitReport(
         log_->SubmitReport(report);
 }
 
+bool ReportHandler::HasErrorAt(const SourceArea& area) const
+{
+    return (area.Pos().IsValid() && errorPositions_.find(area.Pos()) != errorPositions_.end());
+}
+
 void ReportHandler::PushContextDesc(const std::string& contextDesc)
 {
     contextDescStack_.push(contextDesc);
@@ -138,6 +143,15 @@ Report ReportHandler::MakeReport(
         contextDesc += "':";
     }
 
+    /* Prefer the source code the area refers to (e.g. for tokens that were handed over from the pre-processor), if it is still alive */
+    SourceCodePtr originSourceCode;
+    if (auto origin = area.Pos().GetOrigin())
+    {
+        originSourceCode = origin->sourceCode.lock();
+        if (originSourceCode)
+            sourceCode = originSourceCode.get();
+    }
+
     /* Make report with parameters */
     if (sourceCode != nullptr && area.Length() > 0)
     {
@@ -59,6 +59,9 @@ class ReportHandler
             return hasErrors_;
         }
 
+        // Returns true if an error has already been submitted at the specified source area, i.e. another error at this area would be discarded.
+        bool HasErrorAt(const SourceArea& area) const;
+
         // Pushes the specified context description string onto the stack. The top most description will be added to the next report message.
         void PushContextDesc(const std::string& contextDesc);
         void PopContextDesc();
@@ -206,6 +206,7 @@ DECL_REPORT( UnknownPPDirective,                "unknown preprocessor directive:
 DECL_REPORT( UnknownMatrixPackAlignment,        "unknown matrix pack alignment: \"{0}\" (must be \"row_major\" or \"column_major\")"                            );
 DECL_REPORT( UnknownPragma,                     "unknown pragma: \"{0}\""                                                                                       );
 DECL_REPORT( InvalidMacroIdentTokenArg,         "invalid argument for macro identifier token"                                                                   );
+DECL_REPORT( InvalidPredefinedMacro,            "invalid identifier for pre-defined macro: \"{0}\""                                                             );
 DECL_REPORT( FailedToUndefMacro,                "failed to undefine macro \"{0}\""                                                                              );
 DECL_REPORT( MacroRedef,                        "redefinition of macro \"{0}\"[ {1}]"                                                                           );
 DECL_REPORT( WithMismatchInParamListAndBody,    "with mismatch in parameter list and body definition"                                                           );
@@ -503,11 +504,15 @@ DECL_REPORT( SPIRVByteStreamNotWordAligned,     "byte stream of SPIR-V module is
 
 /* ----- Xsc ----- */
 
-DECL_REPORT( InputStreamCantBeNull,             "input stream must not be null"                                                                                 );
+DECL_REPORT( InputStreamCantBeNull,             "input stream or buffer must not be null"                                                                       );
 DECL_REPORT( OutputStreamCantBeNull,            "output stream must not be null"                                                                                );
 DECL_REPORT( NameManglingPrefixResCantBeEmpty,  "name mangling prefix for reserved words must not be empty"                                                     );
 DECL_REPORT( NameManglingPrefixTmpCantBeEmpty,  "name mangling prefix for temporary variables must not be empty"                                                );
 DECL_REPORT( OverlappingNameManglingPrefixes,   "overlapping name mangling prefixes"                                                                            );
+DECL_REPORT( InvalidPreProcessorSnapshot,       "pre-processor snapshot is invalid"                                                                             );
+DECL_REPORT( PreProcessorSnapshotLangMismatch,  "pre-processor snapshot was created for another shader language"                                                );
+DECL_REPORT( InvalidProgramSnapshot,            "program snapshot is invalid"                                                                                   );
+DECL_REPORT( ProgramSnapshotMismatch,           "program snapshot was created with other options of the front-end"                                              );
 DECL_REPORT( LangExtensionsNotSupported,        "compiler was not build with language extensions"                                                               );
 DECL_REPORT( PreProcessingSourceFailed,         "preprocessing input code failed"                                                                               );
 DECL_REPORT( ParsingSourceFailed,               "parsing input code failed"                                                                                     );
@@ -526,16 +531,22 @@ DECL_REPORT( PressAnyKeyToContinue,             "press any key to continue ..."
 DECL_REPORT( FailedToReadFile,                  "failed to read file: \"{0}\""                                                                                  );
 DECL_REPORT( FailedToWriteFile,                 "failed to write file: \"{0}\""                                                                                 );
 DECL_REPORT( FailedToIncludeFile,               "failed to include file: \"{0}\""                                                                               );
+DECL_REPORT( OutputFilenameNeedsWildcard,       "output filename must contain '*' to compile multiple entry points: \"{0}\""                                    );
 DECL_REPORT( ValidateShader,                    "validate \"{0}\""                                                                                              );
 DECL_REPORT( ValidationSuccessful,              "validation successful"                                                                                         );
 DECL_REPORT( ValidationFailed,                  "validation failed"                                                                                             );
 DECL_REPORT( CompileShader,                     "compile \"{0}\" to \"{1}\""                                                                                    );
 DECL_REPORT( CompilationSuccessful,             "compilation successful"                                                                                        );
 DECL_REPORT( CompilationFailed,                 "compilation failed"                                                                                            );
+DECL_REPORT( ScanDependencies,                  "scan dependencies of \"{0}\""                                                                                  );
+DECL_REPORT( DependencyScanSuccessful,          "dependency scan successful"                                                                                    );
+DECL_REPORT( DependencyScanFailed,              "dependency scan failed"                                                                                        );
+DECL_REPORT( SnapshotCheckFailed,               "{0} snapshot check failed: snapshot could not be created, saved, or loaded again"                              );
+DECL_REPORT( SnapshotCheckMismatch,             "{0} snapshot check failed: output differs from the compilation without snapshot"                               );
 
 /* ----- Commands ----- */
 
-DECL_REPORT( CmdHelpEntry,                      "Shader entry point; default=main"                                                                              );
+DECL_REPORT( CmdHelpEntry,                      "Shader entry point; default=main (repeat -E to compile multiple entry points of the same file with the preceding -T)");
 DECL_REPORT( CmdHelpSecndEntry,                 "Secondary shader entry point"                                                                                  );
 DECL_REPORT( CmdHelpTarget,                     "Input shader target; valid targets:"                                                                           );
 DECL_REPORT( CmdHelpVersionIn,                  "Input shader version; default=HLSL5; valid versions:"                                                          );
@@ -556,9 +567,12 @@ DECL_REPORT( CmdHelpDetailsWarn,                "all           => all kinds of w
                                                 "unlocated-obj => warn for unlocated optional objects\n" \
                                                 "unused-vars   => warn for unused variables"                                                                    );
 DECL_REPORT( CmdHelpShowAST,                    "Enables/disables debug output for the AST (Abstract Syntax Tree); default={0}"                                 );
-DECL_REPORT( CmdHelpShowTimes,                  "Enables/disables debug output for timings of each compilation step; default={0}"                               );
+DECL_REPORT( CmdHelpShowTimes,                  "Enables/disables debug output for timings of each compilation step and overload resolution statistics; default={0}" );
 DECL_REPORT( CmdHelpReflect,                    "Enables/disables code reflection output; default={0}"                                                          );
 DECL_REPORT( CmdHelpPPOnly,                     "Enables/disables to only preprocess source code; default={0}"                                                  );
+DECL_REPORT( CmdHelpDepsOnly,                   "Enables/disables to only scan the included files for the dependency file (implies -MD); default={0}"           );
+DECL_REPORT( CmdHelpDepFile,                    "Enables/disables writing a make-style dependency file; default={0}"                                            );
+DECL_REPORT( CmdHelpDepFilename,                "Dependency file (implies -MD); default='<OUTPUT>.d'"                                                           );
 DECL_REPORT( CmdHelpMacro,                      "Adds the identifier <IDENT> to the pre-defined macros with an optional VALUE"                                  );
 DECL_REPORT( CmdHelpSemantic,                   "Adds the vertex semantic <IDENT> binding to VALUE (Requires -EB)"                                              );
 DECL_REPORT( CmdHelpPackUniforms,               "Packs global uniforms into a single constant buffer; default={0}"                                              );
@@ -569,6 +583,7 @@ DECL_REPORT( CmdHelpHelp,                       "Prints the help reference"
 DECL_REPORT( CmdHelpVerbose,                    "Enables/disables more output for compiler reports; default={0}"                                                );
 DECL_REPORT( CmdHelpColor,                      "Enables/disables color highlighting for shell output; default={0}"                                             );
 DECL_REPORT( CmdHelpOptimize,                   "Enables/disables optimization; default={0}"                                                                    );
+DECL_REPORT( CmdHelpReachableOnly,              "Enables/disables to only analyze functions that are reachable from the entry points; default={0}"              );
 DECL_REPORT( CmdHelpExtension,                  "Enables/disables shader extension output; default={0}"                                                         );
 DECL_REPORT( CmdHelpEnumExtension,              "Enumerates all supported GLSL extensions"                                                                      );
 DECL_REPORT( CmdHelpValidate,                   "Enables/disables to only validate source code; default={0}"                                                    );
@@ -599,6 +614,8 @@ DECL_REPORT( CmdHelpDetailsNameMangling,        "buffer-fields   => rename 'buff
                                                 "force-semantics => force semantics for input/output variables; default={0}"                                    );
 DECL_REPORT( CmdHelpSeparateShaders,            "Ensures compatibility to 'ARB_separate_shader_objects' extension; default={0}"                                 );
 DECL_REPORT( CmdHelpSeparateSamplers,           "Enables/disables generation of separate sampler state objects; default={0}"                                    );
+DECL_REPORT( CmdHelpSnapshotCheck,              "Enables/disables the round trip of pre-processor and program snapshots for each compilation; default={0}"      );
+DECL_REPORT( CmdHelpTokenStream,                "Enables/disables passing the token stream from the pre-processor directly to the parser; default={0}"          );
 DECL_REPORT( CmdHelpDisassemble,                "Disassembles the SPIR-V module"                                                                                );
 DECL_REPORT( CmdHelpDisassembleExt,             "Disassembles the SPIR-V module with extended ID numbers"                                                       );
 DECL_REPORT( InvalidShaderTarget,               "invalid shader target[: '{0}']"                                                                                );
@@ -0,0 +1,75 @@
+/*
+ * SnapshotStream.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "SnapshotStream.h"
+#include "PreProcessorState.h"
+#include <iterator>
+
+
+namespace Xsc
+{
+
+
+bool WriteSnapshot(
+    std::ostream& stream, std::uint32_t magic, std::uint32_t formatVersion, std::uint64_t hash, const std::string& payload)
+{
+    /* Write header, payload, and checksum of the payload */
+    SnapshotWriter header;
+    {
+        header.WriteUInt32(magic);
+        header.WriteUInt32(formatVersion);
+        header.WriteUInt64(hash);
+        header.WriteUInt64(payload.size());
+    }
+
+    SnapshotWriter footer;
+    footer.WriteUInt64(HashFNV1a64(payload.data(), payload.size()));
+
+    stream.write(header.GetBuffer().data(), static_cast<std::streamsize>(header.GetBuffer().size()));
+    stream.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+    stream.write(footer.GetBuffer().data(), static_cast<std::streamsize>(footer.GetBuffer().size()));
+
+    return stream.good();
+}
+
+bool ReadSnapshot(
+    std::istream& stream, std::uint32_t magic, std::uint32_t formatVersion, std::uint64_t& hash, std::string& payload)
+{
+    /* Read header */
+    std::string headerBuffer(24, '\0');
+    if (!stream.read(&headerBuffer[0], static_cast<std::streamsize>(headerBuffer.size())))
+        return false;
+
+    SnapshotReader header { headerBuffer };
+
+    if (header.ReadUInt32() != magic || header.ReadUInt32() != formatVersion)
+        return false;
+
+    hash = header.ReadUInt64();
+
+    const auto payloadSize = header.ReadUInt64();
+
+    /* Read payload with the trailing checksum, and compare the checksum */
+    payload.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+
+    if (payload.size() < 8 || payload.size() - 8 != payloadSize)
+        return false;
+
+    const auto footerBuffer = payload.substr(payload.size() - 8);
+    payload.resize(payload.size() - 8);
+
+    SnapshotReader footer { footerBuffer };
+
+    return (footer.ReadUInt64() == HashFNV1a64(payload.data(), payload.size()));
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
\ No newline at end of file
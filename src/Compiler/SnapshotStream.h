@@ -0,0 +1,202 @@
+/*
+ * SnapshotStream.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_SNAPSHOT_STREAM_H
+#define XSC_SNAPSHOT_STREAM_H
+
+
+#include <string>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace Xsc
+{
+
+
+// Binary writer for a snapshot payload (all fixed-size integers are written in little endian).
+class SnapshotWriter
+{
+
+    public:
+
+        void WriteUInt(std::uint64_t value, std::size_t size)
+        {
+            for (std::size_t i = 0; i < size; ++i)
+                buffer_.push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+        }
+
+        void WriteUInt8(std::uint8_t value)
+        {
+            WriteUInt(value, 1);
+        }
+
+        void WriteUInt32(std::uint32_t value)
+        {
+            WriteUInt(value, 4);
+        }
+
+        void WriteUInt64(std::uint64_t value)
+        {
+            WriteUInt(value, 8);
+        }
+
+        // Writes the specified value with a variable length of 7 bits per byte (LEB128), so small values take a single byte.
+        void WriteVarUInt(std::uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                buffer_.push_back(static_cast<char>((value & 0x7F) | 0x80));
+                value >>= 7;
+            }
+            buffer_.push_back(static_cast<char>(value));
+        }
+
+        void WriteString(const std::string& s)
+        {
+            WriteUInt32(static_cast<std::uint32_t>(s.size()));
+            buffer_.append(s);
+        }
+
+        const std::string& GetBuffer() const
+        {
+            return buffer_;
+        }
+
+    private:
+
+        std::string buffer_;
+
+};
+
+// Binary reader for a snapshot payload, which throws an std::runtime_error if the payload is truncated.
+class SnapshotReader
+{
+
+    public:
+
+        SnapshotReader(const std::string& buffer) :
+            buffer_ { buffer }
+        {
+        }
+
+        std::uint64_t ReadUInt(std::size_t size)
+        {
+            if (size > buffer_.size() - pos_)
+                throw std::runtime_error("truncated snapshot");
+
+            std::uint64_t value = 0;
+            for (std::size_t i = 0; i < size; ++i)
+                value |= (static_cast<std::uint64_t>(static_cast<unsigned char>(buffer_[pos_++])) << (i * 8));
+
+            return value;
+        }
+
+        std::uint8_t ReadUInt8()
+        {
+            return static_cast<std::uint8_t>(ReadUInt(1));
+        }
+
+        std::uint32_t ReadUInt32()
+        {
+            return static_cast<std::uint32_t>(ReadUInt(4));
+        }
+
+        std::uint64_t ReadUInt64()
+        {
+            return ReadUInt(8);
+        }
+
+        std::uint64_t ReadVarUInt()
+        {
+            std::uint64_t value = 0;
+
+            for (unsigned int shift = 0; shift < 64; shift += 7)
+            {
+                if (pos_ == buffer_.size())
+                    throw std::runtime_error("truncated snapshot");
+
+                const auto byte = static_cast<unsigned char>(buffer_[pos_++]);
+                value |= (static_cast<std::uint64_t>(byte & 0x7F) << shift);
+
+                if ((byte & 0x80) == 0)
+                    return value;
+            }
+
+            throw std::runtime_error("invalid variable-length integer in snapshot");
+        }
+
+        std::string ReadString()
+        {
+            const std::size_t size = ReadUInt32();
+            if (size > buffer_.size() - pos_)
+                throw std::runtime_error("truncated snapshot");
+
+            std::string s = buffer_.substr(pos_, size);
+            pos_ += size;
+
+            return s;
+        }
+
+        // Reads the number of elements of a list, which must not exceed the remaining payload (each element takes at least one byte).
+        std::size_t ReadCount()
+        {
+            const std::size_t count = ReadUInt32();
+            if (count > buffer_.size() - pos_)
+                throw std::runtime_error("truncated snapshot");
+            return count;
+        }
+
+        // Reads the number of elements of a list with a variable-length integer (see ReadCount).
+        std::size_t ReadVarCount()
+        {
+            const auto count = ReadVarUInt();
+            if (count > buffer_.size() - pos_)
+                throw std::runtime_error("truncated snapshot");
+            return static_cast<std::size_t>(count);
+        }
+
+        bool IsEnd() const
+        {
+            return (pos_ == buffer_.size());
+        }
+
+    private:
+
+        const std::string&  buffer_;
+        std::size_t         pos_    = 0;
+
+};
+
+/*
+Writes a snapshot with the specified magic number, format version, and validation hash to the specified stream,
+followed by the payload and a checksum of the payload. Returns false if the stream could not be written.
+*/
+bool WriteSnapshot(
+    std::ostream& stream, std::uint32_t magic, std::uint32_t formatVersion, std::uint64_t hash, const std::string& payload
+);
+
+/*
+Reads a snapshot that was written by 'WriteSnapshot' from the specified stream.
+Returns false if the magic number or format version does not match, or if the payload is truncated or its checksum does not match.
+*/
+bool ReadSnapshot(
+    std::istream& stream, std::uint32_t magic, std::uint32_t formatVersion, std::uint64_t& hash, std::string& payload
+);
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
\ No newline at end of file
@@ -13,39 +13,92 @@ namespace Xsc
 {
 
 
-SourceCode::SourceCode(const std::shared_ptr<std::istream>& stream) :
-    stream_ { stream }
+// Reads the entire input stream into a single string buffer
+static std::string ReadStreamBuffer(std::istream& stream)
+{
+    std::string buffer;
+
+    /* Reserve buffer size if the stream supports seeking */
+    auto startPos = stream.tellg();
+    if (startPos != std::istream::pos_type(-1))
+    {
+        stream.seekg(0, std::ios::end);
+        auto endPos = stream.tellg();
+        stream.seekg(startPos);
+
+        if (endPos != std::istream::pos_type(-1) && endPos > startPos)
+        {
+            buffer.resize(static_cast<std::size_t>(endPos - startPos));
+            stream.read(&buffer[0], static_cast<std::streamsize>(buffer.size()));
+            buffer.resize(static_cast<std::size_t>(stream.gcount()));
+            return buffer;
+        }
+    }
+
+    /* Read stream in blocks otherwise */
+    char block[4096];
+    while (stream.read(block, sizeof(block)) || stream.gcount() > 0)
+        buffer.append(block, static_cast<std::size_t>(stream.gcount()));
+
+    return buffer;
+}
+
+SourceCode::SourceCode(const std::shared_ptr<std::istream>& stream)
+{
+    if (stream != nullptr && stream->good())
+    {
+        auto buffer = std::make_shared<std::string>(ReadStreamBuffer(*stream));
+        {
+            data_   = buffer->data();
+            size_   = buffer->size();
+            valid_  = true;
+        }
+        owner_ = std::move(buffer);
+    }
+}
+
+SourceCode::SourceCode(std::string&& buffer)
+{
+    auto sharedBuffer = std::make_shared<std::string>(std::move(buffer));
+    {
+        data_   = sharedBuffer->data();
+        size_   = sharedBuffer->size();
+        valid_  = true;
+    }
+    owner_ = std::move(sharedBuffer);
+}
+
+SourceCode::SourceCode(const char* data, std::size_t size, const std::shared_ptr<const void>& owner) :
+    owner_ { owner                              },
+    data_  { data                               },
+    size_  { size                               },
+    valid_ { (data != nullptr || size == 0)     }
 {
 }
 
 bool SourceCode::IsValid() const
 {
-    return (stream_ != nullptr && stream_->good());
+    return valid_;
 }
 
 char SourceCode::Next()
 {
-    /* Check if reader is at end-of-line */
-    while (pos_.Column() >= currentLine_.size())
+    /* Check if reader is at end-of-line (the new-line character is included in the line length) */
+    while (lineStart_ + pos_.Column() > lineEnd_ || lineStarts_.empty())
     {
-        /* Check if end-of-file is reached */
-        if (!IsValid() || stream_->eof())
+        /* Check if end-of-file is reached (a new-line character at the end of the buffer does not start another line) */
+        if (!IsValid() || nextLineStart_ > size_ || (nextLineStart_ == size_ && !lineStarts_.empty()))
             return 0;
 
-        /* Read new line in source file */
-        std::getline(*stream_, currentLine_);
-        currentLine_ += '\n';
-        pos_.IncRow();
-
-        /* Store current line for later reports */
-        lines_.push_back(currentLine_);
+        /* Move to next line in source buffer */
+        NextLine();
     }
 
-    /* Increment column and return current character */
-    auto chr = currentLine_[pos_.Column()];
+    /* Increment column and return current character (the last line always ends with a new-line character) */
+    auto offset = lineStart_ + pos_.Column();
     pos_.IncColumn();
 
-    return chr;
+    return (offset < lineEnd_ ? data_[offset] : '\n');
 }
 
 // Builds the line marker for reports (e.g. "^~~~~~~")
@@ -98,9 +151,7 @@ bool SourceCode::FetchLineMarker(const SourceArea& area, std::string& line, std:
     if (area.Length() > 0)
     {
         auto row = area.Pos().Row();
-        if (row == pos_.Row())
-            return BuildLineMarker(area, Line(), line, marker);
-        else if (row > 0)
+        if (row > 0)
             return BuildLineMarker(area, GetLine(static_cast<std::size_t>(row - 1)), line, marker);
     }
     return false;
@@ -112,10 +163,16 @@ void SourceCode::NextSourceOrigin(const std::string& filename, int lineOffset)
     {
         origin->filename    = filename;
         origin->lineOffset  = lineOffset;
+        origin->sourceCode  = shared_from_this();
     }
     pos_.SetOrigin(origin);
 }
 
+std::string SourceCode::Line() const
+{
+    return (pos_.Row() > 0 ? GetLine(static_cast<std::size_t>(pos_.Row() - 1)) : "");
+}
+
 std::string SourceCode::Filename() const
 {
     if (auto origin = pos_.GetOrigin())
@@ -131,7 +188,32 @@ std::string SourceCode::Filename() const
 
 std::string SourceCode::GetLine(std::size_t lineIndex) const
 {
-    return (lineIndex < lines_.size() ? lines_[lineIndex] : "");
+    if (lineIndex < lineStarts_.size())
+    {
+        /* Find end of line in source buffer and append new-line character */
+        auto start  = lineStarts_[lineIndex];
+        auto end    = (lineIndex + 1 < lineStarts_.size() ? lineStarts_[lineIndex + 1] - 1 : lineEnd_);
+
+        std::string line(data_ + start, end - start);
+        line += '\n';
+
+        return line;
+    }
+    return "";
+}
+
+void SourceCode::NextLine()
+{
+    lineStart_ = nextLineStart_;
+
+    /* Find next new-line character in source buffer */
+    auto lineEndPtr = (lineStart_ < size_ ? std::char_traits<char>::find(data_ + lineStart_, size_ - lineStart_, '\n') : nullptr);
+    lineEnd_ = (lineEndPtr != nullptr ? static_cast<std::size_t>(lineEndPtr - data_) : size_);
+    nextLineStart_ = lineEnd_ + 1;
+
+    /* Store line start offset for later reports */
+    lineStarts_.push_back(lineStart_);
+    pos_.IncRow();
 }
 
 
@@ -139,4 +221,4 @@ std::string SourceCode::GetLine(std::size_t lineIndex) const
 
 
 
-// ================================================================================
+// ================================================================================
\ No newline at end of file
@@ -21,14 +21,31 @@ namespace Xsc
 {
 
 
-// Source code stream class.
-class SourceCode
+/*
+Source code class over a single contiguous and read-only character buffer.
+Only the start offsets of all lines that have been read so far are stored (for later reports).
+Source code objects must always be owned by a shared pointer, since their source origins refer to them (see SourceOrigin::sourceCode).
+*/
+class SourceCode : public std::enable_shared_from_this<SourceCode>
 {
 
     public:
 
+        SourceCode(const SourceCode&) = delete;
+        SourceCode& operator = (const SourceCode&) = delete;
+
+        // Reads the entire stream into an internal buffer.
         SourceCode(const std::shared_ptr<std::istream>& stream);
 
+        // Takes the ownership of the specified string buffer.
+        SourceCode(std::string&& buffer);
+
+        /*
+        Refers to the specified caller-owned buffer without a copy. The buffer must stay alive as long as this source code object,
+        unless 'owner' is specified, which then keeps the buffer alive (e.g. a memory mapped file or a shared string).
+        */
+        SourceCode(const char* data, std::size_t size, const std::shared_ptr<const void>& owner = nullptr);
+
         // Returns true if this is a valid source code stream.
         bool IsValid() const;
 
@@ -53,15 +70,30 @@ class SourceCode
             return pos_;
         }
 
-        // Returns the current source line.
-        inline const std::string& Line() const
+        // Returns the buffer offset of the character that was returned by the last call to "Next()".
+        inline std::size_t Offset() const
         {
-            return currentLine_;
+            return (pos_.Column() > 0 ? lineStart_ + pos_.Column() - 1 : lineStart_);
         }
 
+        // Returns the current source line.
+        std::string Line() const;
+
         // Returns the filename of the current source position (see SourcePosition::GetOrigin).
         std::string Filename() const;
 
+        // Returns the pointer to the beginning of the source buffer.
+        inline const char* Data() const
+        {
+            return data_;
+        }
+
+        // Returns the size (in bytes) of the source buffer.
+        inline std::size_t Size() const
+        {
+            return size_;
+        }
+
     protected:
 
         SourceCode() = default;
@@ -69,10 +101,22 @@ class SourceCode
         // Returns the line (if it has already been read) by the zero-based line index.
         std::string GetLine(std::size_t lineIndex) const;
 
-        std::shared_ptr<std::istream>   stream_;
-        std::string                     currentLine_;
-        std::vector<std::string>        lines_;
-        SourcePosition                  pos_;
+    private:
+
+        // Moves the reader to the next line in the buffer and stores its start offset.
+        void NextLine();
+
+        std::shared_ptr<const void> owner_;                     // Keeps the buffer alive (null for caller-owned buffers)
+        const char*                 data_           = nullptr;
+        std::size_t                 size_           = 0;
+        bool                        valid_          = false;
+
+        std::vector<std::size_t>    lineStarts_;                // Start offsets of all lines that have been read so far
+        std::size_t                 lineStart_      = 0;        // Start offset of the current line
+        std::size_t                 lineEnd_        = 0;        // End offset of the current line (excluding the new-line character)
+        std::size_t                 nextLineStart_  = 0;        // Start offset of the next line
+
+        SourcePosition              pos_;
 
 };
 
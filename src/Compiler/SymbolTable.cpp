@@ -9,6 +9,7 @@
 #include "Exception.h"
 #include "ReportHandler.h"
 #include "ReportIdents.h"
+#include "ResolutionCache.h"
 #include <algorithm>
 #include <cctype>
 
@@ -110,7 +111,8 @@ void RuntimeErrIdentAlreadyDeclared(const std::string& ident, const AST* prevDec
  */
 
 ASTSymbolOverload::ASTSymbolOverload(const std::string& ident, AST* ast) :
-    ident_ { ident }
+    ident_          { ident                           },
+    resolutionKey_  { ResolutionCache::NewSymbolKey() }
 {
     /* Add initial reference */
     refs_.push_back(ast);
@@ -121,6 +123,9 @@ bool ASTSymbolOverload::AddSymbolRef(AST* ast)
     if (!ast)
         return false;
 
+    /* Invalidate all previous overload resolutions of this symbol */
+    resolutionKey_ = ResolutionCache::NewSymbolKey();
+
     /* Is this the first symbol reference? */
     if (!refs_.empty())
     {
@@ -237,6 +242,14 @@ FunctionDecl* ASTSymbolOverload::FetchFunctionDecl(const std::vector<TypeDenoter
     if (refs_.front()->Type() != AST::Types::FunctionDecl)
         RuntimeErr(R_IdentIsNotFunc(ident_));
 
+    /* Find previous resolution with the same argument types */
+    auto cache = ResolutionCache::Active();
+    if (cache)
+    {
+        if (auto funcDecl = cache->FindFunctionDecl(resolutionKey_, argTypeDenoters))
+            return funcDecl;
+    }
+
     /* Convert symbol references to function declaration pointers */
     std::vector<FunctionDecl*> funcDeclList;
     funcDeclList.reserve(refs_.size());
@@ -250,7 +263,12 @@ FunctionDecl* ASTSymbolOverload::FetchFunctionDecl(const std::vector<TypeDenoter
     }
 
     /* Fetch function declaration from list */
-    return FunctionDecl::FetchFunctionDeclFromList(funcDeclList, ident_, argTypeDenoters);
+    auto funcDecl = FunctionDecl::FetchFunctionDeclFromList(funcDeclList, ident_, argTypeDenoters);
+
+    if (cache)
+        cache->StoreFunctionDecl(resolutionKey_, argTypeDenoters, funcDecl);
+
+    return funcDecl;
 }
 
 
@@ -10,11 +10,11 @@
 
 
 #include "AST.h"
-#include <map>
+#include "Hash.h"
 #include <string>
-#include <stack>
 #include <vector>
 #include <functional>
+#include <cstdint>
 
 
 namespace Xsc
@@ -51,7 +51,13 @@ struct GenericDefaultValue<bool>
     }
 };
 
-// Common symbol table class with a single scope.
+/*
+Common symbol table class with a scope hierarchy.
+Identifiers are stored by their atoms (see AtomTable) in an open addressing hash map, so a lookup only hashes and compares pointers
+(identifiers that are passed as strings are interned in the active atom table first). All visible symbols are stored in an undo log (one record per registered symbol),
+where each record refers to the record it shadows. Closing a scope only rewinds the undo log to the position of the scope,
+so neither opening nor closing a scope allocates memory once the containers have grown.
+*/
 template <typename SymbolType>
 class SymbolTable
 {
@@ -67,7 +73,8 @@ class SymbolTable
         // Search predicate function signature.
         using SearchPredicateProc = std::function<bool(const SymbolType& symbol)>;
 
-        SymbolTable()
+        SymbolTable() :
+            slots_ ( 64, 0 )
         {
             OpenScope();
         }
@@ -75,45 +82,39 @@ class SymbolTable
         // Opens a new scope.
         void OpenScope()
         {
-            scopeStack_.push({});
-            symTableAnonymous_.push_back({});
+            scopes_.push_back({ records_.size(), anonymousRecords_.size() });
         }
 
         // Closes the active scope.
         void CloseScope(const OnReleaseProc& releaseProc = nullptr)
         {
-            if (!scopeStack_.empty())
+            if (!scopes_.empty())
             {
-                /* Remove all symbols from the table which are in the current scope */
-                for (const auto& ident : scopeStack_.top())
-                {
-                    auto it = symTable_.find(ident);
-                    if (it != symTable_.end())
-                    {
-                        /* Callback for released symbol */
-                        if (releaseProc)
-                            releaseProc(it->second.top().symbol);
-
-                        /* Remove symbol from the top most scope level */
-                        it->second.pop();
-                        if (it->second.empty())
-                        {
-                            /* Remove symbol entry completely if it's reference list is empty */
-                            symTable_.erase(it);
-                        }
-                    }
-                }
+                const auto& scope = scopes_.back();
 
                 if (releaseProc)
                 {
+                    /* Release all symbols of the current scope in the order they have been registered */
+                    for (auto i = scope.recordsBegin; i < records_.size(); ++i)
+                        releaseProc(records_[i].symbol);
+
                     /* Release all symbols from the anonymous symbol table */
-                    for (const auto& sym : symTableAnonymous_.back())
-                        releaseProc(sym.symbol);
+                    for (auto i = scope.anonymousRecordsBegin; i < anonymousRecords_.size(); ++i)
+                        releaseProc(anonymousRecords_[i].symbol);
                 }
 
+                /* Rewind undo log, i.e. make the symbols visible again that were shadowed by the current scope */
+                while (records_.size() > scope.recordsBegin)
+                {
+                    const auto& record = records_.back();
+                    entries_[record.entry].top = record.prev;
+                    records_.pop_back();
+                }
+
+                anonymousRecords_.resize(scope.anonymousRecordsBegin);
+
                 /* Decrease scope level */
-                scopeStack_.pop();
-                symTableAnonymous_.pop_back();
+                scopes_.pop_back();
             }
         }
 
@@ -121,113 +122,136 @@ class SymbolTable
         Registers the specified symbol in the current scope (if the identifier is not empty).
         At least one scope must be open before symbols can be registered!
         */
-        bool Register(const std::string& ident, SymbolType symbol, const OnOverrideProc& overrideProc = nullptr, bool throwOnFailure = true)
+        bool Register(Atom ident, SymbolType symbol, const OnOverrideProc& overrideProc = nullptr, bool throwOnFailure = true)
         {
             /* Validate input parameters */
-            if (scopeStack_.empty())
+            if (scopes_.empty())
                 RuntimeErrNoActiveScope();
 
-            if (ident.empty())
+            if (ident->empty())
             {
                 /* Register symbol in anonymous symbol table */
-                symTableAnonymous_.back().push_back({ symbol, ScopeLevel() });
+                anonymousRecords_.push_back({ symbol, ScopeLevel(), 0, 0 });
             }
             else
             {
                 /* Check if identifier was already registered in the current scope */
-                auto it = symTable_.find(ident);
-                if (it != symTable_.end() && !it->second.empty())
+                const auto entryIndex = FindOrInsertEntry(ident);
+                auto& entry = entries_[entryIndex];
+
+                if (entry.top != 0)
                 {
-                    auto& entry = it->second.top();
-                    if (entry.symbol && entry.scopeLevel == ScopeLevel())
+                    auto& record = records_[entry.top - 1];
+                    if (record.symbol && record.scopeLevel == ScopeLevel())
                     {
                         /* Call override procedure and pass previous symbol entry as reference */
-                        if (overrideProc && overrideProc(entry.symbol))
+                        if (overrideProc && overrideProc(record.symbol))
                             return true;
                         else if (throwOnFailure)
-                            RuntimeErrIdentAlreadyDeclared(ident, FetchASTFromSymbol(entry.symbol));
+                            RuntimeErrIdentAlreadyDeclared(*ident, FetchASTFromSymbol(record.symbol));
                         else
                             return false;
                     }
                 }
 
                 /* Register new identifier */
-                symTable_[ident].push({ symbol, ScopeLevel() });
-                scopeStack_.top().push_back(ident);
+                records_.push_back({ symbol, ScopeLevel(), entry.top, entryIndex });
+                entry.top = records_.size();
             }
 
             return true;
         }
 
+        // Registers the specified symbol in the current scope (see the overload with an atom).
+        bool Register(const std::string& ident, SymbolType symbol, const OnOverrideProc& overrideProc = nullptr, bool throwOnFailure = true)
+        {
+            return Register(AtomTable::InternActive(ident), symbol, overrideProc, throwOnFailure);
+        }
+
         // Returns the symbol with the specified identifer which is in the deepest scope, or null if there is no such symbol.
-        SymbolType Fetch(const std::string& ident) const
+        SymbolType Fetch(Atom ident) const
         {
-            auto it = symTable_.find(ident);
-            if (it != symTable_.end() && !it->second.empty())
-                return it->second.top().symbol;
+            if (auto record = FindTopRecord(ident))
+                return record->symbol;
             else
                 return GenericDefaultValue<SymbolType>::Get();
         }
 
+        // Returns the symbol with the specified identifer which is in the deepest scope, or null if there is no such symbol.
+        SymbolType Fetch(const std::string& ident) const
+        {
+            /* Skip interning if there are no symbols (e.g. for type names of a parser) */
+            if (records_.empty())
+                return GenericDefaultValue<SymbolType>::Get();
+            return Fetch(AtomTable::InternActive(ident));
+        }
+
         // Returns the symbol with the specified identifer which is in the current scope, or null if there is no such symbol.
-        SymbolType FetchFromCurrentScope(const std::string& ident) const
+        SymbolType FetchFromCurrentScope(Atom ident) const
         {
-            auto it = symTable_.find(ident);
-            if (it != symTable_.end() && !it->second.empty())
+            if (auto record = FindTopRecord(ident))
             {
-                const auto& sym = it->second.top();
-                if (sym.scopeLevel == ScopeLevel())
-                    return sym.symbol;
+                if (record->scopeLevel == ScopeLevel())
+                    return record->symbol;
             }
             return GenericDefaultValue<SymbolType>::Get();
         }
 
-        // Returns the first symbol in the scope hierarchy for which the search predicate returns true.
+        // Returns the symbol with the specified identifer which is in the current scope, or null if there is no such symbol.
+        SymbolType FetchFromCurrentScope(const std::string& ident) const
+        {
+            if (records_.empty())
+                return GenericDefaultValue<SymbolType>::Get();
+            return FetchFromCurrentScope(AtomTable::InternActive(ident));
+        }
+
+        /*
+        Returns the first visible symbol (in the order of registration) for which the search predicate returns true.
+        This is a linear search over all visible symbols, since the predicate does not refer to an identifier (e.g. to find a structure with compatible members),
+        so identifiers must be looked up with the "Fetch" functions instead.
+        */
         SymbolType Find(const SearchPredicateProc& searchPredicate) const
         {
             if (searchPredicate)
             {
-                /* Search symbol in identifiable symbol ist */
-                for (const auto& sym : symTable_)
+                /* Search symbol in identifiable symbol list (only symbols that are not shadowed by a deeper scope) */
+                for (std::size_t i = 0; i < records_.size(); ++i)
                 {
-                    if (!sym.second.empty())
-                    {
-                        const auto& symRef = sym.second.top().symbol;
-                        if (searchPredicate(symRef))
-                            return symRef;
-                    }
+                    const auto& record = records_[i];
+                    if (entries_[record.entry].top == i + 1 && searchPredicate(record.symbol))
+                        return record.symbol;
                 }
 
                 /* Search symbol in anonymous symbol list */
-                if (!symTableAnonymous_.empty())
+                for (auto it = anonymousRecords_.rbegin(); it != anonymousRecords_.rend(); ++it)
                 {
-                    for (auto scope = symTableAnonymous_.rbegin(); scope != symTableAnonymous_.rend(); ++scope)
-                    {
-                        for (const auto& sym : *scope)
-                        {
-                            if (searchPredicate(sym.symbol))
-                                return sym.symbol;
-                        }
-                    }
+                    if (searchPredicate(it->symbol))
+                        return it->symbol;
                 }
             }
             return GenericDefaultValue<SymbolType>::Get();
         }
 
-        // Returns an identifier that is similar to the specified identifier (for suggestions of typos)
+        /*
+        Returns an identifier that is similar to the specified identifier (for suggestions of typos).
+        This is expensive as it compares all visible identifiers, so it should only be called when an error is actually reported.
+        */
         std::string FetchSimilar(const std::string& ident) const
         {
-            /* Find similar identifiers */
+            /* Find similar identifiers (on equal distance, the lexicographically smaller identifier is taken) */
             const std::string* similar = nullptr;
             unsigned int dist = ~0;
 
-            for (const auto& symbol : symTable_)
+            for (const auto& entry : entries_)
             {
-                auto d = StringDistance(ident, symbol.first);
-                if (d < dist)
+                if (entry.top != 0)
                 {
-                    similar = (&symbol.first);
-                    dist = d;
+                    auto d = StringDistance(ident, *entry.ident);
+                    if (d < dist || (d == dist && similar != nullptr && *entry.ident < *similar))
+                    {
+                        similar = entry.ident;
+                        dist = d;
+                    }
                 }
             }
 
@@ -242,7 +266,7 @@ class SymbolTable
         // Returns current scope level.
         std::size_t ScopeLevel() const
         {
-            return scopeStack_.size();
+            return scopes_.size();
         }
 
         // Returns true if the symbol table is currently inside the global scope (i.e. scope level = 1).
@@ -253,23 +277,102 @@ class SymbolTable
 
     private:
 
-        struct Symbol
+        // Symbol record in the undo log.
+        struct Record
         {
             SymbolType  symbol;
             std::size_t scopeLevel;
+            std::size_t prev;       // One-based index of the record this record shadows (0 for none)
+            std::size_t entry;      // Index of the identifier entry
         };
 
-        // Stores the scope stack for all identifiable symbols.
-        std::map<std::string, std::stack<Symbol>>   symTable_;
+        // Identifier entry in the hash map.
+        struct Entry
+        {
+            Atom        ident;
+            std::size_t top;    // One-based index of the visible record for this identifier (0 for none)
+        };
 
-        // Stores the scope stack for all anonymous symbols.
-        std::vector<std::vector<Symbol>>            symTableAnonymous_;
+        // Scope with the positions of the undo logs when the scope was opened.
+        struct Scope
+        {
+            std::size_t recordsBegin;
+            std::size_t anonymousRecordsBegin;
+        };
 
-        /*
-        Stores all identifiers for the current stack.
-        All these identifiers will be removed from "symTable_" when a scope will be closed.
-        */
-        std::stack<std::vector<std::string>>        scopeStack_;
+        // Returns the one-based index of the entry with the specified identifier in the slot list, or 0 if there is no such entry.
+        std::size_t FindEntry(Atom ident, std::size_t& slot) const
+        {
+            const auto mask = slots_.size() - 1;
+
+            for (slot = (HashPointer(ident) & mask); slots_[slot] != 0; slot = ((slot + 1) & mask))
+            {
+                if (entries_[slots_[slot] - 1].ident == ident)
+                    return slots_[slot];
+            }
+
+            return 0;
+        }
+
+        // Returns the index of the entry with the specified identifier, and inserts a new entry if there is no such entry.
+        std::size_t FindOrInsertEntry(Atom ident)
+        {
+            std::size_t slot = 0;
+            if (auto entryIndex = FindEntry(ident, slot))
+                return entryIndex - 1;
+
+            /* Insert new entry, and keep the load factor below 1/2 */
+            entries_.push_back({ ident, 0 });
+            slots_[slot] = entries_.size();
+
+            if (entries_.size() * 2 > slots_.size())
+                Rehash(slots_.size() * 2);
+
+            return entries_.size() - 1;
+        }
+
+        // Returns the visible record for the specified identifier, or null if there is no such record.
+        const Record* FindTopRecord(Atom ident) const
+        {
+            std::size_t slot = 0;
+            if (auto entryIndex = FindEntry(ident, slot))
+            {
+                const auto top = entries_[entryIndex - 1].top;
+                if (top != 0)
+                    return &(records_[top - 1]);
+            }
+            return nullptr;
+        }
+
+        // Resizes the slot list and re-inserts all entries.
+        void Rehash(std::size_t numSlots)
+        {
+            slots_.assign(numSlots, 0);
+            const auto mask = numSlots - 1;
+
+            for (std::size_t i = 0; i < entries_.size(); ++i)
+            {
+                auto slot = (HashPointer(entries_[i].ident) & mask);
+                while (slots_[slot] != 0)
+                    slot = ((slot + 1) & mask);
+                slots_[slot] = i + 1;
+            }
+        }
+
+        // Stores all identifiers that have ever been registered. Entries are never removed.
+        std::vector<Entry>          entries_;
+
+        // Open addressing hash map with linear probing. Each slot stores the one-based index into "entries_" (0 for free slots).
+        std::vector<std::size_t>    slots_;
+
+        // Undo log of all identifiable symbols of all open scopes.
+        std::vector<Record>         records_;
+
+        // Stores all anonymous symbols of all open scopes.
+        std::vector<Record>         anonymousRecords_;
+
+        // Stores the undo log positions of all open scopes.
+        std::vector<Scope>          scopes_;
 
 };
 
@@ -310,6 +413,7 @@ class ASTSymbolOverload
 
         std::string         ident_;
         std::vector<AST*>   refs_;
+        std::uint64_t       resolutionKey_  = 0; // Key of this overload set in the active resolution cache (see ResolutionCache)
 
 };
 
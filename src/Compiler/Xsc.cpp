@@ -19,6 +19,57 @@ namespace Xsc
 {
 
 
+// Prints the durations of all compiler stages.
+static void PrintTimings(Log& log, const Compiler::StageTimePoints& timePoints)
+{
+    using TimePoint = Compiler::TimePoint;
+
+    auto PrintTiming = [&log](const std::string& processName, const TimePoint startTime, const TimePoint endTime)
+    {
+        long long duration = 0ll;
+
+        if (endTime > startTime)
+        {
+            duration =
+            (
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::duration<float>(endTime - startTime)
+                ).count()
+            );
+        }
+
+        log.SubmitReport(
+            Report(
+                ReportTypes::Info,
+                "timing " + processName + std::to_string(duration) + " ms"
+            )
+        );
+    };
+
+    PrintTiming( "pre-processing:   ", timePoints.preprocessor, timePoints.parser     );
+    PrintTiming( "parsing:          ", timePoints.parser,       timePoints.analyzer   );
+    PrintTiming( "context analysis: ", timePoints.analyzer,     timePoints.optimizer  );
+    PrintTiming( "optimization:     ", timePoints.optimizer,    timePoints.generation );
+    PrintTiming( "code generation:  ", timePoints.generation,   timePoints.reflection );
+}
+
+// Prints the hits and misses of the overload resolution cache.
+static void PrintResolutionStats(Log& log, const ResolutionCache::Statistics& resolutionStats)
+{
+    auto PrintCacheStats = [&log](const std::string& cacheName, std::size_t hits, std::size_t misses)
+    {
+        log.SubmitReport(
+            Report(
+                ReportTypes::Info,
+                "cache " + cacheName + std::to_string(hits) + " hits, " + std::to_string(misses) + " misses"
+            )
+        );
+    };
+
+    PrintCacheStats( "function overloads:  ", resolutionStats.functionHits,  resolutionStats.functionMisses  );
+    PrintCacheStats( "intrinsic overloads: ", resolutionStats.intrinsicHits, resolutionStats.intrinsicMisses );
+}
+
 XSC_EXPORT bool CompileShader(
     const ShaderInput&          inputDesc,
     const ShaderOutput&         outputDesc,
@@ -27,6 +78,7 @@ XSC_EXPORT bool CompileShader(
 {
     /* Compile shader with compiler driver */
     Compiler::StageTimePoints timePoints;
+    ResolutionCache::Statistics resolutionStats;
 
     Compiler compiler(log);
 
@@ -34,41 +86,57 @@ XSC_EXPORT bool CompileShader(
         inputDesc,
         outputDesc,
         reflectionData,
-        &timePoints
+        &timePoints,
+        &resolutionStats
     );
 
-    /* Show timings */
+    /* Show timings and statistics */
     if (outputDesc.options.showTimes && log)
     {
-        using TimePoint = Compiler::TimePoint;
+        PrintTimings(*log, timePoints);
+        PrintResolutionStats(*log, resolutionStats);
+    }
 
-        auto PrintTiming = [log](const std::string& processName, const TimePoint startTime, const TimePoint endTime)
-        {
-            long long duration = 0ll;
+    return result;
+}
+
+XSC_EXPORT bool CompileShaders(
+    const ShaderInput&                      inputDesc,
+    const std::vector<ShaderEntryPoint>&    entryPoints,
+    Log*                                    log,
+    std::vector<bool>*                      entryPointResults)
+{
+    /* Compile all entry points with compiler driver */
+    std::vector<Compiler::StageTimePoints> timePoints;
+    ResolutionCache::Statistics resolutionStats;
 
-            if (endTime > startTime)
+    Compiler compiler(log);
+
+    auto result = compiler.CompileShaders(
+        inputDesc,
+        entryPoints,
+        entryPointResults,
+        &timePoints,
+        &resolutionStats
+    );
+
+    /* Show timings of each entry point, and the statistics of all entry points */
+    if (log)
+    {
+        bool showTimes = false;
+
+        for (std::size_t i = 0; i < entryPoints.size(); ++i)
+        {
+            if (entryPoints[i].outputDesc.options.showTimes)
             {
-                duration =
-                (
-                    std::chrono::duration_cast<std::chrono::milliseconds>(
-                        std::chrono::duration<float>(endTime - startTime)
-                    ).count()
-                );
+                log->SubmitReport(Report(ReportTypes::Info, "timing entry point \"" + entryPoints[i].entryPoint + "\":"));
+                PrintTimings(*log, timePoints[i]);
+                showTimes = true;
             }
+        }
 
-            log->SubmitReport(
-                Report(
-                    ReportTypes::Info,
-                    "timing " + processName + std::to_string(duration) + " ms"
-                )
-            );
-        };
-
-        PrintTiming( "pre-processing:   ", timePoints.preprocessor, timePoints.parser     );
-        PrintTiming( "parsing:          ", timePoints.parser,       timePoints.analyzer   );
-        PrintTiming( "context analysis: ", timePoints.analyzer,     timePoints.optimizer  );
-        PrintTiming( "optimization:     ", timePoints.optimizer,    timePoints.generation );
-        PrintTiming( "code generation:  ", timePoints.generation,   timePoints.reflection );
+        if (showTimes)
+            PrintResolutionStats(*log, resolutionStats);
     }
 
     return result;
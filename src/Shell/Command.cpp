@@ -83,6 +83,18 @@ HelpDescriptor EntryCommand::Help() const
 void EntryCommand::Run(CommandLine& cmdLine, ShellState& state)
 {
     state.inputDesc.entryPoint = cmdLine.Accept();
+
+    /*
+    Complete the entry point with the active shader target (e.g. "-T vert -E VS1 -E VS2"),
+    or leave its target open for the next one, if no target has been specified before (e.g. "-E VS -T vert")
+    */
+    state.entryPoints.push_back(
+        {
+            (state.targetSpecified ? state.inputDesc.shaderTarget : ShaderTarget::Undefined),
+            state.inputDesc.entryPoint,
+            state.inputDesc.secondaryEntryPoint
+        }
+    );
 }
 
 
@@ -108,6 +120,10 @@ HelpDescriptor SecndEntryCommand::Help() const
 void SecndEntryCommand::Run(CommandLine& cmdLine, ShellState& state)
 {
     state.inputDesc.secondaryEntryPoint = cmdLine.Accept();
+
+    /* Secondary entry point belongs to the previous entry point (if there is one) */
+    if (!state.entryPoints.empty())
+        state.entryPoints.back().secondaryEntryPoint = state.inputDesc.secondaryEntryPoint;
 }
 
 
@@ -146,6 +162,21 @@ void TargetCommand::Run(CommandLine& cmdLine, ShellState& state)
         },
         R_InvalidShaderTarget(target)
     );
+
+    /*
+    Apply shader target to the previous entry points without target (e.g. "-E VS -T vert -E PS -T frag"),
+    or to all following entry points otherwise (e.g. "-T vert -E VS1 -E VS2 -T frag -E PS")
+    */
+    state.targetSpecified = true;
+
+    for (auto& entryPoint : state.entryPoints)
+    {
+        if (entryPoint.shaderTarget == ShaderTarget::Undefined)
+        {
+            entryPoint.shaderTarget = state.inputDesc.shaderTarget;
+            state.targetSpecified   = false;
+        }
+    }
 }
 
 
@@ -442,6 +473,79 @@ void PPOnlyCommand::Run(CommandLine& cmdLine, ShellState& state)
 }
 
 
+/*
+ * DepsOnlyCommand class
+ */
+
+std::vector<Command::Identifier> DepsOnlyCommand::Idents() const
+{
+    return { { "-M" }, { "--deps-only" } };
+}
+
+HelpDescriptor DepsOnlyCommand::Help() const
+{
+    return
+    {
+        "-M, --deps-only [" + CommandLine::GetBooleanOption() + "]",
+        R_CmdHelpDepsOnly(CommandLine::GetBooleanFalse())
+    };
+}
+
+void DepsOnlyCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    state.outputDesc.options.scanDependenciesOnly = cmdLine.AcceptBoolean(true);
+}
+
+
+/*
+ * DepFileCommand class
+ */
+
+std::vector<Command::Identifier> DepFileCommand::Idents() const
+{
+    return { { "-MD" }, { "--dep-file" } };
+}
+
+HelpDescriptor DepFileCommand::Help() const
+{
+    return
+    {
+        "-MD, --dep-file [" + CommandLine::GetBooleanOption() + "]",
+        R_CmdHelpDepFile(CommandLine::GetBooleanFalse())
+    };
+}
+
+void DepFileCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    state.writeDepFile = cmdLine.AcceptBoolean(true);
+}
+
+
+/*
+ * DepFilenameCommand class
+ */
+
+std::vector<Command::Identifier> DepFilenameCommand::Idents() const
+{
+    return { { "-MF" } };
+}
+
+HelpDescriptor DepFilenameCommand::Help() const
+{
+    return
+    {
+        "-MF FILE",
+        R_CmdHelpDepFilename
+    };
+}
+
+void DepFilenameCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    state.depFilename   = cmdLine.Accept();
+    state.writeDepFile  = true;
+}
+
+
 /*
  * MacroCommand class
  */
@@ -475,7 +579,7 @@ void MacroCommand::Run(CommandLine& cmdLine, ShellState& state)
     else
         macro.ident = arg;
 
-    state.predefinedMacros.push_back(macro);
+    state.inputDesc.defines.push_back(macro);
 }
 
 
@@ -967,6 +1071,30 @@ void OptimizeCommand::Run(CommandLine& cmdLine, ShellState& state)
 }
 
 
+/*
+ * ReachableOnlyCommand class
+ */
+
+std::vector<Command::Identifier> ReachableOnlyCommand::Idents() const
+{
+    return { { "--reachable-only" } };
+}
+
+HelpDescriptor ReachableOnlyCommand::Help() const
+{
+    return
+    {
+        "--reachable-only [" + CommandLine::GetBooleanOption() + "]",
+        R_CmdHelpReachableOnly(CommandLine::GetBooleanFalse())
+    };
+}
+
+void ReachableOnlyCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    state.outputDesc.options.analyzeReachableOnly = cmdLine.AcceptBoolean(true);
+}
+
+
 /*
  * ExtensionCommand class
  */
@@ -1415,6 +1543,54 @@ void SeparateSamplersCommand::Run(CommandLine& cmdLine, ShellState& state)
 }
 
 
+/*
+ * TokenStreamCommand class
+ */
+
+std::vector<Command::Identifier> TokenStreamCommand::Idents() const
+{
+    return { { "--token-stream" } };
+}
+
+HelpDescriptor TokenStreamCommand::Help() const
+{
+    return
+    {
+        "--token-stream [" + CommandLine::GetBooleanOption() + "]",
+        R_CmdHelpTokenStream(CommandLine::GetBooleanFalse())
+    };
+}
+
+void TokenStreamCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    state.outputDesc.options.passTokenStream = cmdLine.AcceptBoolean(true);
+}
+
+
+/*
+ * SnapshotCheckCommand class
+ */
+
+std::vector<Command::Identifier> SnapshotCheckCommand::Idents() const
+{
+    return { { "--snapshot-check" } };
+}
+
+HelpDescriptor SnapshotCheckCommand::Help() const
+{
+    return
+    {
+        "--snapshot-check [" + CommandLine::GetBooleanOption() + "]",
+        R_CmdHelpSnapshotCheck(CommandLine::GetBooleanFalse())
+    };
+}
+
+void SnapshotCheckCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    state.checkSnapshots = cmdLine.AcceptBoolean(true);
+}
+
+
 /*
  * DisassembleCommand class
  */
@@ -80,6 +80,9 @@ DECL_SHELL_COMMAND( ShowASTCommand               );
 DECL_SHELL_COMMAND( ShowTimesCommand             );
 DECL_SHELL_COMMAND( ReflectCommand               );
 DECL_SHELL_COMMAND( PPOnlyCommand                );
+DECL_SHELL_COMMAND( DepsOnlyCommand              );
+DECL_SHELL_COMMAND( DepFileCommand               );
+DECL_SHELL_COMMAND( DepFilenameCommand           );
 DECL_SHELL_COMMAND( MacroCommand                 );
 DECL_SHELL_COMMAND( SemanticCommand              );
 DECL_SHELL_COMMAND( PackUniformsCommand          );
@@ -90,6 +93,7 @@ DECL_SHELL_COMMAND( HelpCommand                  );
 DECL_SHELL_COMMAND( VerboseCommand               );
 DECL_SHELL_COMMAND( ColorCommand                 );
 DECL_SHELL_COMMAND( OptimizeCommand              );
+DECL_SHELL_COMMAND( ReachableOnlyCommand         );
 DECL_SHELL_COMMAND( ExtensionCommand             );
 DECL_SHELL_COMMAND( EnumExtensionCommand         );
 DECL_SHELL_COMMAND( ValidateCommand              );
@@ -107,6 +111,8 @@ DECL_SHELL_COMMAND( PrefixCommand                );
 DECL_SHELL_COMMAND( NameManglingCommand          );
 DECL_SHELL_COMMAND( SeparateShadersCommand       );
 DECL_SHELL_COMMAND( SeparateSamplersCommand      );
+DECL_SHELL_COMMAND( TokenStreamCommand           );
+DECL_SHELL_COMMAND( SnapshotCheckCommand         );
 DECL_SHELL_COMMAND( DisassembleCommand           );
 DECL_SHELL_COMMAND( DisassembleExtCommand        );
 
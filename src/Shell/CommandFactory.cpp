@@ -67,6 +67,9 @@ CommandFactory::CommandFactory()
         ShowTimesCommand,
         ReflectCommand,
         PPOnlyCommand,
+        DepsOnlyCommand,
+        DepFileCommand,
+        DepFilenameCommand,
         MacroCommand,
         SemanticCommand,
         PackUniformsCommand,
@@ -77,6 +80,7 @@ CommandFactory::CommandFactory()
         VerboseCommand,
         ColorCommand,
         OptimizeCommand,
+        ReachableOnlyCommand,
         ExtensionCommand,
         EnumExtensionCommand,
         ValidateCommand,
@@ -94,6 +98,8 @@ CommandFactory::CommandFactory()
         NameManglingCommand,
         SeparateShadersCommand,
         SeparateSamplersCommand,
+        TokenStreamCommand,
+        SnapshotCheckCommand,
         DisassembleCommand,
         DisassembleExtCommand
     >();
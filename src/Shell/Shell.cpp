@@ -120,9 +120,12 @@ bool Shell::ExecuteCommandLine(CommandLine& cmdLine, bool enableBriefHelp)
                 else
                     state_.compileStatus.numFailed++;
 
-                /* Reset output filename and entry point */
+                /* Reset output filename, dependency filename, and entry points */
                 state_.outputFilename.clear();
+                state_.depFilename.clear();
                 state_.inputDesc.entryPoint.clear();
+                state_.entryPoints.clear();
+                state_.targetSpecified = false;
                 state_.actionPerformed = true;
             }
         }
@@ -206,9 +209,46 @@ static std::string TargetToExtension(const ShaderTarget shaderTarget)
     return "glsl";
 }
 
-std::string Shell::GetDefaultOutputFilename(const std::string& filename) const
+std::string Shell::GetDefaultOutputFilename(const std::string& filename, const ShellEntryPoint& entryPoint) const
 {
-    return (GetFilePart(filename) + "." + state_.inputDesc.entryPoint + "." + TargetToExtension(state_.inputDesc.shaderTarget));
+    return (GetFilePart(filename) + "." + entryPoint.entryPoint + "." + TargetToExtension(entryPoint.shaderTarget));
+}
+
+// Returns the specified path with all special characters escaped for a rule in a makefile.
+static std::string EscapeMakePath(const std::string& path)
+{
+    std::string s;
+    s.reserve(path.size());
+
+    for (auto chr : path)
+    {
+        if (chr == ' ' || chr == '#')
+            s += '\\';
+        else if (chr == '$')
+            s += '$';
+        s += chr;
+    }
+
+    return s;
+}
+
+// Writes a make-style dependency file (like the "-MD" option of GCC), which is understood by make and ninja.
+static void WriteDepFile(
+    const std::string& depFilename, const std::vector<std::string>& targets, const std::string& source, const std::vector<std::string>& dependencies)
+{
+    std::ofstream depFile(depFilename);
+    if (!depFile.good())
+        throw std::runtime_error(R_FailedToWriteFile(depFilename));
+
+    for (const auto& target : targets)
+        depFile << EscapeMakePath(target) << ' ';
+
+    depFile << ": " << EscapeMakePath(source);
+
+    for (const auto& path : dependencies)
+        depFile << " \\\n  " << EscapeMakePath(path);
+
+    depFile << std::endl;
 }
 
 bool Shell::Compile(const std::string& filename)
@@ -217,46 +257,60 @@ bool Shell::Compile(const std::string& filename)
 
     lastOutputFilename_.clear();
 
-    const auto  defaultOutputFilename   = GetDefaultOutputFilename(filename);
-    auto        outputFilename          = state_.outputFilename;
+    /* Gather all entry points (entry points without a target get the last specified one) */
+    auto entryPoints = state_.entryPoints;
 
-    if (outputFilename.empty())
-        outputFilename = defaultOutputFilename;
-    else
-        Replace(outputFilename, "*", defaultOutputFilename);
+    if (entryPoints.empty())
+        entryPoints.push_back({ state_.inputDesc.shaderTarget, state_.inputDesc.entryPoint, state_.inputDesc.secondaryEntryPoint });
 
-    try
+    for (auto& entryPoint : entryPoints)
     {
-        /* Add pre-defined macros at the top of the input stream */
-        auto inputStream = std::make_shared<std::stringstream>();
+        if (entryPoint.shaderTarget == ShaderTarget::Undefined)
+            entryPoint.shaderTarget = state_.inputDesc.shaderTarget;
+    }
 
-        for (const auto& macro : state_.predefinedMacros)
-        {
-            *inputStream << "#define " << macro.ident;
-            if (!macro.value.empty())
-                *inputStream << ' ' << macro.value;
-            *inputStream << std::endl;
-        }
+    const auto numEntryPoints = entryPoints.size();
+
+    std::vector<std::string> outputFilenames(numEntryPoints);
+
+    for (std::size_t i = 0; i < numEntryPoints; ++i)
+    {
+        const auto defaultOutputFilename = GetDefaultOutputFilename(filename, entryPoints[i]);
+
+        outputFilenames[i] = state_.outputFilename;
+
+        if (outputFilenames[i].empty())
+            outputFilenames[i] = defaultOutputFilename;
+        else
+            Replace(outputFilenames[i], "*", defaultOutputFilename);
+    }
+
+    try
+    {
+        /* Multiple entry points can only be written to distinct output files */
+        if (numEntryPoints > 1 && !state_.outputFilename.empty() && state_.outputFilename.find('*') == std::string::npos)
+            throw std::invalid_argument(R_OutputFilenameNeedsWildcard(state_.outputFilename));
 
-        /* Open input stream */
+        /* Read input file into source buffer (pre-defined macros are passed with 'inputDesc.defines') */
         state_.inputDesc.filename = filename;
 
         std::ifstream inputFile(filename);
         if (!inputFile.good())
             throw std::runtime_error(R_FailedToReadFile(filename));
 
-        *inputStream << inputFile.rdbuf();
+        std::string inputSource { std::istreambuf_iterator<char>(inputFile), std::istreambuf_iterator<char>() };
 
-        std::stringstream outputStream;
+        std::vector<std::stringstream> outputStreams(numEntryPoints);
 
-        /* Initialize input and output descriptors */
-        state_.inputDesc.sourceCode  = inputStream;
-        state_.outputDesc.sourceCode = &outputStream;
+        /* Initialize input and output descriptors (the input buffer is passed without copying) */
+        state_.inputDesc.sourceCodeBuffer       = inputSource.data();
+        state_.inputDesc.sourceCodeBufferSize   = inputSource.size();
+        state_.outputDesc.sourceCode            = &outputStreams.front();
 
         /* Final setup before compilation */
-        StdLog                      log;
-        IncludeHandler              includeHandler;
-        Reflection::ReflectionData  reflectionData;
+        StdLog                                  log;
+        IncludeHandler                          includeHandler;
+        std::vector<Reflection::ReflectionData> reflectionData(numEntryPoints);
 
         includeHandler.GetSearchPaths() = state_.searchPaths;
         state_.inputDesc.includeHandler = &includeHandler;
@@ -266,62 +320,134 @@ bool Shell::Compile(const std::string& filename)
         if (!inputPath.empty())
             includeHandler.GetSearchPaths().push_back(inputPath);
 
+        /* A dependency scan always writes a dependency file, but no output file */
+        const bool scanDepsOnly = state_.outputDesc.options.scanDependenciesOnly;
+        const bool writeDepFile = (state_.writeDepFile || scanDepsOnly);
+
         /* Show compilation/validation status */
         if (state_.verbose)
         {
-            if (state_.outputDesc.options.validateOnly)
-                output << R_ValidateShader(filename) << std::endl;
-            else
-                output << R_CompileShader(filename, outputFilename) << std::endl;
+            for (const auto& outputFilename : outputFilenames)
+            {
+                if (scanDepsOnly)
+                    output << R_ScanDependencies(filename) << std::endl;
+                else if (state_.outputDesc.options.validateOnly)
+                    output << R_ValidateShader(filename) << std::endl;
+                else
+                    output << R_CompileShader(filename, outputFilename) << std::endl;
+            }
+        }
+
+        std::vector<bool> entryPointResults;
+
+        if (numEntryPoints == 1)
+        {
+            /* Compile shader file with the target of its only entry point */
+            auto inputDesc = state_.inputDesc;
+            {
+                inputDesc.shaderTarget          = entryPoints.front().shaderTarget;
+                inputDesc.entryPoint            = entryPoints.front().entryPoint;
+                inputDesc.secondaryEntryPoint   = entryPoints.front().secondaryEntryPoint;
+            }
+
+            succeeded = CompileShader(
+                inputDesc,
+                state_.outputDesc,
+                &log,
+                (state_.showReflection || writeDepFile ? &reflectionData.front() : nullptr)
+            );
+
+            if (succeeded && state_.checkSnapshots)
+                succeeded = CheckSnapshots(inputDesc);
+
+            entryPointResults = { succeeded };
+        }
+        else
+        {
+            /* Compile all entry points of the shader file, which is pre-processed only once */
+            std::vector<ShaderEntryPoint> shaderEntryPoints(numEntryPoints);
+
+            for (std::size_t i = 0; i < numEntryPoints; ++i)
+            {
+                auto& shaderEntryPoint = shaderEntryPoints[i];
+
+                shaderEntryPoint.shaderTarget           = entryPoints[i].shaderTarget;
+                shaderEntryPoint.entryPoint             = entryPoints[i].entryPoint;
+                shaderEntryPoint.secondaryEntryPoint    = entryPoints[i].secondaryEntryPoint;
+                shaderEntryPoint.outputDesc             = state_.outputDesc;
+                shaderEntryPoint.outputDesc.filename    = outputFilenames[i];
+                shaderEntryPoint.outputDesc.sourceCode  = &outputStreams[i];
+                shaderEntryPoint.reflectionData         = (state_.showReflection || writeDepFile ? &reflectionData[i] : nullptr);
+            }
+
+            succeeded = CompileShaders(state_.inputDesc, shaderEntryPoints, &log, &entryPointResults);
         }
 
-        /* Compile shader file */
-        succeeded = CompileShader(
-            state_.inputDesc,
-            state_.outputDesc,
-            &log,
-            (state_.showReflection ? &reflectionData : nullptr)
-        );
+        /* Reset input buffer and output stream, which are only valid during this compilation */
+        state_.inputDesc.sourceCodeBuffer       = nullptr;
+        state_.inputDesc.sourceCodeBufferSize   = 0;
+        state_.outputDesc.sourceCode            = nullptr;
 
         /* Print all reports to the log output */
         log.PrintAll(state_.verbose);
 
-        if (succeeded)
+        for (std::size_t i = 0; i < numEntryPoints; ++i)
         {
-            ScopedColor color { ColorFlags::Green | ColorFlags::Intens };
+            const auto& outputFilename = outputFilenames[i];
 
-            if (!state_.outputDesc.options.validateOnly)
+            if (entryPointResults[i])
             {
-                if (state_.verbose)
-                    output << R_CompilationSuccessful() << std::endl;
+                ScopedColor color { ColorFlags::Green | ColorFlags::Intens };
 
-                /* Write result to output stream only on success */
-                std::ofstream outputFile(outputFilename);
-                if (outputFile.good())
-                    outputFile << outputStream.rdbuf();
-                else
-                    throw std::runtime_error(R_FailedToWriteFile(outputFilename));
+                if (scanDepsOnly)
+                {
+                    if (state_.verbose)
+                        output << R_DependencyScanSuccessful() << std::endl;
+                }
+                else if (!state_.outputDesc.options.validateOnly)
+                {
+                    if (state_.verbose)
+                        output << R_CompilationSuccessful() << std::endl;
 
-                /* Store output filename after successful compilation */
-                lastOutputFilename_ = outputFilename;
-            }
-            else if (state_.verbose)
-                output << R_ValidationSuccessful() << std::endl;
-        }
-        else
-        {
-            ScopedColor color { ColorFlags::Red | ColorFlags::Intens };
+                    /* Write result to output stream only on success */
+                    std::ofstream outputFile(outputFilename);
+                    if (outputFile.good())
+                        outputFile << outputStreams[i].rdbuf();
+                    else
+                        throw std::runtime_error(R_FailedToWriteFile(outputFilename));
 
-            /* Always print message on failure */
-            if (state_.outputDesc.options.validateOnly)
-                output << R_ValidationFailed() << std::endl;
+                    /* Store output filename after successful compilation */
+                    lastOutputFilename_ = outputFilename;
+                }
+                else if (state_.verbose)
+                    output << R_ValidationSuccessful() << std::endl;
+            }
             else
-                output << R_CompilationFailed() << std::endl;
+            {
+                ScopedColor color { ColorFlags::Red | ColorFlags::Intens };
+
+                /* Always print message on failure */
+                if (scanDepsOnly)
+                    output << R_DependencyScanFailed() << std::endl;
+                else if (state_.outputDesc.options.validateOnly)
+                    output << R_ValidationFailed() << std::endl;
+                else
+                    output << R_CompilationFailed() << std::endl;
+            }
+
+            /* Show output statistics (if enabled) */
+            if (state_.showReflection)
+                PrintReflection(output, reflectionData[i], !state_.showReflectionExt);
         }
 
-        /* Show output statistics (if enabled) */
-        if (state_.showReflection)
-            PrintReflection(output, reflectionData, !state_.showReflectionExt);
+        /* Write dependency file with all output files as targets */
+        if (succeeded && writeDepFile)
+        {
+            auto depFilename = state_.depFilename;
+            if (depFilename.empty())
+                depFilename = outputFilenames.front() + ".d";
+            WriteDepFile(depFilename, outputFilenames, filename, reflectionData.front().dependencies);
+        }
     }
     catch (const std::exception& err)
     {
@@ -332,6 +458,88 @@ bool Shell::Compile(const std::string& filename)
     return succeeded;
 }
 
+bool Shell::CheckSnapshots(const ShaderInput& inputDesc)
+{
+    /* Compile reference output without generator header (which contains the time of compilation) */
+    auto outputDesc = state_.outputDesc;
+    outputDesc.options.writeGeneratorHeader = false;
+
+    std::stringstream referenceOutput;
+    outputDesc.sourceCode = &referenceOutput;
+
+    if (!CompileShader(inputDesc, outputDesc))
+        return false;
+
+    auto CompareOutput = [&](const std::string& snapshotName, const ShaderInput& snapshotInputDesc) -> bool
+    {
+        std::stringstream snapshotOutput;
+        outputDesc.sourceCode = &snapshotOutput;
+
+        if (!CompileShader(snapshotInputDesc, outputDesc))
+        {
+            output << R_SnapshotCheckFailed(snapshotName) << std::endl;
+            return false;
+        }
+
+        /* Ignore trailing white spaces (the empty shader after a prelude adds a new-line in pre-process-only mode) */
+        auto TrimRight = [](std::string s) -> std::string
+        {
+            s.erase(s.find_last_not_of(" \t\r\n") + 1);
+            return s;
+        };
+
+        if (TrimRight(snapshotOutput.str()) != TrimRight(referenceOutput.str()))
+        {
+            output << R_SnapshotCheckMismatch(snapshotName) << std::endl;
+            return false;
+        }
+
+        return true;
+    };
+
+    /* Pre-process the entire input as prelude of an empty shader (the prelude output is the output of the pre-processor snapshot) */
+    {
+        PreProcessorSnapshot snapshot, loadedSnapshot;
+        std::stringstream snapshotStream;
+
+        if (!snapshot.Create(inputDesc) || !snapshot.Save(snapshotStream) || !loadedSnapshot.Load(snapshotStream, inputDesc))
+        {
+            output << R_SnapshotCheckFailed("pre-processor") << std::endl;
+            return false;
+        }
+
+        auto snapshotInputDesc = inputDesc;
+        {
+            snapshotInputDesc.sourceCodeBuffer      = "";
+            snapshotInputDesc.sourceCodeBufferSize  = 0;
+            snapshotInputDesc.preProcessorSnapshot  = &loadedSnapshot;
+        }
+
+        if (!CompareOutput("pre-processor", snapshotInputDesc))
+            return false;
+    }
+
+    /* Analyze the input once, and generate the output from the re-loaded program snapshot */
+    {
+        ProgramSnapshot snapshot, loadedSnapshot;
+        std::stringstream snapshotStream;
+
+        if (!snapshot.Create(inputDesc, outputDesc) || !snapshot.Save(snapshotStream) || !loadedSnapshot.Load(snapshotStream, inputDesc, outputDesc))
+        {
+            output << R_SnapshotCheckFailed("program") << std::endl;
+            return false;
+        }
+
+        auto snapshotInputDesc = inputDesc;
+        snapshotInputDesc.programSnapshot = &loadedSnapshot;
+
+        if (!CompareOutput("program", snapshotInputDesc))
+            return false;
+    }
+
+    return true;
+}
+
 
 } // /namespace Util
 
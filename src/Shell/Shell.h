@@ -59,10 +59,13 @@ class Shell
 
     private:
 
-        std::string GetDefaultOutputFilename(const std::string& filename) const;
+        std::string GetDefaultOutputFilename(const std::string& filename, const ShellEntryPoint& entryPoint) const;
 
         bool Compile(const std::string& filename);
 
+        // Compiles the specified input again through a saved and re-loaded pre-processor and program snapshot, and returns true if all outputs are equal.
+        bool CheckSnapshots(const ShaderInput& inputDesc);
+
         ShellState              state_;
         std::stack<ShellState>  stateStack_;
 
@@ -28,13 +28,12 @@ struct CompileStatus
     std::size_t numFailed       = 0;
 };
 
-struct PredefinedMacro
+// Shader entry point with its target, which is compiled together with other entry points of the same file.
+struct ShellEntryPoint
 {
-    // Macro identifier
-    std::string ident;
-
-    // Optional macro body
-    std::string value;
+    ShaderTarget    shaderTarget    = ShaderTarget::Undefined;
+    std::string     entryPoint;
+    std::string     secondaryEntryPoint;
 };
 
 struct ShellState
@@ -48,8 +47,14 @@ struct ShellState
     // Output filename (hint).
     std::string                     outputFilename;
 
-    // Predefined macros for the preprocessor
-    std::vector<PredefinedMacro>    predefinedMacros;
+    // Dependency filename (default is the output filename with ".d" extension).
+    std::string                     depFilename;
+
+    // Entry points of the next shader file; an entry point without a target yet has the undefined target (e.g. "VS" in "-E VS -T vert").
+    std::vector<ShellEntryPoint>    entryPoints;
+
+    // True, if the active shader target applies to the following entry points (e.g. "vert" in "-T vert -E VS1 -E VS2").
+    bool                            targetSpecified     = false;
 
     // Include search paths for the preprocessor.
     std::vector<std::string>        searchPaths;
@@ -66,6 +71,12 @@ struct ShellState
     // Show extended code reflection (including all unreferenced objects).
     bool                            showReflectionExt   = false;
 
+    // Write a make-style dependency file after compilation.
+    bool                            writeDepFile        = false;
+
+    // Compile each shader with a single entry point again through a saved and re-loaded pre-processor snapshot and program snapshot, and compare the outputs.
+    bool                            checkSnapshots      = false;
+
     // True, if any meaningful action has been performed (e.g. printed version or compiled any files).
     bool                            actionPerformed     = false;
 
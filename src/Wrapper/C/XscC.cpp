@@ -49,6 +49,8 @@ struct CompilerContext
     Xsc::Reflection::ReflectionData     reflection;
 
     std::vector<const char*>            macros;
+    std::vector<const char*>            usedMacros;
+    std::vector<const char*>            dependencies;
     std::vector<XscAttribute>           inputAttributes;
     std::vector<XscAttribute>           outputAttributes;
     std::vector<XscAttribute>           uniforms;
@@ -95,6 +97,9 @@ static void InitializeOptions(struct XscOptions* s)
     s->unrollArrayInitializers  = 0;
     s->validateOnly             = 0;
     s->writeGeneratorHeader     = 1;
+    s->passTokenStream          = 0;
+    s->scanDependenciesOnly     = 0;
+    s->analyzeReachableOnly     = 0;
 }
 
 static void InitializeNameMangling(struct XscNameMangling* s)
@@ -126,6 +131,10 @@ static void InitializeShaderInput(struct XscShaderInput* s)
     s->extensions           = 0;
 
     InitializeIncludeHandler(&(s->includeHandler));
+
+    s->sourceCodeSize       = 0;
+    s->defines              = NULL;
+    s->definesCount         = 0;
 }
 
 static void InitializeShaderOutput(struct XscShaderOutput* s)
@@ -151,7 +160,7 @@ XSC_EXPORT void XscInitialize(struct XscShaderInput* inputDesc, struct XscShader
 
 static int ValidateShaderInput(const struct XscShaderInput* s)
 {
-    return (s != NULL && s->sourceCode != NULL && s->entryPoint != NULL);
+    return (s != NULL && s->sourceCode != NULL && s->entryPoint != NULL && (s->definesCount == 0 || s->defines != NULL));
 }
 
 static bool ValidateShaderOutput(const struct XscShaderOutput* s)
@@ -165,6 +174,12 @@ static void CopyReflection(const Xsc::Reflection::ReflectionData& src, struct Xs
     for (const auto& s : src.macros)
         g_compilerContext.macros.push_back(s.c_str());
 
+    for (const auto& s : src.usedMacros)
+        g_compilerContext.usedMacros.push_back(s.c_str());
+
+    for (const auto& s : src.dependencies)
+        g_compilerContext.dependencies.push_back(s.c_str());
+
     for (const auto& s : src.inputAttributes)
         g_compilerContext.inputAttributes.push_back({ s.name.c_str(), s.slot });
 
@@ -232,6 +247,12 @@ static void CopyReflection(const Xsc::Reflection::ReflectionData& src, struct Xs
     dst->macros                     = g_compilerContext.macros.data();
     dst->macrosCount                = g_compilerContext.macros.size();
 
+    dst->usedMacros                 = g_compilerContext.usedMacros.data();
+    dst->usedMacrosCount            = g_compilerContext.usedMacros.size();
+
+    dst->dependencies               = g_compilerContext.dependencies.data();
+    dst->dependenciesCount          = g_compilerContext.dependencies.size();
+
     dst->inputAttributes            = g_compilerContext.inputAttributes.data();
     dst->inputAttributesCount       = g_compilerContext.inputAttributes.size();
 
@@ -370,11 +391,9 @@ XSC_EXPORT int XscCompileShader(
 
     IncludeHandlerC includeHandler(inputDesc->includeHandler);
 
-    auto inputStream = std::make_shared<std::stringstream>();
-    *inputStream << inputDesc->sourceCode;
-
     in.filename             = ReadStringC(inputDesc->filename);
-    in.sourceCode           = inputStream;
+    in.sourceCodeBuffer     = inputDesc->sourceCode;
+    in.sourceCodeBufferSize = (inputDesc->sourceCodeSize > 0 ? inputDesc->sourceCodeSize : strlen(inputDesc->sourceCode));
     in.shaderVersion        = static_cast<Xsc::InputShaderVersion>(inputDesc->shaderVersion);
     in.shaderTarget         = static_cast<Xsc::ShaderTarget>(inputDesc->shaderTarget);
     in.entryPoint           = ReadStringC(inputDesc->entryPoint);
@@ -383,6 +402,13 @@ XSC_EXPORT int XscCompileShader(
     in.includeHandler       = (&includeHandler);
     in.extensions           = inputDesc->extensions;
 
+    in.defines.resize(inputDesc->definesCount);
+    for (size_t i = 0; i < inputDesc->definesCount; ++i)
+    {
+        in.defines[i].ident = ReadStringC(inputDesc->defines[i].ident);
+        in.defines[i].value = ReadStringC(inputDesc->defines[i].value);
+    }
+
     /* Copy output descriptor */
     Xsc::ShaderOutput out;
 
@@ -401,15 +427,18 @@ XSC_EXPORT int XscCompileShader(
 
     /* Copy output options descriptor */
     out.options.allowExtensions         = (outputDesc->options.allowExtensions != 0);
+    out.options.analyzeReachableOnly    = (outputDesc->options.analyzeReachableOnly != 0);
     out.options.autoBinding             = (outputDesc->options.autoBinding != 0);
     out.options.autoBindingStartSlot    = outputDesc->options.autoBindingStartSlot;
     out.options.explicitBinding         = (outputDesc->options.explicitBinding != 0);
     out.options.obfuscate               = (outputDesc->options.obfuscate != 0);
     out.options.optimize                = (outputDesc->options.optimize != 0);
+    out.options.passTokenStream         = (outputDesc->options.passTokenStream != 0);
     out.options.preferWrappers          = (outputDesc->options.preferWrappers != 0);
     out.options.preprocessOnly          = (outputDesc->options.preprocessOnly != 0);
     out.options.preserveComments        = (outputDesc->options.preserveComments != 0);
     out.options.rowMajorAlignment       = (outputDesc->options.rowMajorAlignment != 0);
+    out.options.scanDependenciesOnly    = (outputDesc->options.scanDependenciesOnly != 0);
     out.options.separateShaders         = (outputDesc->options.separateShaders != 0);
     out.options.separateSamplers        = (outputDesc->options.separateSamplers != 0);
     out.options.showAST                 = (outputDesc->options.showAST != 0);
@@ -458,6 +458,12 @@ public ref class XscCompiler
                 /// <summary>All defined macros after pre-processing.</summary>
                 property Collections::Generic::List<String^>^               Macros;
 
+                /// <summary>All macros that were queried or expanded during pre-processing, whether they were defined or not.</summary>
+                property Collections::Generic::List<String^>^               UsedMacros;
+
+                /// <summary>Paths of all included files in the order they were included first.</summary>
+                property Collections::Generic::List<String^>^               Dependencies;
+
                 /// <summary>Shader input attributes.</summary>
                 property Collections::Generic::List<Attribute^>^            InputAttributes;
 
@@ -533,15 +539,18 @@ public ref class XscCompiler
                 OutputOptions()
                 {
                     AllowExtensions         = false;
+                    AnalyzeReachableOnly    = false;
                     AutoBinding             = false;
                     AutoBindingStartSlot    = 0;
                     ExplicitBinding         = false;
                     Obfuscate               = false;
                     Optimize                = false;
+                    PassTokenStream         = false;
                     PreferWrappers          = false;
                     PreprocessOnly          = false;
                     PreserveComments        = false;
                     RowMajorAlignment       = false;
+                    ScanDependenciesOnly    = false;
                     SeparateSamplers        = true;
                     SeparateShaders         = false;
                     ShowAST                 = false;
@@ -554,6 +563,10 @@ public ref class XscCompiler
                 /// <summary>If true, the shader output may contain GLSL extensions, if the target shader version is too low. By default false.</summary>
                 property bool   AllowExtensions;
 
+                /// <summary>If true, only the global functions that are reachable from the entry points are analyzed. By default false.</summary>
+                /// <remarks>Errors inside of unreachable functions are not reported.</remarks>
+                property bool   AnalyzeReachableOnly;
+
                 /// <summary>If true, binding slots for all buffer types will be generated sequentially, starting with index at 'AutoBindingStartSlot'. By default false.</summary>
                 /// <remarks> This will also enable 'ExplicitBinding'.</remarks>
                 property bool   AutoBinding;
@@ -570,6 +583,10 @@ public ref class XscCompiler
                 /// <summary>If true, little code optimizations are performed. By default false.</summary>
                 property bool   Optimize;
 
+                /// <summary>If true, the pre-processor passes its token stream directly to the parser, instead of writing out the pre-processed source code. By default false.</summary>
+                /// <remarks>This avoids that the pre-processed source code is scanned a second time. It has no effect if 'PreprocessOnly' is enabled.</remarks>
+                property bool   PassTokenStream;
+
                 /// <summary>If true, intrinsics are prefered to be implemented as wrappers (instead of inlining). By default false.</summary>
                 property bool   PreferWrappers;
 
@@ -582,6 +599,10 @@ public ref class XscCompiler
                 /// <summary>If true, matrices have row-major alignment. Otherwise the matrices have column-major alignment. By default false.</summary>
                 property bool   RowMajorAlignment;
 
+                /// <summary>If true, only the dependencies of the shader (i.e. all included files) are determined, but no output will be generated. By default false.</summary>
+                /// <remarks>The dependencies are stored in 'ReflectionData.Dependencies'.</remarks>
+                property bool   ScanDependenciesOnly;
+
                 /// <summary>If true, generated GLSL code will contain separate sampler and texture objects when supported. By default true.</summary>
                 property bool   SeparateSamplers;
 
@@ -668,6 +689,26 @@ public ref class XscCompiler
 
         };
 
+        /// <summary>Pre-defined macro structure for the pre-processor (like the "-D" compiler argument).</summary>
+        ref class PredefinedMacro
+        {
+
+            public:
+
+                PredefinedMacro()
+                {
+                    Ident = nullptr;
+                    Value = nullptr;
+                }
+
+                /// <summary>Specifies the macro identifier with an optional parameter list, e.g. "FOO" or "MAX(a, b)".</summary>
+                property String^    Ident;
+
+                /// <summary>Specifies the macro value (or rather body). This can be null.</summary>
+                property String^    Value;
+
+        };
+
         /// <summary>Shader input descriptor structure.</summary>
         ref class ShaderInput
         {
@@ -685,6 +726,7 @@ public ref class XscCompiler
                     WarningFlags        = Warnings::Disabled;
                     IncludeHandler      = nullptr;
                     ExtensionFlags      = Extensions::Disabled;
+                    Defines             = gcnew Collections::Generic::List<PredefinedMacro^>();
                 }
 
                 /// <summary>Specifies the filename of the input shader code. This is an optional attribute, and only a hint to the compiler.</summary>
@@ -720,6 +762,9 @@ public ref class XscCompiler
                 /// <see cref="Extensions"/>
                 property Extensions                     ExtensionFlags;
 
+                /// <summary>Optional list of macros that are defined before the source code is pre-processed.</summary>
+                property Collections::Generic::List<PredefinedMacro^>^ Defines;
+
                 /// <summary>Optional handler to handle '#include'-directives. By default null.</summary>
                 /// <remarks>If this is null, the default include handler will be used, which will include files with the STL input file streams.</remarks>
                 property SourceIncludeHandler^          IncludeHandler;
@@ -1249,11 +1294,11 @@ bool XscCompiler::CompileShader(ShaderInput^ inputDesc, ShaderOutput^ outputDesc
 
     IncludeHandlerCSharp includeHandler(inputDesc->IncludeHandler);
 
-    auto inputStream = std::make_shared<std::stringstream>();
-    *inputStream << ToStdString(inputDesc->SourceCode);
+    auto inputSourceCode = ToStdString(inputDesc->SourceCode);
 
     in.filename             = ToStdString(inputDesc->Filename);
-    in.sourceCode           = inputStream;
+    in.sourceCodeBuffer     = inputSourceCode.data();
+    in.sourceCodeBufferSize = inputSourceCode.size();
     in.shaderVersion        = static_cast<Xsc::InputShaderVersion>(inputDesc->ShaderVersion);
     in.shaderTarget         = static_cast<Xsc::ShaderTarget>(inputDesc->Target);
     in.entryPoint           = ToStdString(inputDesc->EntryPoint);
@@ -1262,6 +1307,16 @@ bool XscCompiler::CompileShader(ShaderInput^ inputDesc, ShaderOutput^ outputDesc
     in.includeHandler       = (&includeHandler);
     in.extensions           = static_cast<unsigned int>(inputDesc->ExtensionFlags);
 
+    if (inputDesc->Defines != nullptr)
+    {
+        in.defines.resize(inputDesc->Defines->Count);
+        for (int i = 0; i < inputDesc->Defines->Count; ++i)
+        {
+            in.defines[i].ident = ToStdString(inputDesc->Defines[i]->Ident);
+            in.defines[i].value = ToStdString(inputDesc->Defines[i]->Value);
+        }
+    }
+
     /* Copy output descriptor */
     Xsc::ShaderOutput out;
 
@@ -1283,15 +1338,18 @@ bool XscCompiler::CompileShader(ShaderInput^ inputDesc, ShaderOutput^ outputDesc
 
     /* Copy output options descriptor */
     out.options.allowExtensions         = outputDesc->Options->AllowExtensions;
+    out.options.analyzeReachableOnly    = outputDesc->Options->AnalyzeReachableOnly;
     out.options.autoBinding             = outputDesc->Options->AutoBinding;
     out.options.autoBindingStartSlot    = outputDesc->Options->AutoBindingStartSlot;
     out.options.explicitBinding         = outputDesc->Options->ExplicitBinding;
     out.options.obfuscate               = outputDesc->Options->Obfuscate;
     out.options.optimize                = outputDesc->Options->Optimize;
+    out.options.passTokenStream         = outputDesc->Options->PassTokenStream;
     out.options.preferWrappers          = outputDesc->Options->PreferWrappers;
     out.options.preprocessOnly          = outputDesc->Options->PreprocessOnly;
     out.options.preserveComments        = outputDesc->Options->PreserveComments;
     out.options.rowMajorAlignment       = outputDesc->Options->RowMajorAlignment;
+    out.options.scanDependenciesOnly    = outputDesc->Options->ScanDependenciesOnly;
     out.options.separateSamplers        = outputDesc->Options->SeparateSamplers;
     out.options.separateShaders         = outputDesc->Options->SeparateShaders;
     out.options.showAST                 = outputDesc->Options->ShowAST;
@@ -1352,6 +1410,8 @@ bool XscCompiler::CompileShader(ShaderInput^ inputDesc, ShaderOutput^ outputDesc
 
             /* Copy lists in reflection */
             dst->Macros                 = ToManagedList(src.macros);
+            dst->UsedMacros             = ToManagedList(src.usedMacros);
+            dst->Dependencies           = ToManagedList(src.dependencies);
             dst->InputAttributes        = ToManagedList(src.inputAttributes);
             dst->OutputAttributes       = ToManagedList(src.outputAttributes);
             dst->Uniforms               = ToManagedList(src.uniforms);
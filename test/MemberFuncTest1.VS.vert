@@ -0,0 +1,41 @@
+// GLSL Vertex Shader "VS"
+// Generated by XShaderCompiler
+// 17/10/2026 08:44:57
+
+#version 130
+
+struct A
+{
+    float a;
+};
+
+void xsn_A_no_op(A xsn_self)
+{
+    
+}
+
+struct S
+{
+    A   xsn_base;
+    int b;
+};
+
+float xsn_S_f3(S xsn_self, float x)
+{
+    return 2.0f + x;
+}
+
+float xsn_S_f2(S xsn_self, float pos)
+{
+    A tmp;
+    xsn_A_no_op(tmp);
+    return 2.0f + xsn_self.xsn_base.a + xsn_S_f3(xsn_self, xsn_self.xsn_base.a) + pos;
+}
+
+void main()
+{
+    A a;
+    S s = S(A(0), 0);
+    gl_Position = vec4(xsn_S_f2(s, 1.0f));
+}
+
@@ -0,0 +1,90 @@
+// HLSL Translator: Pre-processor macro expansion stress test
+// 17/10/2026
+
+// Packing and unpacking helpers, which are nested deeply into each other
+
+#define PACK2(A, B)         ((A) | ((B) << 16))
+#define UNPACK_LO(X)        ((X) & 0xFFFF)
+#define UNPACK_HI(X)        ((X) >> 16)
+#define ROUNDTRIP(X)        PACK2(UNPACK_LO(X), UNPACK_HI(X))
+
+#define SWIZZLE(V, ...)     V.__VA_ARGS__
+#define SELECT(C, A, B)     ((C) ? (A) : (B))
+#define MIN3(A, B, C)       min(A, min(B, C))
+#define MAX3(A, B, C)       max(A, max(B, C))
+#define CLAMP3(X, A, B, C)  MIN3(MAX3(X, A, B), B, C)
+
+uint Stress(uint v)
+{
+    uint r = 0;
+    r += ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(v + 0u))))))));
+    r += SELECT(r > 0u, CLAMP3(r, 0u, UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(v)))))), UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(v))))))), ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(r)))));
+    r += ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(v + 1u))))))));
+    r += SELECT(r > 1u, CLAMP3(r, 1u, UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(v)))))), UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(v))))))), ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(r)))));
+    r += ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(v + 2u))))))));
+    r += SELECT(r > 2u, CLAMP3(r, 2u, UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(v)))))), UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(v))))))), ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(r)))));
+    r += ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(v + 3u))))))));
+    r += SELECT(r > 3u, CLAMP3(r, 3u, UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(v)))))), UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(v))))))), ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(r)))));
+    r += ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(v + 4u))))))));
+    r += SELECT(r > 4u, CLAMP3(r, 4u, UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(v)))))), UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(v))))))), ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(r)))));
+    r += ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(v + 5u))))))));
+    r += SELECT(r > 5u, CLAMP3(r, 5u, UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(v)))))), UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(v))))))), ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(r)))));
+    r += ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(v + 6u))))))));
+    r += SELECT(r > 6u, CLAMP3(r, 6u, UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(v)))))), UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(v))))))), ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(r)))));
+    r += ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(v + 7u))))))));
+    r += SELECT(r > 7u, CLAMP3(r, 7u, UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(v)))))), UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(v))))))), ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(r)))));
+    r += ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(v + 8u))))))));
+    r += SELECT(r > 8u, CLAMP3(r, 8u, UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(v)))))), UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(v))))))), ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(r)))));
+    r += ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(v + 9u))))))));
+    r += SELECT(r > 9u, CLAMP3(r, 9u, UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(v)))))), UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(v))))))), ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(r)))));
+    r += ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(v + 10u))))))));
+    r += SELECT(r > 10u, CLAMP3(r, 10u, UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(v)))))), UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(v))))))), ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(r)))));
+    r += ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(v + 11u))))))));
+    r += SELECT(r > 11u, CLAMP3(r, 11u, UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(v)))))), UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(v))))))), ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(r)))));
+    r += ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(v + 12u))))))));
+    r += SELECT(r > 12u, CLAMP3(r, 12u, UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(v)))))), UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(v))))))), ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(r)))));
+    r += ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(v + 13u))))))));
+    r += SELECT(r > 13u, CLAMP3(r, 13u, UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(v)))))), UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(v))))))), ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(r)))));
+    r += ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(v + 14u))))))));
+    r += SELECT(r > 14u, CLAMP3(r, 14u, UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(v)))))), UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(v))))))), ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(r)))));
+    r += ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(v + 15u))))))));
+    r += SELECT(r > 15u, CLAMP3(r, 15u, UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(v)))))), UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(v))))))), ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(r)))));
+    r += ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(v + 16u))))))));
+    r += SELECT(r > 16u, CLAMP3(r, 16u, UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(v)))))), UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(v))))))), ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(r)))));
+    r += ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(v + 17u))))))));
+    r += SELECT(r > 17u, CLAMP3(r, 17u, UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(v)))))), UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(v))))))), ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(r)))));
+    r += ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(v + 18u))))))));
+    r += SELECT(r > 18u, CLAMP3(r, 18u, UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(v)))))), UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(v))))))), ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(r)))));
+    r += ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(v + 19u))))))));
+    r += SELECT(r > 19u, CLAMP3(r, 19u, UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(v)))))), UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(v))))))), ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(r)))));
+    r += ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(v + 20u))))))));
+    r += SELECT(r > 20u, CLAMP3(r, 20u, UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(v)))))), UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(v))))))), ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(r)))));
+    r += ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(v + 21u))))))));
+    r += SELECT(r > 21u, CLAMP3(r, 21u, UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(v)))))), UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(v))))))), ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(r)))));
+    r += ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(v + 22u))))))));
+    r += SELECT(r > 22u, CLAMP3(r, 22u, UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(v)))))), UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(v))))))), ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(r)))));
+    r += ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(v + 23u))))))));
+    r += SELECT(r > 23u, CLAMP3(r, 23u, UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(v)))))), UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(v))))))), ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(r)))));
+    r += ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(v + 24u))))))));
+    r += SELECT(r > 24u, CLAMP3(r, 24u, UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(v)))))), UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(v))))))), ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(r)))));
+    r += ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(v + 25u))))))));
+    r += SELECT(r > 25u, CLAMP3(r, 25u, UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(v)))))), UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(v))))))), ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(r)))));
+    r += ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(v + 26u))))))));
+    r += SELECT(r > 26u, CLAMP3(r, 26u, UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(v)))))), UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(v))))))), ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(r)))));
+    r += ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(v + 27u))))))));
+    r += SELECT(r > 27u, CLAMP3(r, 27u, UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(v)))))), UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(v))))))), ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(r)))));
+    r += ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(v + 28u))))))));
+    r += SELECT(r > 28u, CLAMP3(r, 28u, UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(v)))))), UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(v))))))), ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(r)))));
+    r += ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(v + 29u))))))));
+    r += SELECT(r > 29u, CLAMP3(r, 29u, UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(v)))))), UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(v))))))), ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(r)))));
+    r += ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(v + 30u))))))));
+    r += SELECT(r > 30u, CLAMP3(r, 30u, UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(v)))))), UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(v))))))), ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(r)))));
+    r += ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(v + 31u))))))));
+    r += SELECT(r > 31u, CLAMP3(r, 31u, UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(UNPACK_LO(v)))))), UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(UNPACK_HI(v))))))), ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(ROUNDTRIP(r)))));
+    return r;
+}
+
+float4 main(uint4 v : V) : SV_Target
+{
+    return (float4)SWIZZLE(v, xyzw) * Stress(v.x);
+}
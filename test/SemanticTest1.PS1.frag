@@ -0,0 +1,15 @@
+// GLSL Fragment Shader "PS1"
+// Generated by XShaderCompiler
+// 17/10/2026 08:43:59
+
+#version 130
+
+in vec3 xsv_NORMAL0;
+
+out vec4 SV_Target2;
+
+void main()
+{
+    SV_Target2 = vec4(clamp(dot(vec3(0, 0, 1), xsv_NORMAL0), float(0), float(1)));
+}
+
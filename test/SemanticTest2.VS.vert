@@ -0,0 +1,27 @@
+// GLSL Vertex Shader "VS"
+// Generated by XShaderCompiler
+// 17/10/2026 08:43:59
+
+#version 140
+
+in vec3 pos;
+in vec2 tc;
+in vec3 normal;
+
+out vec3 xsv_NORMAL0;
+out vec2 xsv_TEXCOORD0;
+
+uniform mat4 wvpMatrix;
+
+layout(std140, row_major) uniform Matrices
+{
+    mat4 wMatrix;
+};
+
+void main()
+{
+    gl_Position = (vec4(pos, 0) * wvpMatrix);
+    xsv_NORMAL0 = (vec4(normal, 0) * wMatrix).xyz;
+    xsv_TEXCOORD0 = tc;
+}
+
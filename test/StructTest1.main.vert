@@ -0,0 +1,74 @@
+// GLSL Vertex Shader "main"
+// Generated by XShaderCompiler
+// 17/10/2026 08:44:52
+
+#version 130
+
+struct xst_anonym0
+{
+    float a;
+};
+
+struct xst_anonym2
+{
+    float foo, bar;
+};
+
+struct xst_anonym1
+{
+    xst_anonym2 s1_3_1;
+};
+
+struct S1
+{
+    xst_anonym0 s1_1;
+    xst_anonym0 s1_2;
+    xst_anonym1 s1_3;
+};
+
+struct S2
+{
+    float x, y;
+};
+
+S2 f1()
+{
+    return S2(0, 0);
+}
+
+struct xst_anonym3
+{
+    float value;
+};
+
+xst_anonym3 f2()
+{
+    xst_anonym3 result = xst_anonym3(0);
+    result.value = 1.0f;
+    return result;
+}
+
+xst_anonym3 f3()
+{
+    return xst_anonym3(0);
+}
+
+void main()
+{
+    S1 s1;
+    float b = s1.s1_2.a;
+    struct UnusedStruct
+    {
+        int xst_dummy;
+    };
+    
+    S2 s2;
+    struct xst_anonym4
+    {
+        float hello, world[2];
+    }
+    s3;
+    s3.world[0] = 2.0f;
+    gl_Position = vec4((f1().x + f2().value + f3().value));
+}
+